@@ -0,0 +1,216 @@
+// Skinned animation throughput benchmark
+//
+// Usage: bench_animation [characters] [max threads]
+//
+// Animates a crowd of characters sharing one synthetic 64-joint skeleton,
+// clip and 2000-vertex skin with 1 to N threads and prints the characters
+// evaluated per millisecond, in total and per core, for:
+//
+//   palette   clip sampling, hierarchy and skinning palette
+//   skinned   the same plus CPU linear blend skinning of every vertex
+#include<algorithm>
+#include<chrono>
+#include<cmath>
+#include<cstdio>
+#include<cstdlib>
+#include<thread>
+#include<vector>
+
+#include"animation.h"
+#include"job_system.h"
+
+static const size_t kJointCount=64;
+static const size_t kKeyCount=61;
+static const float kSampleRate=30.f;
+static const size_t kVertexCount=2000;
+static const size_t kDefaultCharacters=2000;
+static const int kFrames=10;
+static const int kRepeats=3;
+
+static double now() {
+    using namespace std::chrono;
+    return duration<double,std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+static float randomFloat(float low, float high) {
+    return low+(high-low)*(float)std::rand()/(float)RAND_MAX;
+}
+
+static Affine translation(float x, float y, float z) {
+    Affine m={{{1.f,0.f,0.f,x},{0.f,1.f,0.f,y},{0.f,0.f,1.f,z}}};
+    return m;
+}
+
+// Random tree listed in shuffled order, so sortSkeleton has work to do.
+// Every bone is offset 0.1 along y from its parent in the bind pose.
+static void buildSkeleton(Skeleton& skeleton, std::vector<float>& bindHeight) {
+    std::vector<int> parents(kJointCount);
+    for(size_t i=0;i<kJointCount;i++)
+        parents[i]=i?std::rand()%(int)i:-1;
+
+    std::vector<int> order(kJointCount),position(kJointCount);
+    for(size_t i=0;i<kJointCount;i++)
+        order[i]=(int)i;
+    for(size_t i=kJointCount-1;i>0;i--)
+        std::swap(order[i],order[std::rand()%(i+1)]);
+    for(size_t i=0;i<kJointCount;i++)
+        position[order[i]]=(int)i;
+
+    std::vector<float> height(kJointCount);
+    for(size_t i=0;i<kJointCount;i++)
+        height[i]=i?height[parents[i]]+0.1f:0.f;
+
+    skeleton.parents.resize(kJointCount);
+    skeleton.inverseBind.resize(kJointCount);
+    for(size_t i=0;i<kJointCount;i++) {
+        skeleton.parents[position[i]]=parents[i]<0?-1:position[parents[i]];
+        skeleton.inverseBind[position[i]]=translation(0.f,-height[i],0.f);
+    }
+
+    std::vector<int> remap;
+    if(!sortSkeleton(skeleton,remap)) {
+        std::printf("sortSkeleton rejected a valid hierarchy\n");
+        std::exit(EXIT_FAILURE);
+    }
+    bindHeight.resize(kJointCount);
+    for(size_t i=0;i<kJointCount;i++)
+        bindHeight[i]=-skeleton.inverseBind[i].rows[1][3];
+}
+
+// Local bind translation of joint i; random rotations when animated
+static void buildClip(const Skeleton& skeleton, const std::vector<float>& bindHeight,
+                      bool animated, AnimationClip& clip) {
+    initClip(clip,kJointCount,kKeyCount,kSampleRate);
+    const float scale[3]={1.f,1.f,1.f};
+    for(size_t j=0;j<kJointCount;j++) {
+        const int parent=skeleton.parents[j];
+        const float offset[3]={0.f,parent<0?0.f:bindHeight[j]-bindHeight[parent],0.f};
+        for(size_t k=0;k<kKeyCount;k++) {
+            float rotation[4]={0.f,0.f,0.f,1.f};
+            if(animated&&k+1<kKeyCount) {
+                rotation[0]=randomFloat(-0.3f,0.3f);
+                rotation[1]=randomFloat(-0.3f,0.3f);
+                rotation[2]=randomFloat(-0.3f,0.3f);
+                const float length=std::sqrt(1.f+rotation[0]*rotation[0]+rotation[1]*rotation[1]+rotation[2]*rotation[2]);
+                for(int i=0;i<4;i++)
+                    rotation[i]=(i==3?1.f:rotation[i])/length;
+            }
+            else if(animated) {
+                // Loop back to the first key
+                for(int i=0;i<4;i++)
+                    rotation[i]=clip.keys[(POSE_QX+i)*clip.stride+j];
+            }
+            setClipKey(clip,k,j,offset,rotation,scale);
+        }
+    }
+}
+
+static void buildSkin(SkinnedMesh& skin) {
+    skin.mesh.vertices.resize(kVertexCount);
+    skin.weights.resize(kVertexCount);
+    for(size_t v=0;v<kVertexCount;v++) {
+        Vertex& vertex=skin.mesh.vertices[v];
+        for(int i=0;i<3;i++)
+            vertex.position[i]=randomFloat(-1.f,1.f);
+        vertex.normal[0]=0.f;
+        vertex.normal[1]=1.f;
+        vertex.normal[2]=0.f;
+        vertex.texcoord[0]=vertex.texcoord[1]=0.f;
+
+        float total=0.f;
+        SkinWeights& weights=skin.weights[v];
+        for(int i=0;i<4;i++) {
+            weights.joints[i]=(uint16_t)(std::rand()%kJointCount);
+            weights.weights[i]=randomFloat(0.f,1.f);
+            total+=weights.weights[i];
+        }
+        for(int i=0;i<4;i++)
+            weights.weights[i]/=total;
+    }
+}
+
+// Sampling the bind pose must reproduce identity skinning matrices
+static void checkBindPose(const Skeleton& skeleton, const AnimationClip& bind) {
+    LocalPose pose;
+    std::vector<Affine> model,palette;
+    sampleClip(bind,0.37f,pose);
+    localToModel(skeleton,pose,model);
+    buildSkinPalette(skeleton,model,palette);
+
+    float error=0.f;
+    for(size_t j=0;j<palette.size();j++) {
+        for(int r=0;r<3;r++) {
+            for(int c=0;c<4;c++)
+                error=std::max(error,std::fabs(palette[j].rows[r][c]-(r==c?1.f:0.f)));
+        }
+    }
+    if(error>1e-4f) {
+        std::printf("bind pose palette is not identity: error %g\n",error);
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+static double benchUpdate(JobSystem& jobs, std::vector<AnimationInstance>& instances, bool skinning) {
+    double start=now();
+    for(int frame=0;frame<kFrames;frame++)
+        updateAnimations(jobs,&instances[0],instances.size(),1.f/60.f,skinning,skinning?1:8);
+    return now()-start;
+}
+
+int main(int argc, char** argv) {
+    size_t characters=kDefaultCharacters;
+    int maxThreads=(int)std::thread::hardware_concurrency();
+    if(argc>1)
+        characters=(size_t)std::atoi(argv[1]);
+    if(argc>2)
+        maxThreads=std::atoi(argv[2]);
+    if(characters<1)
+        characters=1;
+    if(maxThreads<1)
+        maxThreads=1;
+
+    std::srand(1);
+    Skeleton skeleton;
+    std::vector<float> bindHeight;
+    buildSkeleton(skeleton,bindHeight);
+    AnimationClip bind,walk;
+    buildClip(skeleton,bindHeight,false,bind);
+    buildClip(skeleton,bindHeight,true,walk);
+    checkBindPose(skeleton,bind);
+    SkinnedMesh skin;
+    buildSkin(skin);
+
+    std::vector<AnimationInstance> instances(characters);
+    for(size_t i=0;i<characters;i++) {
+        instances[i].skeleton=&skeleton;
+        instances[i].clip=&walk;
+        instances[i].skin=&skin;
+        instances[i].time=randomFloat(0.f,walk.duration());
+        instances[i].speed=randomFloat(0.8f,1.2f);
+    }
+
+    std::printf("%lu characters, %lu joints, %lu vertices, %i frames\n",
+                (unsigned long)characters,(unsigned long)kJointCount,(unsigned long)kVertexCount,kFrames);
+    std::printf("%8s %24s %24s\n","threads","palette chars/ms (/core)","skinned chars/ms (/core)");
+
+    for(int threads=1;threads<=maxThreads;threads++) {
+        JobSystem jobs(threads-1);
+
+        double best[2];
+        for(int mode=0;mode<2;mode++) {
+            best[mode]=benchUpdate(jobs,instances,mode==1);
+            for(int i=1;i<kRepeats;i++) {
+                double elapsed=benchUpdate(jobs,instances,mode==1);
+                if(elapsed<best[mode])
+                    best[mode]=elapsed;
+            }
+        }
+
+        const double evaluated=(double)characters*kFrames;
+        std::printf("%8i %14.1f (%7.1f) %14.2f (%7.2f)\n",threads,
+                    evaluated/best[0],evaluated/best[0]/threads,
+                    evaluated/best[1],evaluated/best[1]/threads);
+    }
+
+    return EXIT_SUCCESS;
+}
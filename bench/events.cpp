@@ -0,0 +1,172 @@
+// Event delivery benchmark: per-event callbacks versus the event queue
+//
+// Usage: bench_events [windows] [events per frame]
+//
+// Feeds a synthetic stream of cursor motion, mouse button and key events to
+// null platform windows through GLFW's internal input functions, the same
+// entry points the platform backends call, and measures the cost per event of
+// delivering them through callbacks, through callbacks with cursor motion
+// coalescing and through glfwGetEvents.  Also reports how many callbacks or
+// queued events each frame delivers.  This relies on GLFW being linked
+// statically, as hw1 builds it.
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<vector>
+
+#define GLFW_INCLUDE_NONE
+#include<GLFW/glfw3.h>
+
+// Internal GLFW functions normally called by the platform code
+extern "C" {
+struct _GLFWwindow;
+void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int mods);
+void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods);
+void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos);
+}
+
+static const int kTotalEvents=1<<21;
+static const int kDrainCapacity=256;
+
+static double now() {
+    using namespace std::chrono;
+    return duration<double,std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+enum Delivery {
+    DELIVERY_CALLBACKS,
+    DELIVERY_COALESCED,
+    DELIVERY_QUEUE,
+    DELIVERY_COUNT
+};
+
+static const char* const kDeliveryNames[DELIVERY_COUNT]={"callbacks","coalesced","queue"};
+
+// Consumed by every delivery path so none can be optimized away
+static double sink;
+// Callbacks called and queued events retrieved
+static long delivered;
+
+static void keyCallback(GLFWwindow*, int key, int, int action, int) {
+    sink+=key+action;
+    delivered++;
+}
+
+static void mouseButtonCallback(GLFWwindow*, int button, int action, int) {
+    sink+=button+action;
+    delivered++;
+}
+
+static void cursorPosCallback(GLFWwindow*, double x, double y) {
+    sink+=x+y;
+    delivered++;
+}
+
+// Mostly cursor motion, like a high-rate mouse, spread across the windows
+static void injectFrame(const std::vector<GLFWwindow*>& windows, int frame, int eventsPerFrame) {
+    for(int i=0;i<eventsPerFrame;i++) {
+        _GLFWwindow* window=reinterpret_cast<_GLFWwindow*>(windows[i%windows.size()]);
+        const int kind=i%16;
+        if(kind==14)
+            _glfwInputKey(window,GLFW_KEY_A+(i/16)%26,0,(i/16)%2?GLFW_RELEASE:GLFW_PRESS,0);
+        else if(kind==15)
+            _glfwInputMouseClick(window,GLFW_MOUSE_BUTTON_LEFT,(i/16)%2?GLFW_RELEASE:GLFW_PRESS,0);
+        else
+            _glfwInputCursorPos(window,(double)frame,(double)i);
+    }
+}
+
+static void drainQueue() {
+    GLFWevent events[kDrainCapacity];
+    int count;
+    do {
+        count=glfwGetEvents(events,kDrainCapacity);
+        delivered+=count;
+        for(int i=0;i<count;i++) {
+            const GLFWevent& event=events[i];
+            switch(event.type) {
+                case GLFW_EVENT_KEY:
+                    sink+=event.data.key.key+event.data.key.action;
+                    break;
+                case GLFW_EVENT_MOUSE_BUTTON:
+                    sink+=event.data.mouseButton.button+event.data.mouseButton.action;
+                    break;
+                case GLFW_EVENT_CURSOR_POS:
+                    sink+=event.data.cursorPos.xpos+event.data.cursorPos.ypos;
+                    break;
+            }
+        }
+    } while(count==kDrainCapacity);
+}
+
+// Merged cursor motion is reported when glfwPollEvents returns, as it would be
+// after the platform has processed its events
+static double run(const std::vector<GLFWwindow*>& windows, int eventsPerFrame, Delivery delivery) {
+    const bool queued=delivery==DELIVERY_QUEUE;
+    for(size_t i=0;i<windows.size();i++) {
+        glfwSetInputMode(windows[i],GLFW_EVENT_QUEUE,queued?GLFW_TRUE:GLFW_FALSE);
+        glfwSetInputMode(windows[i],GLFW_CURSOR_COALESCE,delivery==DELIVERY_COALESCED?GLFW_TRUE:GLFW_FALSE);
+    }
+
+    delivered=0;
+    double start=now();
+    for(int frame=0;frame<kTotalEvents/eventsPerFrame;frame++) {
+        injectFrame(windows,frame,eventsPerFrame);
+        glfwPollEvents();
+        if(queued)
+            drainQueue();
+    }
+    return now()-start;
+}
+
+int main(int argc, char** argv) {
+    int windowCount=4;
+    int eventsPerFrame=256;
+    if(argc>1)
+        windowCount=std::atoi(argv[1]);
+    if(argc>2)
+        eventsPerFrame=std::atoi(argv[2]);
+    if(windowCount<1)
+        windowCount=1;
+    if(eventsPerFrame<1)
+        eventsPerFrame=1;
+
+    glfwInitHint(GLFW_PLATFORM,GLFW_PLATFORM_NULL);
+    if(!glfwInit()) {
+        std::printf("Failed to initialize GLFW\n");
+        return EXIT_FAILURE;
+    }
+
+    glfwWindowHint(GLFW_CLIENT_API,GLFW_NO_API);
+    std::vector<GLFWwindow*> windows;
+    for(int i=0;i<windowCount;i++) {
+        GLFWwindow* window=glfwCreateWindow(640,480,"bench_events",NULL,NULL);
+        if(!window) {
+            std::printf("Failed to create window\n");
+            glfwTerminate();
+            return EXIT_FAILURE;
+        }
+        glfwSetKeyCallback(window,keyCallback);
+        glfwSetMouseButtonCallback(window,mouseButtonCallback);
+        glfwSetCursorPosCallback(window,cursorPosCallback);
+        windows.push_back(window);
+    }
+
+    // Warm up every path, including growing the queue to its working size
+    for(int d=0;d<DELIVERY_COUNT;d++)
+        run(windows,eventsPerFrame,(Delivery)d);
+
+    const int frames=kTotalEvents/eventsPerFrame;
+    const double events=(double)frames*eventsPerFrame;
+    std::printf("%i windows, %i events per frame, %.0f events\n",windowCount,eventsPerFrame,events);
+    std::printf("%-10s %12s %14s %16s\n","delivery","ns/event","Mevents/s","delivered/frame");
+    for(int d=0;d<DELIVERY_COUNT;d++) {
+        const double elapsed=run(windows,eventsPerFrame,(Delivery)d);
+        std::printf("%-10s %12.1f %14.2f %16.1f\n",kDeliveryNames[d],elapsed*1e6/events,
+                    events/elapsed/1e3,(double)delivered/frames);
+    }
+    std::printf("(checksum %g)\n",sink);
+
+    glfwTerminate();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,209 @@
+// Gamepad mapping database benchmark
+//
+// Usage: bench_gamepad [mappings] [gamecontrollerdb.txt]
+//
+// Times glfwInit, which sets up the built-in mappings, on the null platform.
+// Then builds an SDL_GameControllerDB style string of distinct synthetic
+// mappings and times glfwUpdateGamepadMappings adding all of them, then
+// replacing all of them, which looks up every GUID among the mappings already
+// loaded.  The same mappings are then written to a file and loaded again with
+// glfwLoadGamepadMappingsFile.  If a mapping database file is given, the time
+// to load it into a freshly initialized library is reported as well.
+//
+// Finally it connects 16 gamepads through GLFW's internal joystick input
+// functions, the entry points the platform backends call, and times
+// glfwGetGamepadState on all of them while their inputs change.  This relies on
+// GLFW being linked statically, as hw1 builds it.
+#include<cctype>
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<fstream>
+#include<string>
+
+#define GLFW_INCLUDE_NONE
+#include<GLFW/glfw3.h>
+
+static const int kDefaultMappings=10000;
+static const int kInitRepeats=200;
+static const int kGamepads=16;
+static const int kStateFrames=100000;
+static const char* const kMappingsFile="bench_gamepad_mappings.txt";
+
+// Internal GLFW functions normally called by the platform code
+extern "C" {
+struct _GLFWjoystick;
+_GLFWjoystick* _glfwAllocJoystick(const char* name, const char* guid, int axisCount, int buttonCount, int hatCount);
+void _glfwInputJoystick(_GLFWjoystick* js, int event);
+void _glfwInputJoystickAxis(_GLFWjoystick* js, int axis, float value);
+void _glfwInputJoystickButton(_GLFWjoystick* js, int button, char value);
+void _glfwInputJoystickHat(_GLFWjoystick* js, int hat, char value);
+}
+
+static double now() {
+    using namespace std::chrono;
+    return duration<double,std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+static std::string buildMappings(int count) {
+    std::string mappings;
+    char line[512];
+    for(int i=0;i<count;i++) {
+        std::snprintf(line,sizeof(line),
+                      "03000000%08x%08x%08x,Synthetic Pad %i,"
+                      "a:b0,b:b1,x:b2,y:b3,back:b6,start:b7,guide:b8,"
+                      "leftshoulder:b4,rightshoulder:b5,leftstick:b9,rightstick:b10,"
+                      "dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,"
+                      "leftx:a0,lefty:a1,rightx:a3,righty:a4,lefttrigger:a2,righttrigger:a5,"
+                      "platform:Linux,\n",
+                      (unsigned)i*2654435761u,(unsigned)std::rand(),(unsigned)i,i);
+        mappings+=line;
+    }
+    return mappings;
+}
+
+static double update(const std::string& mappings) {
+    double start=now();
+    if(!glfwUpdateGamepadMappings(mappings.c_str())) {
+        std::printf("Failed to update gamepad mappings\n");
+        std::exit(EXIT_FAILURE);
+    }
+    return now()-start;
+}
+
+static double load(const char* path) {
+    double start=now();
+    if(!glfwLoadGamepadMappingsFile(path)) {
+        std::printf("Failed to load gamepad mappings from %s\n",path);
+        std::exit(EXIT_FAILURE);
+    }
+    return now()-start;
+}
+
+static void init() {
+    glfwInitHint(GLFW_PLATFORM,GLFW_PLATFORM_NULL);
+    if(!glfwInit()) {
+        std::printf("Failed to initialize GLFW\n");
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+// Mapping lines are the ones starting with a hexadecimal digit
+static int countMappings(const char* path) {
+    std::ifstream file(path);
+    std::string line;
+    int count=0;
+    while(std::getline(file,line)) {
+        if(!line.empty()&&std::isxdigit((unsigned char)line[0]))
+            count++;
+    }
+    return count;
+}
+
+// Connects gamepads with six axes, eleven buttons and a hat and returns the
+// average time of one glfwGetGamepadState call
+static double timeGamepadState(double& checksum) {
+    _GLFWjoystick* joysticks[kGamepads];
+    std::string mappings;
+    char line[512];
+    for(int i=0;i<kGamepads;i++) {
+        char guid[33];
+        std::snprintf(guid,sizeof(guid),"03000000%08x0000000000%06x",0x5e04u+i,i);
+        std::snprintf(line,sizeof(line),
+                      "%s,Bench Pad %i,"
+                      "a:b0,b:b1,x:b2,y:b3,back:b6,start:b7,guide:b8,"
+                      "leftshoulder:b4,rightshoulder:b5,leftstick:b9,rightstick:b10,"
+                      "dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,"
+                      "leftx:a0,lefty:a1,rightx:a3,righty:a4,lefttrigger:a2,righttrigger:a5,\n",
+                      guid,i);
+        mappings+=line;
+        joysticks[i]=_glfwAllocJoystick("Bench Pad",guid,6,11,1);
+        if(!joysticks[i]) {
+            std::printf("Failed to connect gamepad\n");
+            std::exit(EXIT_FAILURE);
+        }
+        _glfwInputJoystick(joysticks[i],GLFW_CONNECTED);
+    }
+    update(mappings);
+
+    // Only the reads are timed, not the input that changes the gamepads
+    GLFWgamepadstate state;
+    double elapsed=0.0;
+    for(int frame=0;frame<kStateFrames;frame++) {
+        for(int i=0;i<kGamepads;i++) {
+            _glfwInputJoystickAxis(joysticks[i],frame%6,(frame%201-100)/100.f);
+            _glfwInputJoystickButton(joysticks[i],frame%11,frame%2?GLFW_PRESS:GLFW_RELEASE);
+            _glfwInputJoystickHat(joysticks[i],0,GLFW_HAT_UP<<(frame%4));
+        }
+        double start=now();
+        for(int i=0;i<kGamepads;i++) {
+            if(!glfwGetGamepadState(i,&state)) {
+                std::printf("Gamepad %i has no mapping\n",i);
+                std::exit(EXIT_FAILURE);
+            }
+            checksum+=state.axes[frame%6]+state.buttons[frame%15];
+        }
+        elapsed+=now()-start;
+    }
+    return elapsed*1e6/((double)kStateFrames*kGamepads);
+}
+
+// Average time of a glfwInit and glfwTerminate pair
+static double timeInit() {
+    double start=now();
+    for(int i=0;i<kInitRepeats;i++) {
+        init();
+        glfwTerminate();
+    }
+    return (now()-start)/kInitRepeats;
+}
+
+int main(int argc, char** argv) {
+    int count=kDefaultMappings;
+    if(argc>1)
+        count=std::atoi(argv[1]);
+    if(count<1)
+        count=1;
+
+    timeInit();
+    const double initTime=timeInit();
+
+    std::srand(1);
+    const std::string mappings=buildMappings(count);
+    std::ofstream(kMappingsFile,std::ios::binary)<<mappings;
+
+    init();
+    const double added=update(mappings);
+    const double replaced=update(mappings);
+    glfwTerminate();
+
+    init();
+    const double fileAdded=load(kMappingsFile);
+    const double fileReplaced=load(kMappingsFile);
+    glfwTerminate();
+    std::remove(kMappingsFile);
+
+    std::printf("glfwInit and glfwTerminate: %.1f us\n",initTime*1e3);
+    std::printf("%i mappings, %lu bytes\n",count,(unsigned long)mappings.size());
+    std::printf("%-14s %12s %12s\n","update","total ms","ns/mapping");
+    std::printf("%-14s %12.2f %12.1f\n","add",added,added*1e6/count);
+    std::printf("%-14s %12.2f %12.1f\n","replace",replaced,replaced*1e6/count);
+    std::printf("%-14s %12.2f %12.1f\n","file add",fileAdded,fileAdded*1e6/count);
+    std::printf("%-14s %12.2f %12.1f\n","file replace",fileReplaced,fileReplaced*1e6/count);
+
+    double checksum=0.0;
+    init();
+    const double stateTime=timeGamepadState(checksum);
+    glfwTerminate();
+    std::printf("glfwGetGamepadState, %i gamepads: %.1f ns/call (checksum %g)\n",kGamepads,stateTime,checksum);
+
+    if(argc>2) {
+        const int databaseCount=countMappings(argv[2]);
+        init();
+        const double database=load(argv[2]);
+        glfwTerminate();
+        std::printf("%s: %i mappings loaded in %.2f ms\n",argv[2],databaseCount,database);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,314 @@
+// Scripted input latency benchmark, an automated take on GLFW's
+// tests/inputlag.c
+//
+// Usage: bench_inputlag [events per type] [p99 limit in microseconds]
+//
+// Injects cursor motion, key, mouse button and scroll events one at a time
+// and timestamps each one from injection to its callback and to the end of the
+// next glfwSwapBuffers.  Prints the latency distribution of every event type
+// and fails if a p99 latency exceeds the limit, so regressions in the event
+// pump are caught automatically.
+//
+// With a display and XTest support (HW1_XTEST), events are injected into the
+// X server with XTest and travel the full X11 event path, e.g. on Xvfb:
+//
+//   xvfb-run ./bench_inputlag 1000 5000
+//
+// Otherwise events are injected on the null platform through GLFW's internal
+// input functions, the entry points the backends call from their event
+// handlers.  That path has no server round trip and no GL context to swap.
+#include<algorithm>
+#include<cstdio>
+#include<cstdlib>
+#include<vector>
+
+#if defined(HW1_XTEST)
+#define GLAD_GL_IMPLEMENTATION
+#include<glad/gl.h>
+#define GLFW_INCLUDE_NONE
+#include<GLFW/glfw3.h>
+#define GLFW_EXPOSE_NATIVE_X11
+#include<GLFW/glfw3native.h>
+#include<X11/keysym.h>
+#include<X11/extensions/XTest.h>
+#else
+#define GLFW_INCLUDE_NONE
+#include<GLFW/glfw3.h>
+#endif
+
+// Internal GLFW functions normally called by the platform code
+extern "C" {
+struct _GLFWwindow;
+void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int mods);
+void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods);
+void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos);
+void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset);
+}
+
+enum EventKind {
+    EVENT_CURSOR,
+    EVENT_KEY,
+    EVENT_BUTTON,
+    EVENT_SCROLL,
+    EVENT_KIND_COUNT
+};
+
+static const char* const kKindNames[EVENT_KIND_COUNT]={"cursor","key","button","scroll"};
+static const int kDefaultEvents=500;
+static const double kDeliveryTimeout=1.0;
+
+// Timer values of one event on its way through GLFW
+struct Sample {
+    uint64_t injected;
+    uint64_t stamped;   // glfwGetEventTime in the callback
+    uint64_t delivered; // callback entry
+    uint64_t presented; // return of the following glfwSwapBuffers
+};
+
+// Written by the callbacks for the event in flight
+static struct {
+    bool received;
+    uint64_t stamped;
+    uint64_t delivered;
+} delivery;
+
+static double cursorX,cursorY;
+
+static void deliver() {
+    if(delivery.received)
+        return;
+    delivery.delivered=glfwGetTimerValue();
+    delivery.stamped=glfwGetEventTime();
+    delivery.received=true;
+}
+
+static void keyCallback(GLFWwindow*, int, int, int, int) {
+    deliver();
+}
+
+static void mouseButtonCallback(GLFWwindow*, int, int, int) {
+    deliver();
+}
+
+static void cursorPosCallback(GLFWwindow*, double x, double y) {
+    cursorX=x;
+    cursorY=y;
+    deliver();
+}
+
+static void scrollCallback(GLFWwindow*, double, double) {
+    deliver();
+}
+
+// Injects event i of the given kind.  Keys and buttons alternate between
+// press and release and the cursor alternates between two points, so every
+// injection produces exactly one callback.
+static void injectNull(GLFWwindow* handle, EventKind kind, int i) {
+    _GLFWwindow* window=reinterpret_cast<_GLFWwindow*>(handle);
+    const int action=i%2?GLFW_RELEASE:GLFW_PRESS;
+    switch(kind) {
+        case EVENT_CURSOR:
+            _glfwInputCursorPos(window,100.0+i%2*10.0,100.0);
+            break;
+        case EVENT_KEY:
+            _glfwInputKey(window,GLFW_KEY_A,0,action,0);
+            break;
+        case EVENT_BUTTON:
+            _glfwInputMouseClick(window,GLFW_MOUSE_BUTTON_LEFT,action,0);
+            break;
+        default:
+            _glfwInputScroll(window,0.0,1.0);
+            break;
+    }
+}
+
+#if defined(HW1_XTEST)
+static void injectX11(GLFWwindow* window, EventKind kind, int i) {
+    Display* display=glfwGetX11Display();
+    const Bool press=i%2?False:True;
+    int x,y;
+    glfwGetWindowPos(window,&x,&y);
+    switch(kind) {
+        case EVENT_CURSOR:
+            XTestFakeMotionEvent(display,-1,x+100+i%2*10,y+100,CurrentTime);
+            break;
+        case EVENT_KEY:
+            XTestFakeKeyEvent(display,XKeysymToKeycode(display,XK_a),press,CurrentTime);
+            break;
+        case EVENT_BUTTON:
+            XTestFakeButtonEvent(display,Button1,press,CurrentTime);
+            break;
+        default:
+            // A wheel step is a press and release of button 4, and GLFW only
+            // reports the press
+            XTestFakeButtonEvent(display,Button4,True,CurrentTime);
+            XTestFakeButtonEvent(display,Button4,False,CurrentTime);
+            break;
+    }
+    XFlush(display);
+}
+
+static bool xtestAvailable() {
+    int eventBase,errorBase,major,minor;
+    return XTestQueryExtension(glfwGetX11Display(),&eventBase,&errorBase,&major,&minor)==True;
+}
+
+// Marker at the reported cursor position, as drawn by tests/inputlag.c
+static void drawFrame(GLFWwindow* window) {
+    int width,height;
+    glfwGetFramebufferSize(window,&width,&height);
+    glViewport(0,0,width,height);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(0.0,width,height,0.0,-1.0,1.0);
+    glBegin(GL_QUADS);
+    glVertex2d(cursorX-4.0,cursorY-4.0);
+    glVertex2d(cursorX+4.0,cursorY-4.0);
+    glVertex2d(cursorX+4.0,cursorY+4.0);
+    glVertex2d(cursorX-4.0,cursorY+4.0);
+    glEnd();
+}
+#endif
+
+static double microseconds(uint64_t begin, uint64_t end) {
+    if(end<begin)
+        return -(double)(begin-end)*1e6/glfwGetTimerFrequency();
+    return (double)(end-begin)*1e6/glfwGetTimerFrequency();
+}
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if(sorted.empty())
+        return 0.0;
+    return sorted[std::min(sorted.size()-1,(size_t)(p*sorted.size()))];
+}
+
+// Prints min, p50, p90, p99 and max; returns the p99
+static double printDistribution(const char* kind, const char* stage, std::vector<double>& values) {
+    std::sort(values.begin(),values.end());
+    if(values.empty()) {
+        std::printf("%-8s %-20s %10s\n",kind,stage,"-");
+        return 0.0;
+    }
+    std::printf("%-8s %-20s %10.1f %10.1f %10.1f %10.1f %10.1f\n",kind,stage,
+                values.front(),percentile(values,0.5),percentile(values,0.9),
+                percentile(values,0.99),values.back());
+    return percentile(values,0.99);
+}
+
+int main(int argc, char** argv) {
+    int eventsPerKind=kDefaultEvents;
+    double p99Limit=0.0;
+    if(argc>1)
+        eventsPerKind=std::atoi(argv[1]);
+    if(argc>2)
+        p99Limit=std::atof(argv[2]);
+    if(eventsPerKind<2)
+        eventsPerKind=2;
+
+    bool x11=false;
+#if defined(HW1_XTEST)
+    if(glfwPlatformSupported(GLFW_PLATFORM_X11)) {
+        glfwInitHint(GLFW_PLATFORM,GLFW_PLATFORM_X11);
+        x11=glfwInit()&&xtestAvailable();
+        if(!x11)
+            glfwTerminate();
+    }
+#endif
+    if(!x11) {
+        glfwInitHint(GLFW_PLATFORM,GLFW_PLATFORM_NULL);
+        if(!glfwInit()) {
+            std::printf("Failed to initialize GLFW\n");
+            return EXIT_FAILURE;
+        }
+        glfwWindowHint(GLFW_CLIENT_API,GLFW_NO_API);
+    }
+
+    GLFWwindow* window=glfwCreateWindow(640,480,"bench_inputlag",NULL,NULL);
+    if(!window) {
+        std::printf("Failed to create window\n");
+        glfwTerminate();
+        return EXIT_FAILURE;
+    }
+    glfwSetKeyCallback(window,keyCallback);
+    glfwSetMouseButtonCallback(window,mouseButtonCallback);
+    glfwSetCursorPosCallback(window,cursorPosCallback);
+    glfwSetScrollCallback(window,scrollCallback);
+
+#if defined(HW1_XTEST)
+    if(x11) {
+        glfwMakeContextCurrent(window);
+        gladLoadGL(glfwGetProcAddress);
+        glfwSwapInterval(0);
+        glfwFocusWindow(window);
+        // Settle the initial map, focus and cursor enter events
+        for(int i=0;i<10;i++) {
+            glfwWaitEventsTimeout(0.01);
+            drawFrame(window);
+            glfwSwapBuffers(window);
+        }
+    }
+#endif
+
+    std::vector<Sample> samples[EVENT_KIND_COUNT];
+    int lost=0;
+    for(int i=0;i<eventsPerKind;i++) {
+        for(int k=0;k<EVENT_KIND_COUNT;k++) {
+            const EventKind kind=(EventKind)k;
+            Sample sample;
+            delivery.received=false;
+            sample.injected=glfwGetTimerValue();
+
+#if defined(HW1_XTEST)
+            if(x11) {
+                injectX11(window,kind,i);
+                const double deadline=glfwGetTime()+kDeliveryTimeout;
+                while(!delivery.received&&glfwGetTime()<deadline)
+                    glfwWaitEventsTimeout(kDeliveryTimeout);
+                drawFrame(window);
+                glfwSwapBuffers(window);
+            }
+            else
+#endif
+            {
+                injectNull(window,kind,i);
+                glfwPollEvents();
+            }
+
+            if(!delivery.received) {
+                lost++;
+                continue;
+            }
+            sample.stamped=delivery.stamped;
+            sample.delivered=delivery.delivered;
+            sample.presented=x11?glfwGetTimerValue():0;
+            samples[k].push_back(sample);
+        }
+    }
+
+    std::printf("%s injection, %i events per type, %i lost\n",x11?"XTest":"null platform",eventsPerKind,lost);
+    std::printf("latency in microseconds\n");
+    std::printf("%-8s %-20s %10s %10s %10s %10s %10s\n","event","stage","min","p50","p90","p99","max");
+
+    bool failed=lost>0;
+    for(int k=0;k<EVENT_KIND_COUNT;k++) {
+        std::vector<double> callback,stamp,present;
+        for(size_t i=0;i<samples[k].size();i++) {
+            const Sample& sample=samples[k][i];
+            callback.push_back(microseconds(sample.injected,sample.delivered));
+            stamp.push_back(microseconds(sample.stamped,sample.delivered));
+            if(x11)
+                present.push_back(microseconds(sample.injected,sample.presented));
+        }
+        const double p99=printDistribution(kKindNames[k],"inject->callback",callback);
+        printDistribution(kKindNames[k],"event time->callback",stamp);
+        printDistribution(kKindNames[k],"inject->swap",present);
+        if(p99Limit>0.0&&p99>p99Limit) {
+            std::printf("%s p99 latency %.1f us exceeds the limit of %.1f us\n",kKindNames[k],p99,p99Limit);
+            failed=true;
+        }
+    }
+
+    glfwTerminate();
+    return failed?EXIT_FAILURE:EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+// Job system scaling benchmark
+//
+// Usage: bench_jobs [max threads]
+//
+// Runs the same workloads with 1 to N threads (the main thread plus N-1
+// workers) and prints the time and speedup over the single-threaded run:
+//
+//   parallel-for  a compute-bound loop split into many small chunks
+//   tiny jobs     empty jobs, measuring per-job scheduling overhead
+//   dependencies  chains of jobs released by counters
+#include<chrono>
+#include<cmath>
+#include<cstdio>
+#include<cstdlib>
+#include<thread>
+#include<vector>
+
+#include"job_system.h"
+
+static const size_t kItemCount=1<<18;
+static const size_t kGrain=256;
+static const int kTinyJobCount=100000;
+static const int kChainCount=128;
+static const int kChainLength=16;
+static const int kRepeats=5;
+
+static double now() {
+    using namespace std::chrono;
+    return duration<double,std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+static void computeItems(size_t begin, size_t end, void* data) {
+    float* output=static_cast<float*>(data);
+    for(size_t i=begin;i<end;i++) {
+        float x=(float)i*0.001f;
+        for(int k=0;k<32;k++)
+            x=std::sin(x)*1.5f+0.25f;
+        output[i]=x;
+    }
+}
+
+static void emptyJob(void*) {
+}
+
+static void chainLink(void* data) {
+    std::atomic<int>* total=static_cast<std::atomic<int>*>(data);
+    total->fetch_add(1,std::memory_order_relaxed);
+}
+
+static double benchParallelFor(JobSystem& jobs, std::vector<float>& output) {
+    double start=now();
+    jobs.parallelFor(kItemCount,kGrain,computeItems,&output[0]);
+    return now()-start;
+}
+
+static double benchTinyJobs(JobSystem& jobs) {
+    double start=now();
+    // Submit in batches so the job pool is never exhausted
+    for(int submitted=0;submitted<kTinyJobCount;) {
+        JobCounter counter;
+        for(int i=0;i<1024&&submitted<kTinyJobCount;i++,submitted++)
+            jobs.run(emptyJob,NULL,&counter);
+        jobs.wait(&counter);
+    }
+    return now()-start;
+}
+
+static double benchDependencies(JobSystem& jobs) {
+    std::atomic<int> total(0);
+    std::vector<JobCounter> links(kChainCount*kChainLength);
+
+    double start=now();
+    for(int c=0;c<kChainCount;c++) {
+        for(int l=0;l<kChainLength;l++) {
+            JobCounter* counter=&links[c*kChainLength+l];
+            JobCounter* dependency=l?&links[c*kChainLength+l-1]:NULL;
+            jobs.run(chainLink,&total,counter,dependency);
+        }
+    }
+    for(int c=0;c<kChainCount;c++)
+        jobs.wait(&links[c*kChainLength+kChainLength-1]);
+    double elapsed=now()-start;
+
+    if(total.load()!=kChainCount*kChainLength) {
+        std::printf("dependency chain lost jobs: %i of %i ran\n",total.load(),kChainCount*kChainLength);
+        std::exit(EXIT_FAILURE);
+    }
+    return elapsed;
+}
+
+// Best of several runs to filter out scheduling noise
+template<typename F>
+static double best(F run) {
+    double result=run();
+    for(int i=1;i<kRepeats;i++) {
+        double elapsed=run();
+        if(elapsed<result)
+            result=elapsed;
+    }
+    return result;
+}
+
+int main(int argc, char** argv) {
+    int maxThreads=(int)std::thread::hardware_concurrency();
+    if(argc>1)
+        maxThreads=std::atoi(argv[1]);
+    if(maxThreads<1)
+        maxThreads=1;
+
+    std::vector<float> output(kItemCount);
+    double baseline[3]={0.0,0.0,0.0};
+
+    std::printf("%8s %22s %22s %22s\n","threads","parallel-for ms (x)","tiny jobs ns/job (x)","dependencies ms (x)");
+
+    for(int threads=1;threads<=maxThreads;threads++) {
+        JobSystem jobs(threads-1);
+
+        double times[3];
+        times[0]=best([&]() { return benchParallelFor(jobs,output); });
+        times[1]=best([&]() { return benchTinyJobs(jobs); });
+        times[2]=best([&]() { return benchDependencies(jobs); });
+
+        if(threads==1) {
+            for(int i=0;i<3;i++)
+                baseline[i]=times[i];
+        }
+
+        std::printf("%8i %14.2f (%5.2f) %14.1f (%5.2f) %14.3f (%5.2f)\n",
+                    threads,
+                    times[0],baseline[0]/times[0],
+                    times[1]*1e6/kTinyJobCount,baseline[1]/times[1],
+                    times[2],baseline[2]/times[2]);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+// Keysym to Unicode translation benchmark
+//
+// Usage: bench_keysym [lookups per run]
+//
+// Times GLFW's _glfwKeySym2Unicode, which X11 and Wayland text input call for
+// every key press, against the binary search over sorted keysym and Unicode
+// pairs that it replaced.  The pairs are recovered from _glfwKeySym2Unicode
+// itself, and the two are first checked to agree on every 16-bit keysym and a
+// range of directly encoded UCS keysyms.  Each run looks up the same sequence
+// with both:
+//
+//   random     uniformly random 16-bit keysyms, mostly without a mapping
+//   mapped     uniformly random keysyms from the table
+//   text       Russian, Greek, Hebrew, Thai and Japanese kana text and keypad
+//              digits, as typed, with Shift and the arrow keys in between
+//
+// This relies on GLFW being linked statically, as hw1 builds it.
+#include<chrono>
+#include<cstdint>
+#include<cstdio>
+#include<cstdlib>
+#include<random>
+#include<vector>
+
+static const int kDefaultLookups=10000000;
+static const uint32_t kInvalidCodepoint=0xffffffffu;
+
+// Internal GLFW function used by the X11 and Wayland text input
+extern "C" {
+uint32_t _glfwKeySym2Unicode(unsigned int keysym);
+}
+
+enum Distribution {
+    DISTRIBUTION_RANDOM,
+    DISTRIBUTION_MAPPED,
+    DISTRIBUTION_TEXT,
+    DISTRIBUTION_COUNT
+};
+
+static const char* const kDistributionNames[DISTRIBUTION_COUNT]={"random","mapped","text"};
+
+// Typed text of each script, with Latin-1 spaces and punctuation
+static const char16_t* const kTexts[]={
+    u"Съешь же ещё этих мягких французских булок, да выпей чаю.",
+    u"Ξεσκεπάζω την ψυχοφθόρα βδελυγμία.",
+    u"דג סקרן שט בים מאוכזב ולפתע מצא חברה.",
+    u"เป็นมนุษย์สุดประเสริฐเลิศคุณค่า",
+    u"イロハニホヘト チリヌルヲ ワカヨタレソ ツネナラム",
+    u"¿Qué? Voilà, naïve façade.",
+};
+
+// Shift, Left, Up, Right, Down, KP_1, KP_2, KP_3, KP_Enter
+static const unsigned int kTypedKeys[]={0xffe1,0xff51,0xff52,0xff53,0xff54,0xffb1,0xffb2,
+                                        0xffb3,0xff8d};
+
+struct Pair {
+    unsigned short keysym;
+    unsigned short ucs;
+};
+
+static std::vector<Pair> pairs;
+
+static double now() {
+    using namespace std::chrono;
+    return duration<double,std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+static bool isLatin1(unsigned int keysym) {
+    return (keysym>=0x0020&&keysym<=0x007e)||(keysym>=0x00a0&&keysym<=0x00ff);
+}
+
+// The lookup _glfwKeySym2Unicode did before its table
+static uint32_t search(unsigned int keysym) {
+    if(isLatin1(keysym))
+        return keysym;
+    if((keysym&0xff000000)==0x01000000)
+        return keysym&0x00ffffff;
+    int min=0;
+    int max=(int)pairs.size()-1;
+    while(max>=min) {
+        const int mid=(min+max)/2;
+        if(pairs[mid].keysym<keysym)
+            min=mid+1;
+        else if(pairs[mid].keysym>keysym)
+            max=mid-1;
+        else
+            return pairs[mid].ucs;
+    }
+    return kInvalidCodepoint;
+}
+
+static unsigned int findKeysym(uint32_t codepoint) {
+    if(isLatin1(codepoint))
+        return codepoint;
+    for(size_t i=0;i<pairs.size();i++) {
+        if(pairs[i].ucs==codepoint)
+            return pairs[i].keysym;
+    }
+    return 0x01000000|codepoint;
+}
+
+static std::vector<unsigned int> makeKeysyms(Distribution distribution, int lookups) {
+    std::vector<unsigned int> keysyms;
+    std::mt19937 rng(1234);
+    if(distribution==DISTRIBUTION_RANDOM) {
+        for(int i=0;i<lookups;i++)
+            keysyms.push_back(rng()&0xffff);
+    }
+    else if(distribution==DISTRIBUTION_MAPPED) {
+        for(int i=0;i<lookups;i++)
+            keysyms.push_back(pairs[rng()%pairs.size()].keysym);
+    }
+    else {
+        std::vector<unsigned int> typed;
+        for(size_t t=0;t<sizeof(kTexts)/sizeof(kTexts[0]);t++) {
+            for(const char16_t* c=kTexts[t];*c;c++) {
+                typed.push_back(findKeysym(*c));
+                if(rng()%8==0)
+                    typed.push_back(kTypedKeys[rng()%(sizeof(kTypedKeys)/sizeof(kTypedKeys[0]))]);
+            }
+        }
+        for(int i=0;i<lookups;i++)
+            keysyms.push_back(typed[i%typed.size()]);
+    }
+    return keysyms;
+}
+
+// Returns the time per lookup in nanoseconds
+static double measure(uint32_t (*lookup)(unsigned int), const std::vector<unsigned int>& keysyms,
+                      uint32_t& checksum) {
+    const double start=now();
+    for(size_t i=0;i<keysyms.size();i++)
+        checksum+=lookup(keysyms[i]);
+    return (now()-start)*1e6/keysyms.size();
+}
+
+int main(int argc, char** argv) {
+    int lookups=kDefaultLookups;
+    if(argc>1)
+        lookups=std::atoi(argv[1]);
+    if(lookups<1)
+        lookups=1;
+
+    for(unsigned int keysym=0;keysym<=0xffff;keysym++) {
+        const uint32_t ucs=_glfwKeySym2Unicode(keysym);
+        if(!isLatin1(keysym)&&ucs!=kInvalidCodepoint) {
+            const Pair pair={(unsigned short)keysym,(unsigned short)ucs};
+            pairs.push_back(pair);
+        }
+    }
+
+    long mismatches=0;
+    for(unsigned int keysym=0;keysym<=0xffff;keysym++) {
+        if(search(keysym)!=_glfwKeySym2Unicode(keysym))
+            mismatches++;
+    }
+    for(unsigned int keysym=0x00fff000;keysym<=0x01010000;keysym++) {
+        if(search(keysym)!=_glfwKeySym2Unicode(keysym))
+            mismatches++;
+    }
+    std::printf("%zu table entries, %ld mismatches\n",pairs.size(),mismatches);
+    std::printf("%i lookups per run\n",lookups);
+    std::printf("%-8s %12s %12s %10s\n","keysyms","search ns","table ns","speedup");
+
+    for(int d=0;d<DISTRIBUTION_COUNT;d++) {
+        const std::vector<unsigned int> keysyms=makeKeysyms((Distribution)d,lookups);
+        uint32_t searchSum=0,tableSum=0;
+        const double searchTime=measure(search,keysyms,searchSum);
+        const double tableTime=measure(_glfwKeySym2Unicode,keysyms,tableSum);
+        if(searchSum!=tableSum)
+            mismatches++;
+        std::printf("%-8s %12.2f %12.2f %9.1fx\n",kDistributionNames[d],searchTime,tableTime,
+                    searchTime/tableTime);
+    }
+    return mismatches?EXIT_FAILURE:EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+// User event throughput benchmark, after GLFW's tests/threads.c
+//
+// Usage: bench_userevents [producer threads] [events per producer]
+//
+// Worker threads hand results to the main thread, which sleeps in
+// glfwWaitEvents, in three ways:
+//
+//   callback   glfwPostUserEvent, delivered to the user event callback
+//   queue      glfwPostUserEvent, retrieved with glfwGetEvents
+//   mutex      a mutex-protected std::deque beside glfwPostEmptyEvent, the
+//              workaround applications use without user events
+//
+// Every event carries its producer and sequence number, and the main thread
+// checks that each producer's events arrive complete and in order.  Prints the
+// events per second and per wakeup of each way.  Uses the default platform
+// when it initializes and the null platform otherwise.
+#include<chrono>
+#include<cstdint>
+#include<cstdio>
+#include<cstdlib>
+#include<deque>
+#include<mutex>
+#include<thread>
+#include<vector>
+
+#define GLFW_INCLUDE_NONE
+#include<GLFW/glfw3.h>
+
+static const int kDefaultProducers=8;
+static const int kDefaultEvents=100000;
+static const int kQueueCapacity=256;
+
+enum Delivery {
+    DELIVERY_CALLBACK,
+    DELIVERY_QUEUE,
+    DELIVERY_MUTEX,
+    DELIVERY_COUNT
+};
+
+static const char* const kDeliveryNames[DELIVERY_COUNT]={"callback","queue","mutex"};
+
+struct Result {
+    double elapsed;
+    long wakeups;
+    bool ordered;
+};
+
+// Next expected sequence number of each producer
+static std::vector<intptr_t> expected;
+static long received;
+static bool ordered;
+
+// State of the mutex-protected workaround
+static std::mutex mutex;
+static std::deque<std::pair<int,intptr_t> > pending;
+
+static double now() {
+    using namespace std::chrono;
+    return duration<double,std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+static void receive(int producer, intptr_t sequence) {
+    if(producer<0||producer>=(int)expected.size()||expected[producer]!=sequence)
+        ordered=false;
+    else
+        expected[producer]++;
+    received++;
+}
+
+static void userEventCallback(int type, void* payload) {
+    receive(type,(intptr_t)payload);
+}
+
+static void produce(Delivery delivery, int producer, int events) {
+    for(intptr_t i=0;i<events;i++) {
+        if(delivery==DELIVERY_MUTEX) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pending.push_back(std::make_pair(producer,i));
+            }
+            glfwPostEmptyEvent();
+        }
+        else
+            glfwPostUserEvent(producer,(void*)i);
+    }
+}
+
+static void drain(Delivery delivery) {
+    if(delivery==DELIVERY_QUEUE) {
+        GLFWevent events[kQueueCapacity];
+        int count;
+        do {
+            count=glfwGetEvents(events,kQueueCapacity);
+            for(int i=0;i<count;i++) {
+                if(events[i].type==GLFW_EVENT_USER)
+                    receive(events[i].data.user.type,(intptr_t)events[i].data.user.payload);
+            }
+        } while(count==kQueueCapacity);
+    }
+    else if(delivery==DELIVERY_MUTEX) {
+        std::deque<std::pair<int,intptr_t> > batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            batch.swap(pending);
+        }
+        for(size_t i=0;i<batch.size();i++)
+            receive(batch[i].first,batch[i].second);
+    }
+}
+
+static Result run(Delivery delivery, int producers, int events) {
+    expected.assign(producers,0);
+    received=0;
+    ordered=true;
+    glfwSetUserEventCallback(delivery==DELIVERY_CALLBACK?userEventCallback:NULL);
+
+    const long total=(long)producers*events;
+    Result result;
+    result.wakeups=0;
+    const double start=now();
+    std::vector<std::thread> threads;
+    for(int i=0;i<producers;i++)
+        threads.push_back(std::thread(produce,delivery,i,events));
+    while(received<total) {
+        glfwWaitEvents();
+        drain(delivery);
+        result.wakeups++;
+    }
+    result.elapsed=now()-start;
+    for(size_t i=0;i<threads.size();i++)
+        threads[i].join();
+
+    result.ordered=ordered&&received==total;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    int producers=kDefaultProducers;
+    int events=kDefaultEvents;
+    if(argc>1)
+        producers=std::atoi(argv[1]);
+    if(argc>2)
+        events=std::atoi(argv[2]);
+    if(producers<1)
+        producers=1;
+    if(events<1)
+        events=1;
+
+    if(!glfwInit()) {
+        glfwInitHint(GLFW_PLATFORM,GLFW_PLATFORM_NULL);
+        if(!glfwInit()) {
+            std::printf("Failed to initialize GLFW\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::printf("%i producers, %i events each\n",producers,events);
+    std::printf("%-10s %12s %12s %12s %8s\n","delivery","ms","events/s","events/wake","order");
+
+    bool failed=false;
+    for(int d=0;d<DELIVERY_COUNT;d++) {
+        const Result result=run((Delivery)d,producers,events);
+        const double total=(double)producers*events;
+        std::printf("%-10s %12.1f %12.0f %12.1f %8s\n",kDeliveryNames[d],result.elapsed,
+                    total*1e3/result.elapsed,total/result.wakeups,result.ordered?"ok":"FAILED");
+        if(!result.ordered)
+            failed=true;
+    }
+
+    glfwTerminate();
+    return failed?EXIT_FAILURE:EXIT_SUCCESS;
+}
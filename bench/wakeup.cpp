@@ -0,0 +1,172 @@
+// Empty event wakeup stress test
+//
+// Usage: bench_wakeup [producer threads] [posts per producer]
+//
+// Runs an event loop blocked in glfwWaitEvents on the main thread while other
+// threads wake it with glfwPostEmptyEvent, like a loader or network thread
+// handing results to the render loop:
+//
+//   burst      every producer posts as fast as it can, so most posts arrive
+//              while a wakeup is already pending
+//   ping-pong  one producer posts and waits for the loop to wake up before
+//              posting again, so every post is a wakeup
+//
+// Prints wakeups per second and, where /proc/self/io is available, the read
+// and write system calls per post and per wakeup.  Those counters are process
+// wide and do not include poll(2), which costs one call per wait.  Uses the
+// default platform when it initializes and the null platform otherwise.
+#include<atomic>
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<thread>
+#include<vector>
+
+#define GLFW_INCLUDE_NONE
+#include<GLFW/glfw3.h>
+
+static const int kDefaultProducers=8;
+static const int kDefaultPosts=100000;
+static const int kPingPongPosts=20000;
+
+static std::atomic<bool> running;
+static std::atomic<long> wakeups;
+
+static double now() {
+    using namespace std::chrono;
+    return duration<double,std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Read and write system calls made so far by the whole process
+struct SyscallCount {
+    bool valid;
+    long long reads;
+    long long writes;
+};
+
+static SyscallCount countSyscalls() {
+    SyscallCount count={false,0,0};
+    FILE* file=std::fopen("/proc/self/io","r");
+    if(!file)
+        return count;
+    char line[128];
+    int found=0;
+    while(std::fgets(line,sizeof(line),file)) {
+        if(std::sscanf(line,"syscr: %lld",&count.reads)==1||
+           std::sscanf(line,"syscw: %lld",&count.writes)==1)
+            found++;
+    }
+    std::fclose(file);
+    count.valid=found==2;
+    return count;
+}
+
+struct Result {
+    double elapsed;
+    long posts;
+    long wakeups;
+    SyscallCount syscalls;
+};
+
+// Waits for empty events until the producers are done, counting the returns
+// from glfwWaitEvents
+static void eventLoop() {
+    while(running.load(std::memory_order_acquire)) {
+        glfwWaitEvents();
+        wakeups.fetch_add(1,std::memory_order_release);
+    }
+}
+
+static void burstProducer(int posts) {
+    for(int i=0;i<posts;i++)
+        glfwPostEmptyEvent();
+}
+
+// Posts once per wakeup of the event loop
+static void pingPongProducer(int posts) {
+    for(int i=0;i<posts;i++) {
+        const long seen=wakeups.load(std::memory_order_acquire);
+        glfwPostEmptyEvent();
+        while(wakeups.load(std::memory_order_acquire)==seen)
+            std::this_thread::yield();
+    }
+}
+
+static Result run(int producers, int posts, void (*producer)(int)) {
+    // The cost of reading the counters is measured and removed
+    const SyscallCount base=countSyscalls();
+    const SyscallCount start=countSyscalls();
+
+    running.store(true);
+    wakeups.store(0);
+    const double startTime=now();
+    std::vector<std::thread> threads;
+    for(int i=0;i<producers;i++)
+        threads.push_back(std::thread(producer,posts));
+    std::thread stopper([&threads]() {
+        for(size_t i=0;i<threads.size();i++)
+            threads[i].join();
+        running.store(false,std::memory_order_release);
+        glfwPostEmptyEvent();
+    });
+    eventLoop();
+    stopper.join();
+
+    Result result;
+    result.elapsed=now()-startTime;
+    result.posts=(long)producers*posts+1;
+    result.wakeups=wakeups.load();
+    const SyscallCount end=countSyscalls();
+    result.syscalls.valid=base.valid&&end.valid;
+    result.syscalls.reads=end.reads-start.reads-(start.reads-base.reads);
+    result.syscalls.writes=end.writes-start.writes-(start.writes-base.writes);
+    return result;
+}
+
+static void print(const char* name, const Result& result) {
+    std::printf("%-10s %10ld %10ld %12.0f %10.2f",name,result.posts,result.wakeups,
+                result.wakeups*1e3/result.elapsed,(double)result.posts/result.wakeups);
+    if(result.syscalls.valid) {
+        std::printf(" %12.3f %12.3f\n",(double)result.syscalls.writes/result.posts,
+                    (double)(result.syscalls.reads+result.syscalls.writes)/result.wakeups);
+    }
+    else
+        std::printf(" %12s %12s\n","n/a","n/a");
+}
+
+int main(int argc, char** argv) {
+    int producers=kDefaultProducers;
+    int posts=kDefaultPosts;
+    if(argc>1)
+        producers=std::atoi(argv[1]);
+    if(argc>2)
+        posts=std::atoi(argv[2]);
+    if(producers<1)
+        producers=1;
+    if(posts<1)
+        posts=1;
+
+    if(!glfwInit()) {
+        glfwInitHint(GLFW_PLATFORM,GLFW_PLATFORM_NULL);
+        if(!glfwInit()) {
+            std::printf("Failed to initialize GLFW\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    const int platform=glfwGetPlatform();
+    std::printf("%s platform, %i producers\n",
+                platform==GLFW_PLATFORM_X11?"X11":
+                platform==GLFW_PLATFORM_WAYLAND?"Wayland":
+                platform==GLFW_PLATFORM_NULL?"null":"native",producers);
+    std::printf("%-10s %10s %10s %12s %10s %12s %12s\n","mode","posts","wakeups",
+                "wakeups/s","posts/wake","writes/post","calls/wake");
+
+    // Settle any events left over from initialization
+    glfwPollEvents();
+    print("burst",run(producers,posts,burstProducer));
+    print("ping-pong",run(1,kPingPongPosts,pingPongProducer));
+
+    glfwTerminate();
+    return EXIT_SUCCESS;
+}
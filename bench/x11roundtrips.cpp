@@ -0,0 +1,156 @@
+// X11 round trips per frame of cursor, window and monitor state queries
+//
+// Usage: bench_x11roundtrips [frames] [queries per frame] [statistics]
+//
+// Runs a frame loop that polls events and then reads the cursor position, the
+// window position and size, the framebuffer size, the maximized and iconified
+// attributes and the primary monitor's position and video mode a number of
+// times, as UI code asking for them from several places does, with the cursor
+// warped into the window.  Counts the X
+// requests and the round trips (glfwGetX11RoundTripCount) per frame and times
+// the queries:
+//
+//   events     GLFW answers from the pointer and window events it processed
+//   query      the GLFW_X11_CURSOR_POS_QUERY init hint makes every
+//              glfwGetCursorPos an XQueryPointer round trip
+//   disabled   the cursor is disabled, so every glfwPollEvents also re-centers
+//              it against the window size
+//
+// With a non-zero third argument every run also sets GLFW_X11_STATISTICS, so
+// glfwTerminate prints the round trips by call site and the events by type.
+// Needs an X display, e.g.
+//
+//   xvfb-run ./bench_x11roundtrips 1000 8 1
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+
+#define GLFW_INCLUDE_NONE
+#include<GLFW/glfw3.h>
+#define GLFW_EXPOSE_NATIVE_X11
+#include<GLFW/glfw3native.h>
+
+static const int kDefaultFrames=1000;
+static const int kDefaultReads=8;
+static const int kWindowSize=400;
+
+enum Mode {
+    MODE_EVENTS,
+    MODE_QUERY,
+    MODE_DISABLED,
+    MODE_COUNT
+};
+
+static const char* const kModeNames[MODE_COUNT]={"events","query","disabled"};
+
+static double now() {
+    using namespace std::chrono;
+    return duration<double,std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+struct Result {
+    bool valid;
+    double requestsPerFrame;
+    double roundTripsPerFrame;
+    double readTime;
+    double checksum;
+};
+
+static Result run(Mode mode, int frames, int reads, bool statistics) {
+    Result result={false,0.0,0.0,0.0,0.0};
+
+    glfwInitHint(GLFW_PLATFORM,GLFW_PLATFORM_X11);
+    glfwInitHint(GLFW_X11_CURSOR_POS_QUERY,mode==MODE_QUERY?GLFW_TRUE:GLFW_FALSE);
+    glfwInitHint(GLFW_X11_STATISTICS,statistics?GLFW_TRUE:GLFW_FALSE);
+    if(!glfwInit())
+        return result;
+
+    glfwWindowHint(GLFW_CLIENT_API,GLFW_NO_API);
+    GLFWwindow* window=glfwCreateWindow(kWindowSize,kWindowSize,"bench_x11roundtrips",NULL,NULL);
+    if(!window) {
+        glfwTerminate();
+        return result;
+    }
+
+    // Settle the initial map and move the cursor into the window
+    for(int i=0;i<10;i++)
+        glfwWaitEventsTimeout(0.01);
+    glfwSetCursorPos(window,kWindowSize/2,kWindowSize/2);
+    if(mode==MODE_DISABLED)
+        glfwSetInputMode(window,GLFW_CURSOR,GLFW_CURSOR_DISABLED);
+    for(int i=0;i<10;i++)
+        glfwWaitEventsTimeout(0.01);
+
+    GLFWmonitor* monitor=glfwGetPrimaryMonitor();
+    Display* display=glfwGetX11Display();
+    const unsigned long firstRequest=NextRequest(display);
+    const unsigned long firstRoundTrip=glfwGetX11RoundTripCount();
+    double readTime=0.0;
+    for(int frame=0;frame<frames;frame++) {
+        glfwPollEvents();
+        const double start=now();
+        for(int i=0;i<reads;i++) {
+            double x,y;
+            int xpos,ypos,width,height,fbWidth,fbHeight;
+            glfwGetCursorPos(window,&x,&y);
+            glfwGetWindowPos(window,&xpos,&ypos);
+            glfwGetWindowSize(window,&width,&height);
+            glfwGetFramebufferSize(window,&fbWidth,&fbHeight);
+            result.checksum+=x+y+xpos+ypos+width+height+fbWidth+fbHeight+
+                glfwGetWindowAttrib(window,GLFW_MAXIMIZED)+glfwGetWindowAttrib(window,GLFW_ICONIFIED);
+            if(monitor) {
+                int monitorX,monitorY;
+                glfwGetMonitorPos(monitor,&monitorX,&monitorY);
+                const GLFWvidmode* mode=glfwGetVideoMode(monitor);
+                result.checksum+=monitorX+monitorY+(mode?mode->width+mode->refreshRate:0);
+            }
+        }
+        readTime+=now()-start;
+    }
+
+    result.requestsPerFrame=(double)(NextRequest(display)-firstRequest)/frames;
+    result.roundTripsPerFrame=(double)(glfwGetX11RoundTripCount()-firstRoundTrip)/frames;
+    result.readTime=readTime*1e3/((double)frames*reads);
+    result.valid=true;
+    glfwTerminate();
+    return result;
+}
+
+int main(int argc, char** argv) {
+    int frames=kDefaultFrames;
+    int reads=kDefaultReads;
+    bool statistics=false;
+    if(argc>1)
+        frames=std::atoi(argv[1]);
+    if(argc>2)
+        reads=std::atoi(argv[2]);
+    if(argc>3)
+        statistics=std::atoi(argv[3])!=0;
+    if(frames<1)
+        frames=1;
+    if(reads<1)
+        reads=1;
+
+    if(!glfwPlatformSupported(GLFW_PLATFORM_X11)) {
+        std::printf("GLFW was built without X11\n");
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%i frames, %i rounds of queries per frame\n",frames,reads);
+    std::printf("%-10s %14s %17s %14s %12s\n","mode","requests/frame","round trips/frame",
+                "us per round","checksum");
+
+    bool failed=false;
+    for(int m=0;m<MODE_COUNT;m++) {
+        const Result result=run((Mode)m,frames,reads,statistics);
+        if(!result.valid) {
+            std::printf("%-10s %14s\n",kModeNames[m],"failed");
+            failed=true;
+            continue;
+        }
+        std::printf("%-10s %14.2f %17.2f %14.2f %12g\n",kModeNames[m],result.requestsPerFrame,
+                    result.roundTripsPerFrame,result.readTime,result.checksum);
+        std::fflush(stdout);
+    }
+    return failed?EXIT_FAILURE:EXIT_SUCCESS;
+}
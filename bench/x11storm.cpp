@@ -0,0 +1,193 @@
+// X11 input storm benchmark for the GLFW_X11_EVENT_THREAD init hint
+//
+// Usage: bench_x11storm [milliseconds per run] [events per millisecond]
+//
+// A second X connection floods a window with XTest cursor motion, with a key
+// and a mouse button press and release every 16 motions, while the main
+// thread runs a frame loop that calls glfwPollEvents and then sleeps for a
+// millisecond in place of rendering.  Prints the main thread time spent in
+// glfwPollEvents per frame (mean, p99 and max) and the callbacks per frame,
+// with events read on the main thread and on GLFW's event thread, each with
+// and without GLFW_CURSOR_COALESCE.  Needs an X display with XTest, e.g.
+//
+//   xvfb-run ./bench_x11storm 2000 200
+#include<algorithm>
+#include<atomic>
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<thread>
+#include<vector>
+
+#define GLFW_INCLUDE_NONE
+#include<GLFW/glfw3.h>
+#include<X11/Xlib.h>
+#include<X11/keysym.h>
+#include<X11/extensions/XTest.h>
+
+static const int kDefaultDuration=2000;
+static const int kDefaultRate=200;
+static const int kWindowSize=400;
+static const int kKeyInterval=16;
+
+static std::atomic<bool> storming;
+static long callbacks;
+
+static double now() {
+    using namespace std::chrono;
+    return duration<double,std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+static void keyCallback(GLFWwindow*, int, int, int, int) {
+    callbacks++;
+}
+
+static void mouseButtonCallback(GLFWwindow*, int, int, int) {
+    callbacks++;
+}
+
+static void cursorPosCallback(GLFWwindow*, double, double) {
+    callbacks++;
+}
+
+// Sends about rate events per millisecond inside the window at (x, y) until
+// the storm is stopped
+static void storm(int x, int y, int rate) {
+    Display* display=XOpenDisplay(NULL);
+    if(!display)
+        return;
+    const KeyCode key=XKeysymToKeycode(display,XK_space);
+    long sent=0;
+    const double start=now();
+    while(storming.load(std::memory_order_relaxed)) {
+        // Keep to the rate so the server is not simply saturated
+        if(sent>(now()-start)*rate) {
+            XFlush(display);
+            std::this_thread::yield();
+            continue;
+        }
+        const int i=(int)(sent%kWindowSize);
+        XTestFakeMotionEvent(display,-1,x+i/2+10,y+(i*7)%(kWindowSize-20)+10,CurrentTime);
+        if(sent%kKeyInterval==0) {
+            XTestFakeKeyEvent(display,key,True,CurrentTime);
+            XTestFakeKeyEvent(display,key,False,CurrentTime);
+            XTestFakeButtonEvent(display,Button1,True,CurrentTime);
+            XTestFakeButtonEvent(display,Button1,False,CurrentTime);
+        }
+        sent++;
+    }
+    XCloseDisplay(display);
+}
+
+struct Result {
+    bool valid;
+    std::vector<double> polls;
+    long callbacks;
+};
+
+static Result run(bool thread, bool coalesce, int duration, int rate) {
+    Result result;
+    result.valid=false;
+    result.callbacks=0;
+
+    glfwInitHint(GLFW_PLATFORM,GLFW_PLATFORM_X11);
+    glfwInitHint(GLFW_X11_EVENT_THREAD,thread?GLFW_TRUE:GLFW_FALSE);
+    if(!glfwInit())
+        return result;
+
+    glfwWindowHint(GLFW_CLIENT_API,GLFW_NO_API);
+    GLFWwindow* window=glfwCreateWindow(kWindowSize,kWindowSize,"bench_x11storm",NULL,NULL);
+    if(!window) {
+        glfwTerminate();
+        return result;
+    }
+    glfwSetInputMode(window,GLFW_CURSOR_COALESCE,coalesce?GLFW_TRUE:GLFW_FALSE);
+    glfwSetKeyCallback(window,keyCallback);
+    glfwSetMouseButtonCallback(window,mouseButtonCallback);
+    glfwSetCursorPosCallback(window,cursorPosCallback);
+    glfwFocusWindow(window);
+
+    // Settle the initial map, focus and cursor enter events
+    for(int i=0;i<10;i++)
+        glfwWaitEventsTimeout(0.01);
+
+    int x,y;
+    glfwGetWindowPos(window,&x,&y);
+    callbacks=0;
+    storming.store(true);
+    std::thread injector(storm,x,y,rate);
+
+    const double end=now()+duration;
+    while(now()<end) {
+        const double start=now();
+        glfwPollEvents();
+        result.polls.push_back(now()-start);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    storming.store(false);
+    injector.join();
+    result.callbacks=callbacks;
+    result.valid=true;
+    glfwTerminate();
+    return result;
+}
+
+static void print(const char* name, Result& result) {
+    if(!result.valid) {
+        std::printf("%-18s %10s\n",name,"failed");
+        return;
+    }
+    std::vector<double>& polls=result.polls;
+    std::sort(polls.begin(),polls.end());
+    double total=0.0;
+    for(size_t i=0;i<polls.size();i++)
+        total+=polls[i];
+    const double frames=(double)polls.size();
+    std::printf("%-18s %10zu %10.1f %10.1f %10.1f %12.1f\n",name,polls.size(),
+                total*1e3/frames,polls[std::min(polls.size()-1,(size_t)(frames*0.99))]*1e3,
+                polls.back()*1e3,result.callbacks/frames);
+}
+
+int main(int argc, char** argv) {
+    int duration=kDefaultDuration;
+    int rate=kDefaultRate;
+    if(argc>1)
+        duration=std::atoi(argv[1]);
+    if(argc>2)
+        rate=std::atoi(argv[2]);
+    if(duration<100)
+        duration=100;
+    if(rate<1)
+        rate=1;
+
+    if(!glfwPlatformSupported(GLFW_PLATFORM_X11)) {
+        std::printf("GLFW was built without X11\n");
+        return EXIT_FAILURE;
+    }
+    // The injector thread has its own display connection
+    XInitThreads();
+    Display* display=XOpenDisplay(NULL);
+    int eventBase,errorBase,major,minor;
+    if(!display||!XTestQueryExtension(display,&eventBase,&errorBase,&major,&minor)) {
+        std::printf("Needs an X display with XTest\n");
+        if(display)
+            XCloseDisplay(display);
+        return EXIT_FAILURE;
+    }
+    XCloseDisplay(display);
+
+    std::printf("%i ms per run, %i events/ms, main thread time per glfwPollEvents\n",duration,rate);
+    std::printf("%-18s %10s %10s %10s %10s %12s\n","events read on","frames","mean us","p99 us",
+                "max us","calls/frame");
+
+    const char* const names[4]={"main","main, coalesced","thread","thread, coalesced"};
+    bool failed=false;
+    for(int i=0;i<4;i++) {
+        Result result=run(i>=2,i%2==1,duration,rate);
+        print(names[i],result);
+        if(!result.valid)
+            failed=true;
+    }
+    return failed?EXIT_FAILURE:EXIT_SUCCESS;
+}
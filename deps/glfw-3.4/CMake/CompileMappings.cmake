@@ -0,0 +1,206 @@
+# Usage:
+# cmake -P CompileMappings.cmake <path/to/mappings.h> <path/to/mapping_table.h>
+#
+# Parses the gamepad mappings in mappings.h the same way as parseMapping in
+# input.c and writes them as a static _GLFWmapping table sorted by GUID, so
+# they need no parsing or allocation at run time.  The first mapping of any
+# duplicate GUID is kept.
+
+# Empty fields are kept when a mapping is split into a list
+cmake_policy(SET CMP0007 NEW)
+
+set(source_path "${CMAKE_ARGV3}")
+set(target_path "${CMAKE_ARGV4}")
+
+if (NOT EXISTS "${source_path}")
+    message(FATAL_ERROR "Failed to find mappings file ${source_path}")
+endif()
+
+# Mapping fields in the order of the GLFW_GAMEPAD_BUTTON_* and
+# GLFW_GAMEPAD_AXIS_* values
+set(button_fields a b x y leftshoulder rightshoulder back start guide
+                  leftstick rightstick dpup dpright dpdown dpleft)
+set(axis_fields leftx lefty rightx righty lefttrigger righttrigger)
+
+# Converts decimal digits to a uint8_t index the way input.c does
+function(to_index digits result)
+    string(REGEX REPLACE "^0+" "" digits "${digits}")
+    if (digits STREQUAL "")
+        set(digits 0)
+    endif()
+    math(EXPR index "${digits} % 256")
+    set(${result} "${index}" PARENT_SCOPE)
+endfunction()
+
+# Parses a mapping element like b4, h0.1, +a2 or a3~ into a _GLFWmapelement
+# initializer, or an empty string if the element is not understood
+function(parse_element value result)
+    set(minimum -1)
+    set(maximum 1)
+    set(element "")
+
+    if (value MATCHES "^\\+(.*)$")
+        set(minimum 0)
+        set(value "${CMAKE_MATCH_1}")
+    elseif (value MATCHES "^-(.*)$")
+        set(maximum 0)
+        set(value "${CMAKE_MATCH_1}")
+    endif()
+
+    # Missing indices are zero, like strtoul returns
+    if (value MATCHES "^a([0-9]*)(.*)$")
+        set(suffix "${CMAKE_MATCH_2}")
+        to_index("${CMAKE_MATCH_1}" index)
+        math(EXPR scale "2 / (${maximum} - (${minimum}))")
+        math(EXPR offset "-(${maximum} + (${minimum}))")
+        if (suffix MATCHES "^~")
+            math(EXPR scale "-(${scale})")
+            math(EXPR offset "-(${offset})")
+        endif()
+        set(element "{ 1, ${index}, ${scale}, ${offset} }")
+    elseif (value MATCHES "^b([0-9]*)")
+        to_index("${CMAKE_MATCH_1}" index)
+        set(element "{ 2, ${index}, 0, 0 }")
+    elseif (value MATCHES "^h([0-9]*).?([0-9]*)")
+        set(bit "${CMAKE_MATCH_2}")
+        to_index("${CMAKE_MATCH_1}" hat)
+        to_index("${bit}" bit)
+        math(EXPR index "((${hat} << 4) | ${bit}) % 256")
+        set(element "{ 3, ${index}, 0, 0 }")
+    endif()
+
+    set(${result} "${element}" PARENT_SCOPE)
+endfunction()
+
+# Applies the GUID conversion of _glfwUpdateGamepadGUIDWin32 and Cocoa
+function(update_guid platform guid result)
+    if (platform STREQUAL "Windows" AND guid MATCHES "^(....)(....)............504944564944$")
+        set(guid "03000000${CMAKE_MATCH_1}0000${CMAKE_MATCH_2}000000000000")
+    elseif (platform STREQUAL "Mac OS X" AND
+            guid MATCHES "^(....)000000000000(....)000000000000$")
+        set(guid "03000000${CMAKE_MATCH_1}0000${CMAKE_MATCH_2}000000000000")
+    endif()
+    set(${result} "${guid}" PARENT_SCOPE)
+endfunction()
+
+# Parses one mapping line and adds it to the table of the current section
+macro(compile_mapping line)
+    set(valid TRUE)
+    string(REPLACE "," ";" fields "${line}")
+    list(GET fields 0 guid)
+    list(LENGTH fields field_count)
+    if (field_count LESS 2)
+        set(valid FALSE)
+    else()
+        list(GET fields 1 name)
+    endif()
+
+    string(LENGTH "${guid}" guid_length)
+    string(LENGTH "${name}" name_length)
+    if (NOT guid_length EQUAL 32 OR name_length GREATER 127)
+        set(valid FALSE)
+    endif()
+
+    foreach (field IN ITEMS ${button_fields} ${axis_fields})
+        set(element_${field} "{ 0, 0, 0, 0 }")
+    endforeach()
+
+    if (valid)
+        list(REMOVE_AT fields 0 1)
+        foreach (field IN LISTS fields)
+            if (field MATCHES "^[+-]")
+                # Output modifiers are not supported
+                set(valid FALSE)
+                break()
+            elseif (field MATCHES "^platform:(.*)$")
+                string(FIND "${CMAKE_MATCH_1}" "${section_platform}" position)
+                if (NOT position EQUAL 0)
+                    set(valid FALSE)
+                    break()
+                endif()
+            elseif (field MATCHES "^([a-z]+):(.*)$")
+                set(key "${CMAKE_MATCH_1}")
+                if (DEFINED element_${key})
+                    parse_element("${CMAKE_MATCH_2}" element)
+                    if (element)
+                        set(element_${key} "${element}")
+                    endif()
+                endif()
+            endif()
+        endforeach()
+    endif()
+
+    if (valid)
+        string(TOLOWER "${guid}" guid)
+        update_guid("${section_platform}" "${guid}" guid)
+
+        list(FIND section_guids "${guid}" existing)
+        if (existing EQUAL -1)
+            list(APPEND section_guids "${guid}")
+
+            set(buttons "")
+            foreach (field IN LISTS button_fields)
+                list(APPEND buttons "${element_${field}}")
+            endforeach()
+            set(axes "")
+            foreach (field IN LISTS axis_fields)
+                list(APPEND axes "${element_${field}}")
+            endforeach()
+            string(REPLACE ";" ", " buttons "${buttons}")
+            string(REPLACE ";" ", " axes "${axes}")
+
+            set(entry_${guid} "    { \"${name}\", \"${guid}\",\n      { ${buttons} },\n      { ${axes} } },\n")
+        endif()
+    endif()
+endmacro()
+
+# Writes the sorted table entries of the current section
+macro(finish_section)
+    if (section_guids)
+        list(SORT section_guids)
+        foreach (guid IN LISTS section_guids)
+            string(APPEND table "${entry_${guid}}")
+            unset(entry_${guid})
+        endforeach()
+    endif()
+    set(section_guids "")
+endmacro()
+
+file(STRINGS "${source_path}" lines)
+
+set(table "")
+set(section_guids "")
+set(section_platform "")
+foreach (line IN LISTS lines)
+    if (line MATCHES "^#if defined\\((.*)\\)")
+        set(section_macro "${CMAKE_MATCH_1}")
+        if (section_macro STREQUAL "_GLFW_WIN32")
+            set(section_platform "Windows")
+        elseif (section_macro STREQUAL "_GLFW_COCOA")
+            set(section_platform "Mac OS X")
+        elseif (section_macro STREQUAL "GLFW_BUILD_LINUX_JOYSTICK")
+            set(section_platform "Linux")
+        else()
+            message(FATAL_ERROR "Unknown mapping section ${section_macro}")
+        endif()
+        string(APPEND table "#if defined(${section_macro})\n")
+    elseif (line MATCHES "^#endif")
+        finish_section()
+        string(APPEND table "${line}\n")
+    elseif (line MATCHES "^\"(.*)\",$")
+        compile_mapping("${CMAKE_MATCH_1}")
+    endif()
+endforeach()
+
+file(WRITE "${target_path}"
+"// Generated from mappings.h by CompileMappings.cmake.  Do not edit.
+//
+// Each platform section is sorted by GUID for binary search.  Only one section
+// is enabled in any build.  The empty last entry keeps the array non-empty and
+// is not part of the table.
+
+static const _GLFWmapping _glfwDefaultMappingTable[] =
+{
+${table}    { \"\", \"\" }
+};
+")
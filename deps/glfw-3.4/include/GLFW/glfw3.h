@@ -1154,6 +1154,9 @@ extern "C" {
 #define GLFW_STICKY_MOUSE_BUTTONS   0x00033003
 #define GLFW_LOCK_KEY_MODS          0x00033004
 #define GLFW_RAW_MOUSE_MOTION       0x00033005
+#define GLFW_EVENT_QUEUE            0x00033006
+#define GLFW_CURSOR_COALESCE        0x00033007
+#define GLFW_CURSOR_PATH            0x00033008
 
 #define GLFW_CURSOR_NORMAL          0x00034001
 #define GLFW_CURSOR_HIDDEN          0x00034002
@@ -1307,6 +1310,21 @@ extern "C" {
  *  Platform selection [init hint](@ref GLFW_PLATFORM).
  */
 #define GLFW_PLATFORM               0x00050003
+/*! @brief Event queue init hint.
+ *
+ *  Event queue [init hint](@ref GLFW_EVENT_QUEUE_DEFAULT_hint).
+ */
+#define GLFW_EVENT_QUEUE_DEFAULT    0x00050004
+/*! @brief Joystick thread init hint.
+ *
+ *  Joystick thread [init hint](@ref GLFW_JOYSTICK_THREAD_hint).
+ */
+#define GLFW_JOYSTICK_THREAD        0x00050005
+/*! @brief Joystick sample history init hint.
+ *
+ *  Joystick sample history [init hint](@ref GLFW_JOYSTICK_SAMPLES_hint).
+ */
+#define GLFW_JOYSTICK_SAMPLES       0x00050006
 /*! @brief macOS specific init hint.
  *
  *  macOS specific [init hint](@ref GLFW_COCOA_CHDIR_RESOURCES_hint).
@@ -1322,6 +1340,21 @@ extern "C" {
  *  X11 specific [init hint](@ref GLFW_X11_XCB_VULKAN_SURFACE_hint).
  */
 #define GLFW_X11_XCB_VULKAN_SURFACE 0x00052001
+/*! @brief X11 specific init hint.
+ *
+ *  X11 specific [init hint](@ref GLFW_X11_EVENT_THREAD_hint).
+ */
+#define GLFW_X11_EVENT_THREAD       0x00052002
+/*! @brief X11 specific init hint.
+ *
+ *  X11 specific [init hint](@ref GLFW_X11_CURSOR_POS_QUERY_hint).
+ */
+#define GLFW_X11_CURSOR_POS_QUERY   0x00052003
+/*! @brief X11 specific init hint.
+ *
+ *  X11 specific [init hint](@ref GLFW_X11_STATISTICS_hint).
+ */
+#define GLFW_X11_STATISTICS         0x00052004
 /*! @brief Wayland specific init hint.
  *
  *  Wayland specific [init hint](@ref GLFW_WAYLAND_LIBDECOR_hint).
@@ -1343,6 +1376,35 @@ extern "C" {
 #define GLFW_PLATFORM_NULL          0x00060005
 /*! @} */
 
+/*! @defgroup event_types Event types
+ *  @brief Types of the events returned by @ref glfwGetEvents.
+ *
+ *  See [event queue](@ref event_queue) for how these are used.
+ *
+ *  @ingroup input
+ *  @{ */
+#define GLFW_EVENT_KEY              0x00070001
+#define GLFW_EVENT_CHAR             0x00070002
+#define GLFW_EVENT_MOUSE_BUTTON     0x00070003
+#define GLFW_EVENT_CURSOR_POS       0x00070004
+#define GLFW_EVENT_CURSOR_ENTER     0x00070005
+#define GLFW_EVENT_SCROLL           0x00070006
+#define GLFW_EVENT_CURSOR_PATH      0x00070007
+#define GLFW_EVENT_USER             0x00070008
+/*! @} */
+
+/*! @defgroup joystick_sample_types Joystick sample types
+ *  @brief Types of the samples returned by @ref glfwGetJoystickSamples.
+ *
+ *  See [joystick sample history](@ref joystick_samples) for how these are used.
+ *
+ *  @ingroup input
+ *  @{ */
+#define GLFW_JOYSTICK_SAMPLE_AXIS   0x00080001
+#define GLFW_JOYSTICK_SAMPLE_BUTTON 0x00080002
+#define GLFW_JOYSTICK_SAMPLE_HAT    0x00080003
+/*! @} */
+
 #define GLFW_DONT_CARE              -1
 
 
@@ -2010,6 +2072,66 @@ typedef void (* GLFWmonitorfun)(GLFWmonitor* monitor, int event);
  */
 typedef void (* GLFWjoystickfun)(int jid, int event);
 
+/*! @brief The function pointer type for event source callbacks.
+ *
+ *  This is the function pointer type for event source callbacks.  An event
+ *  source callback function has the following signature:
+ *  @code
+ *  void function_name(int fd)
+ *  @endcode
+ *
+ *  @param[in] fd The file descriptor that is ready for reading, has been
+ *  closed by its peer or has an error.
+ *
+ *  @sa @ref event_sources
+ *  @sa @ref glfwAddEventSource
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+typedef void (* GLFWeventsourcefun)(int fd);
+
+/*! @brief The function pointer type for event deadline callbacks.
+ *
+ *  This is the function pointer type for event deadline callbacks.  An event
+ *  deadline callback function has the following signature:
+ *  @code
+ *  void function_name(uint64_t deadline)
+ *  @endcode
+ *
+ *  @param[in] deadline The deadline that was reached, in the timebase of @ref
+ *  glfwGetTimerValue.
+ *
+ *  @sa @ref event_sources
+ *  @sa @ref glfwSetEventDeadline
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+typedef void (* GLFWdeadlinefun)(uint64_t deadline);
+
+/*! @brief The function pointer type for user event callbacks.
+ *
+ *  This is the function pointer type for user event callbacks.  A user event
+ *  callback function has the following signature:
+ *  @code
+ *  void function_name(int type, void* payload)
+ *  @endcode
+ *
+ *  @param[in] type The type passed to @ref glfwPostUserEvent.
+ *  @param[in] payload The payload passed to @ref glfwPostUserEvent.
+ *
+ *  @sa @ref user_events
+ *  @sa @ref glfwSetUserEventCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+typedef void (* GLFWusereventfun)(int type, void* payload);
+
 /*! @brief Video mode type.
  *
  *  This describes a single video mode.
@@ -2122,6 +2244,131 @@ typedef struct GLFWgamepadstate
     float axes[6];
 } GLFWgamepadstate;
 
+/*! @brief Keyboard and mouse button state snapshot.
+ *
+ *  This describes the key and mouse button state of a window as returned by
+ *  @ref glfwGetInputSnapshot, one bit per key or button.  The bit of key `k`
+ *  is `1u << (k % 32)` in element `k / 32` of the key arrays and the bit of
+ *  mouse button `b` is `1u << b`.
+ *
+ *  @sa @ref input_snapshot
+ *  @sa @ref glfwGetInputSnapshot
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef struct GLFWinputsnapshot
+{
+    /*! The keys that are pressed.
+     */
+    uint32_t keys[(GLFW_KEY_LAST + 32) / 32];
+    /*! The keys that were pressed or released since the previous snapshot of
+     *  the window.
+     */
+    uint32_t keysChanged[(GLFW_KEY_LAST + 32) / 32];
+    /*! The mouse buttons that are pressed.
+     */
+    uint32_t mouseButtons;
+    /*! The mouse buttons that were pressed or released since the previous
+     *  snapshot of the window.
+     */
+    uint32_t mouseButtonsChanged;
+} GLFWinputsnapshot;
+
+/*! @brief Queued input event.
+ *
+ *  This describes an input event returned by @ref glfwGetEvents.  The `type`
+ *  member is one of the [event types](@ref event_types) and selects the member
+ *  of `data` that is valid.  The values match the arguments of the
+ *  corresponding callback.
+ *
+ *  @sa @ref event_queue
+ *  @sa @ref glfwGetEvents
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef struct GLFWevent
+{
+    /*! The [type](@ref event_types) of the event.
+     */
+    int type;
+    /*! The window that received the event.
+     */
+    GLFWwindow* window;
+    /*! The [time](@ref event_time) of the event, in the timebase of @ref
+     *  glfwGetTimerValue.
+     */
+    uint64_t time;
+    union
+    {
+        /*! Valid for `GLFW_EVENT_KEY`.
+         */
+        struct { int key; int scancode; int action; int mods; } key;
+        /*! Valid for `GLFW_EVENT_CHAR`.
+         */
+        struct { unsigned int codepoint; int mods; } character;
+        /*! Valid for `GLFW_EVENT_MOUSE_BUTTON`.
+         */
+        struct { int button; int action; int mods; } mouseButton;
+        /*! Valid for `GLFW_EVENT_CURSOR_POS` and `GLFW_EVENT_CURSOR_PATH`,
+         *  in screen coordinates relative to the content area.  The delta is
+         *  the [motion](@ref cursor_coalesce) since the previous event of the
+         *  same type.
+         */
+        struct { double xpos; double ypos; double xdelta; double ydelta; } cursorPos;
+        /*! Valid for `GLFW_EVENT_CURSOR_ENTER`.
+         */
+        struct { int entered; } cursorEnter;
+        /*! Valid for `GLFW_EVENT_SCROLL`.
+         */
+        struct { double xoffset; double yoffset; } scroll;
+        /*! Valid for `GLFW_EVENT_USER`, whose window is `NULL` and whose
+         *  time is when it was delivered.  The values are those passed to @ref
+         *  glfwPostUserEvent.
+         */
+        struct { int type; void* payload; } user;
+    } data;
+} GLFWevent;
+
+/*! @brief Joystick state change sample.
+ *
+ *  This describes a single axis, button or hat change of a joystick returned
+ *  by @ref glfwGetJoystickSamples.  The `type` member is one of the
+ *  [joystick sample types](@ref joystick_sample_types).
+ *
+ *  @sa @ref joystick_samples
+ *  @sa @ref glfwGetJoystickSamples
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef struct GLFWjoysticksample
+{
+    /*! The [time](@ref event_time) of the change, in the timebase of @ref
+     *  glfwGetTimerValue.
+     */
+    uint64_t time;
+    /*! The [type](@ref joystick_sample_types) of the sample.
+     */
+    int type;
+    /*! The index of the axis, button or hat, as in the arrays returned by
+     *  @ref glfwGetJoystickAxes, @ref glfwGetJoystickButtons and @ref
+     *  glfwGetJoystickHats.
+     */
+    int index;
+    /*! The new axis value for `GLFW_JOYSTICK_SAMPLE_AXIS`, otherwise zero.
+     */
+    float axis;
+    /*! The new button state for `GLFW_JOYSTICK_SAMPLE_BUTTON` or hat state for
+     *  `GLFW_JOYSTICK_SAMPLE_HAT`, otherwise zero.
+     */
+    int state;
+} GLFWjoysticksample;
+
 /*! @brief Custom heap memory allocator.
  *
  *  This describes a custom heap memory allocator for GLFW.  To set an allocator, pass it
@@ -3433,6 +3680,10 @@ GLFWAPI void glfwSetWindowIcon(GLFWwindow* window, int count, const GLFWimage* i
  *  position of its windows.  This function will emit @ref
  *  GLFW_FEATURE_UNAVAILABLE.
  *
+ *  @remark @x11 This function returns the position from the last processed
+ *  `ConfigureNotify` event, so a new position is returned only after its events
+ *  have been processed.
+ *
  *  @thread_safety This function must only be called from the main thread.
  *
  *  @sa @ref window_pos
@@ -3497,6 +3748,10 @@ GLFWAPI void glfwSetWindowPos(GLFWwindow* window, int xpos, int ypos);
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
  *  GLFW_PLATFORM_ERROR.
  *
+ *  @remark @x11 This function returns the size from the last processed
+ *  `ConfigureNotify` event, so a new size is returned only after its events
+ *  have been processed.
+ *
  *  @thread_safety This function must only be called from the main thread.
  *
  *  @sa @ref window_size
@@ -4098,6 +4353,11 @@ GLFWAPI void glfwSetWindowMonitor(GLFWwindow* window, GLFWmonitor* monitor, int
  *  @remark @wayland The Wayland protocol provides no way to check whether a
  *  window is iconfied, so @ref GLFW_ICONIFIED always returns `GLFW_FALSE`.
  *
+ *  @remark @x11 This function returns @ref GLFW_ICONIFIED and @ref
+ *  GLFW_MAXIMIZED from the last processed `PropertyNotify` events for the
+ *  `WM_STATE` and `_NET_WM_STATE` properties, so a new state is returned only
+ *  after its events have been processed.
+ *
  *  @thread_safety This function must only be called from the main thread.
  *
  *  @sa @ref window_attribs
@@ -4632,6 +4892,9 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout);
  *  This function posts an empty event from the current thread to the event
  *  queue, causing @ref glfwWaitEvents or @ref glfwWaitEventsTimeout to return.
  *
+ *  Empty events posted before the event loop has been woken by an earlier one
+ *  are merged with it and cause no additional wakeup.
+ *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
  *  GLFW_PLATFORM_ERROR.
  *
@@ -4647,17 +4910,180 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout);
  */
 GLFWAPI void glfwPostEmptyEvent(void);
 
+/*! @brief Adds a file descriptor to wait for during event processing.
+ *
+ *  This function adds a file descriptor, for example a socket or a pipe, to
+ *  the set GLFW waits on in @ref glfwWaitEvents and @ref glfwWaitEventsTimeout
+ *  and checks in @ref glfwPollEvents.  When the descriptor is ready for
+ *  reading, the callback is called from event processing and the wait
+ *  returns.  If the descriptor was already added, its callback is replaced.
+ *
+ *  The callback is called every time events are processed for as long as the
+ *  descriptor remains ready, so it should read the available data.  If the
+ *  peer closes the descriptor, remove it before closing it.
+ *
+ *  @param[in] fd The file descriptor to wait for.
+ *  @param[in] callback The function to call when the descriptor is ready.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE, @ref GLFW_OUT_OF_MEMORY and @ref
+ *  GLFW_FEATURE_UNAVAILABLE.
+ *
+ *  @remark Event sources are supported on X11, Wayland and the null platform
+ *  on POSIX systems.  Elsewhere this function emits @ref
+ *  GLFW_FEATURE_UNAVAILABLE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref event_sources
+ *  @sa @ref glfwRemoveEventSource
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwAddEventSource(int fd, GLFWeventsourcefun callback);
+
+/*! @brief Removes a file descriptor added with glfwAddEventSource.
+ *
+ *  This function removes a file descriptor from the set GLFW waits on during
+ *  event processing.  It does nothing if the descriptor was not added.  It may
+ *  be called from an event source callback.
+ *
+ *  @param[in] fd The file descriptor to remove.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref event_sources
+ *  @sa @ref glfwAddEventSource
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwRemoveEventSource(int fd);
+
+/*! @brief Sets the deadline for the event wait.
+ *
+ *  This function sets a point in time, in the timebase of @ref
+ *  glfwGetTimerValue, at which @ref glfwWaitEvents and @ref
+ *  glfwWaitEventsTimeout return and the callback is called from event
+ *  processing.  The deadline is then cleared.  There is a single deadline and
+ *  setting it replaces the previous one.  A deadline of zero clears it.
+ *
+ *  The deadline is a timer waited on together with the window system and the
+ *  [event sources](@ref glfwAddEventSource), so waiting for it needs no extra
+ *  thread or wakeup.
+ *
+ *  @param[in] deadline The time to wake up at, or zero to clear the deadline.
+ *  @param[in] callback The function to call at the deadline, or `NULL`.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_OUT_OF_MEMORY, @ref GLFW_PLATFORM_ERROR and @ref
+ *  GLFW_FEATURE_UNAVAILABLE.
+ *
+ *  @remark Event deadlines are supported on X11, Wayland and the null platform
+ *  on Linux, where they use a timerfd.  Elsewhere this function emits @ref
+ *  GLFW_FEATURE_UNAVAILABLE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref event_sources
+ *  @sa @ref glfwGetTimerValue
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwSetEventDeadline(uint64_t deadline, GLFWdeadlinefun callback);
+
+/*! @brief Posts an event with an application payload to the main thread.
+ *
+ *  This function posts an event with an application defined type and payload
+ *  from the current thread and wakes up @ref glfwWaitEvents and @ref
+ *  glfwWaitEventsTimeout like @ref glfwPostEmptyEvent.  This lets worker
+ *  threads hand their results to the main thread without a queue of their
+ *  own.
+ *
+ *  User events are delivered by the next event processing on the main thread,
+ *  in the order they were posted, to the callback set with @ref
+ *  glfwSetUserEventCallback or, if there is none, to the event queue as
+ *  `GLFW_EVENT_USER` events retrieved with @ref glfwGetEvents.  Events posted
+ *  during delivery are delivered by the following event processing.  Events
+ *  not yet delivered are discarded by @ref glfwTerminate.
+ *
+ *  Posting takes no locks.  Each event is allocated with the
+ *  [heap allocator](@ref init_allocator).
+ *
+ *  @param[in] type An application defined event type.
+ *  @param[in] payload An application defined pointer, which GLFW does not
+ *  dereference.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_OUT_OF_MEMORY and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref user_events
+ *  @sa @ref glfwSetUserEventCallback
+ *  @sa @ref glfwPostEmptyEvent
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwPostUserEvent(int type, void* payload);
+
+/*! @brief Sets the user event callback.
+ *
+ *  This function sets the user event callback, or removes the currently set
+ *  callback.  This is called from event processing on the main thread for each
+ *  event posted with @ref glfwPostUserEvent.  While no callback is set, user
+ *  events go to the event queue instead.
+ *
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(int type, void* payload)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWusereventfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref user_events
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI GLFWusereventfun glfwSetUserEventCallback(GLFWusereventfun callback);
+
 /*! @brief Returns the value of an input option for the specified window.
  *
  *  This function returns the value of an input option for the specified window.
  *  The mode must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
- *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS or
- *  @ref GLFW_RAW_MOUSE_MOTION.
+ *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS,
+ *  @ref GLFW_RAW_MOUSE_MOTION, @ref GLFW_EVENT_QUEUE, @ref GLFW_CURSOR_COALESCE
+ *  or @ref GLFW_CURSOR_PATH.
  *
  *  @param[in] window The window to query.
  *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
- *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS` or
- *  `GLFW_RAW_MOUSE_MOTION`.
+ *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS`,
+ *  `GLFW_RAW_MOUSE_MOTION`, `GLFW_EVENT_QUEUE`, `GLFW_CURSOR_COALESCE` or
+ *  `GLFW_CURSOR_PATH`.
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
  *  GLFW_INVALID_ENUM.
@@ -4676,8 +5102,9 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
  *
  *  This function sets an input mode option for the specified window.  The mode
  *  must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
- *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS or
- *  @ref GLFW_RAW_MOUSE_MOTION.
+ *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS,
+ *  @ref GLFW_RAW_MOUSE_MOTION, @ref GLFW_EVENT_QUEUE, @ref GLFW_CURSOR_COALESCE
+ *  or @ref GLFW_CURSOR_PATH.
  *
  *  If the mode is `GLFW_CURSOR`, the value must be one of the following cursor
  *  modes:
@@ -4717,10 +5144,31 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
  *  attempting to set this will emit @ref GLFW_FEATURE_UNAVAILABLE.  Call @ref
  *  glfwRawMouseMotionSupported to check for support.
  *
+ *  If the mode is `GLFW_EVENT_QUEUE`, the value must be either `GLFW_TRUE` to
+ *  append the key, character, mouse button, cursor position, cursor enter and
+ *  scroll events of the window to the event queue instead of calling their
+ *  callbacks, or `GLFW_FALSE` to use the callbacks.  Queued events are
+ *  retrieved with @ref glfwGetEvents.  The initial value is set by the @ref
+ *  GLFW_EVENT_QUEUE_DEFAULT init hint.
+ *
+ *  If the mode is `GLFW_CURSOR_COALESCE`, the value must be either `GLFW_TRUE`
+ *  to merge consecutive cursor motion of the window into a single cursor
+ *  position event per event processing call, or `GLFW_FALSE` to report every
+ *  motion.  Merged motion is reported with its final position and summed delta
+ *  before the next other input event of the window and when event processing
+ *  returns.  It is disabled by default.
+ *
+ *  If the mode is `GLFW_CURSOR_PATH`, the value must be either `GLFW_TRUE` to
+ *  also append every motion merged by `GLFW_CURSOR_COALESCE` to the event queue
+ *  as a `GLFW_EVENT_CURSOR_PATH` event, or `GLFW_FALSE` to discard it.  This
+ *  only has an effect while `GLFW_EVENT_QUEUE` is also enabled.  It is disabled
+ *  by default.
+ *
  *  @param[in] window The window whose input mode to set.
  *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
- *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS` or
- *  `GLFW_RAW_MOUSE_MOTION`.
+ *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS`,
+ *  `GLFW_RAW_MOUSE_MOTION`, `GLFW_EVENT_QUEUE`, `GLFW_CURSOR_COALESCE` or
+ *  `GLFW_CURSOR_PATH`.
  *  @param[in] value The new value of the specified input mode.
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
@@ -4737,6 +5185,70 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
  */
 GLFWAPI void glfwSetInputMode(GLFWwindow* window, int mode, int value);
 
+/*! @brief Retrieves queued input events.
+ *
+ *  This function copies up to `capacity` of the oldest events from the event
+ *  queue to the array and removes them from the queue.  Events of every window
+ *  with the @ref GLFW_EVENT_QUEUE input mode enabled are queued in the order
+ *  they were processed, so call this after @ref glfwPollEvents or @ref
+ *  glfwWaitEvents until it returns less than `capacity`.  Those windows with the
+ *  @ref GLFW_CURSOR_PATH input mode enabled also queue their merged cursor
+ *  motion, and [user events](@ref glfwPostUserEvent) are queued while there is
+ *  no user event callback.
+ *
+ *  Queued events are only delivered here, not to the callbacks, but the key,
+ *  mouse button and cursor state returned by @ref glfwGetKey, @ref
+ *  glfwGetMouseButton and @ref glfwGetCursorPos is updated as usual.  The
+ *  queue grows as needed until it is drained.  Events of a window are removed
+ *  from the queue when it is destroyed.
+ *
+ *  @param[out] events The array to copy events to.
+ *  @param[in] capacity The number of elements in the array.
+ *  @return The number of events copied, or zero if the queue is empty or an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref event_queue
+ *  @sa @ref GLFW_EVENT_QUEUE
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetEvents(GLFWevent* events, int capacity);
+
+/*! @brief Returns the time of the latest input event.
+ *
+ *  This function returns the time of the most recently reported key,
+ *  character, mouse button, cursor position, cursor enter or scroll event of
+ *  any window, in the timebase of @ref glfwGetTimerValue.  Call it from an
+ *  input callback to get the time of the event being delivered.  Queued events
+ *  carry their own time in the `time` member of @ref GLFWevent.
+ *
+ *  Where the platform provides it, this is the time the event was generated,
+ *  as reported by the window system.  Otherwise it is the time GLFW processed
+ *  the event.
+ *
+ *  @return The time of the latest input event, or zero if no event has been
+ *  reported or an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref event_time
+ *  @sa @ref glfwGetJoystickEventTime
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI uint64_t glfwGetEventTime(void);
+
 /*! @brief Returns whether raw mouse motion is supported.
  *
  *  This function returns whether raw mouse motion is supported on the current
@@ -4929,6 +5441,38 @@ GLFWAPI int glfwGetKey(GLFWwindow* window, int key);
  */
 GLFWAPI int glfwGetMouseButton(GLFWwindow* window, int button);
 
+/*! @brief Retrieves the state of every key and mouse button of the specified
+ *  window.
+ *
+ *  This function copies the last reported state of all keys and mouse buttons
+ *  of the specified window into a bitset, along with the keys and buttons that
+ *  were pressed or released since the previous call for that window.  A key
+ *  pressed and released again between two calls is reported as changed but not
+ *  pressed.  This replaces one @ref glfwGetKey or @ref glfwGetMouseButton call
+ *  per key or button with one call per frame.
+ *
+ *  If the @ref GLFW_STICKY_KEYS or @ref GLFW_STICKY_MOUSE_BUTTONS input mode is
+ *  enabled, keys and buttons released since they were last polled are reported
+ *  as pressed and then reset, as if polled with @ref glfwGetKey or @ref
+ *  glfwGetMouseButton.
+ *
+ *  If an error occurs, all bits of the snapshot are cleared.
+ *
+ *  @param[in] window The desired window.
+ *  @param[out] snapshot The snapshot to fill in.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_snapshot
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwGetInputSnapshot(GLFWwindow* window, GLFWinputsnapshot* snapshot);
+
 /*! @brief Retrieves the position of the cursor relative to the content area of
  *  the window.
  *
@@ -4956,6 +5500,11 @@ GLFWAPI int glfwGetMouseButton(GLFWwindow* window, int button);
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
  *  GLFW_PLATFORM_ERROR.
  *
+ *  @remark @x11 While the cursor is in the window, this function returns the
+ *  position from the last processed pointer event instead of querying the X
+ *  server, unless the [GLFW_X11_CURSOR_POS_QUERY](@ref GLFW_X11_CURSOR_POS_QUERY_hint)
+ *  init hint is set.
+ *
  *  @thread_safety This function must only be called from the main thread.
  *
  *  @sa @ref cursor_pos
@@ -4967,6 +5516,39 @@ GLFWAPI int glfwGetMouseButton(GLFWwindow* window, int button);
  */
 GLFWAPI void glfwGetCursorPos(GLFWwindow* window, double* xpos, double* ypos);
 
+/*! @brief Retrieves the cursor motion of the latest cursor position event.
+ *
+ *  This function returns the motion of the cursor, in screen coordinates,
+ *  reported with the most recent cursor position event of the specified
+ *  window.  Call it from the cursor position callback to get the motion of the
+ *  event being delivered.  Queued events carry their motion in the `cursorPos`
+ *  member of @ref GLFWevent.
+ *
+ *  If the window has [cursor motion coalescing](@ref cursor_coalesce) enabled,
+ *  this is the sum of the motion merged into the event.  If the cursor is
+ *  disabled and [raw mouse motion](@ref raw_mouse_motion) is enabled, it is the
+ *  sum of the raw motion.
+ *
+ *  Any or all of the delta arguments may be `NULL`.  If an error occurs, all
+ *  non-`NULL` delta arguments will be set to zero.
+ *
+ *  @param[in] window The desired window.
+ *  @param[out] xdelta Where to store the horizontal motion, or `NULL`.
+ *  @param[out] ydelta Where to store the vertical motion, or `NULL`.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref cursor_coalesce
+ *  @sa @ref glfwGetCursorPos
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwGetCursorDelta(GLFWwindow* window, double* xdelta, double* ydelta);
+
 /*! @brief Sets the position of the cursor, relative to the content area of the
  *  window.
  *
@@ -5678,6 +6260,77 @@ GLFWAPI const char* glfwGetJoystickName(int jid);
  */
 GLFWAPI const char* glfwGetJoystickGUID(int jid);
 
+/*! @brief Returns the time of the latest state change of the specified
+ *  joystick.
+ *
+ *  This function returns the time of the latest axis, button or hat change of
+ *  the specified joystick seen by @ref glfwGetJoystickAxes, @ref
+ *  glfwGetJoystickButtons, @ref glfwGetJoystickHats or @ref
+ *  glfwGetGamepadState, in the timebase of @ref glfwGetTimerValue.  It does
+ *  not itself read new input from the device.
+ *
+ *  Where the platform provides it, this is the time the device reported the
+ *  change.  Otherwise it is the time GLFW processed it.
+ *
+ *  If the specified joystick is not present this function will return zero
+ *  but will not generate an error.
+ *
+ *  @param[in] jid The [joystick](@ref joysticks) to query.
+ *  @return The time of the latest state change, or zero if the joystick is
+ *  not present, has not changed state or an [error](@ref error_handling)
+ *  occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref event_time
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI uint64_t glfwGetJoystickEventTime(int jid);
+
+/*! @brief Retrieves and removes the oldest state changes of the specified
+ *  joystick.
+ *
+ *  This function polls the specified joystick like @ref glfwGetJoystickAxes
+ *  and then moves up to `capacity` of its oldest recorded axis, button and
+ *  hat changes into the specified array, oldest first.  Changes are recorded
+ *  as GLFW receives them, so this includes those made and undone between
+ *  calls that the state functions do not see.  Call this repeatedly until it
+ *  returns fewer samples than `capacity` to drain all of them.
+ *
+ *  Changes are only recorded if the @ref GLFW_JOYSTICK_SAMPLES init hint was
+ *  set to a non-zero history size when the library was initialized.  Each
+ *  joystick then keeps up to that many changes that have not been retrieved.
+ *  When its history is full, further changes are discarded until it is
+ *  drained.
+ *
+ *  If the specified joystick is not present this function will return zero
+ *  but will not generate an error.
+ *
+ *  @param[in] jid The [joystick](@ref joysticks) to query.
+ *  @param[out] samples The array to fill with samples.
+ *  @param[in] capacity The number of elements in `samples`.
+ *  @return The number of samples stored, or zero if there were none, the
+ *  joystick is not present or an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM, @ref GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_samples
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetJoystickSamples(int jid, GLFWjoysticksample* samples, int capacity);
+
 /*! @brief Sets the user pointer of the specified joystick.
  *
  *  This function sets the user-defined pointer of the specified joystick.  The
@@ -5817,6 +6470,7 @@ GLFWAPI GLFWjoystickfun glfwSetJoystickCallback(GLFWjoystickfun callback);
  *  @thread_safety This function must only be called from the main thread.
  *
  *  @sa @ref gamepad
+ *  @sa @ref glfwLoadGamepadMappingsFile
  *  @sa @ref glfwJoystickIsGamepad
  *  @sa @ref glfwGetGamepadName
  *
@@ -5826,6 +6480,41 @@ GLFWAPI GLFWjoystickfun glfwSetJoystickCallback(GLFWjoystickfun callback);
  */
 GLFWAPI int glfwUpdateGamepadMappings(const char* string);
 
+/*! @brief Adds the SDL_GameControllerDB gamepad mappings in the specified file.
+ *
+ *  This function maps the specified file into memory and adds the gamepad
+ *  mappings it contains like @ref glfwUpdateGamepadMappings, without reading
+ *  it into a string first.  The file may be the unmodified
+ *  `gamecontrollerdb.txt` and does not need to be null terminated.
+ *
+ *  See @ref gamepad_mapping for a description of the format.
+ *
+ *  If there is already a gamepad mapping for a given GUID in the internal list,
+ *  it will be replaced by the one in the file.  If the library is terminated
+ *  and re-initialized the internal list will revert to the built-in default.
+ *
+ *  @param[in] path The UTF-8 encoded path of the file containing the gamepad
+ *  mappings.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE, @ref GLFW_OUT_OF_MEMORY and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark If the file cannot be opened or mapped, this function emits @ref
+ *  GLFW_PLATFORM_ERROR and no mappings are added.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref gamepad
+ *  @sa @ref glfwUpdateGamepadMappings
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwLoadGamepadMappingsFile(const char* path);
+
 /*! @brief Returns the human-readable gamepad name for the specified joystick.
  *
  *  This function returns the human-readable name of the gamepad from the
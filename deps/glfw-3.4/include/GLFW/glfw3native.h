@@ -442,6 +442,29 @@ GLFWAPI void glfwSetX11SelectionString(const char* string);
  *  @ingroup native
  */
 GLFWAPI const char* glfwGetX11SelectionString(void);
+
+/*! @brief Returns the number of synchronous requests GLFW has made.
+ *
+ *  This function returns the number of calls GLFW has made to Xlib functions
+ *  that wait for a reply from the X server, such as `XGetWindowProperty` and
+ *  `XQueryPointer`, since it was initialized.  Each of these is a round trip
+ *  to the server, which over a remote connection costs its latency.  The
+ *  difference between two calls shows what a frame or an operation costs.
+ *
+ *  @return The number of round trips made, or zero if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_UNAVAILABLE.
+ *
+ *  @thread_safety This function may be called from any thread.  Access is not
+ *  synchronized.
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI unsigned long glfwGetX11RoundTripCount(void);
 #endif
 
 #if defined(GLFW_EXPOSE_NATIVE_GLX)
@@ -50,6 +50,9 @@ static GLFWallocator _glfwInitAllocator;
 static _GLFWinitconfig _glfwInitHints =
 {
     .hatButtons = GLFW_TRUE,
+    .eventQueue = GLFW_FALSE,
+    .joystickThread = GLFW_FALSE,
+    .joystickSamples = 0,
     .angleType = GLFW_ANGLE_PLATFORM_TYPE_NONE,
     .platformID = GLFW_ANY_PLATFORM,
     .vulkanLoader = NULL,
@@ -61,6 +64,9 @@ static _GLFWinitconfig _glfwInitHints =
     .x11 =
     {
         .xcbVulkanSurface = GLFW_TRUE,
+        .eventThread = GLFW_FALSE,
+        .cursorPosQuery = GLFW_FALSE,
+        .statistics = GLFW_FALSE,
     },
     .wl =
     {
@@ -118,6 +124,27 @@ static void terminate(void)
     _glfw_free(_glfw.mappings);
     _glfw.mappings = NULL;
     _glfw.mappingCount = 0;
+    _glfw.mappingCapacity = 0;
+    _glfw_free(_glfw.mappingIndex);
+    _glfw.mappingIndex = NULL;
+    _glfw.mappingIndexSize = 0;
+
+    _glfw_free(_glfw.eventQueue.events);
+    memset(&_glfw.eventQueue, 0, sizeof(_glfw.eventQueue));
+
+    while (_glfw.userEvents.tail)
+    {
+        _GLFWuserevent* event = _glfw.userEvents.tail;
+        _glfw.userEvents.tail = event->next;
+        if (event != &_glfw.userEvents.stub)
+            _glfw_free(event);
+    }
+
+    memset(&_glfw.userEvents, 0, sizeof(_glfw.userEvents));
+
+#if defined(GLFW_BUILD_POSIX_POLL)
+    _glfwTerminateEventSourcesPOSIX();
+#endif
 
     _glfwTerminateVulkan();
     _glfw.platform.terminateJoysticks();
@@ -391,6 +418,11 @@ GLFWAPI int glfwInit(void)
     memset(&_glfw, 0, sizeof(_glfw));
     _glfw.hints.init = _glfwInitHints;
 
+#if defined(GLFW_BUILD_POSIX_POLL)
+    _glfwInitEventSourcesPOSIX();
+    _glfwInitWakeupPOSIX(&_glfw.posixWakeup);
+#endif
+
     _glfw.allocator = _glfwInitAllocator;
     if (!_glfw.allocator.allocate)
     {
@@ -418,11 +450,12 @@ GLFWAPI int glfwInit(void)
 
     _glfwPlatformSetTls(&_glfw.errorSlot, &_glfwMainThreadError);
 
-    _glfwInitGamepadMappings();
-
     _glfwPlatformInitTimer();
     _glfw.timer.offset = _glfwPlatformGetTimerValue();
 
+    _glfw.userEvents.head = &_glfw.userEvents.stub;
+    _glfw.userEvents.tail = &_glfw.userEvents.stub;
+
     _glfw.initialized = GLFW_TRUE;
 
     glfwDefaultWindowHints();
@@ -447,6 +480,15 @@ GLFWAPI void glfwInitHint(int hint, int value)
         case GLFW_ANGLE_PLATFORM_TYPE:
             _glfwInitHints.angleType = value;
             return;
+        case GLFW_EVENT_QUEUE_DEFAULT:
+            _glfwInitHints.eventQueue = value ? GLFW_TRUE : GLFW_FALSE;
+            return;
+        case GLFW_JOYSTICK_THREAD:
+            _glfwInitHints.joystickThread = value ? GLFW_TRUE : GLFW_FALSE;
+            return;
+        case GLFW_JOYSTICK_SAMPLES:
+            _glfwInitHints.joystickSamples = _glfw_max(value, 0);
+            return;
         case GLFW_PLATFORM:
             _glfwInitHints.platformID = value;
             return;
@@ -459,6 +501,15 @@ GLFWAPI void glfwInitHint(int hint, int value)
         case GLFW_X11_XCB_VULKAN_SURFACE:
             _glfwInitHints.x11.xcbVulkanSurface = value;
             return;
+        case GLFW_X11_EVENT_THREAD:
+            _glfwInitHints.x11.eventThread = value ? GLFW_TRUE : GLFW_FALSE;
+            return;
+        case GLFW_X11_CURSOR_POS_QUERY:
+            _glfwInitHints.x11.cursorPosQuery = value ? GLFW_TRUE : GLFW_FALSE;
+            return;
+        case GLFW_X11_STATISTICS:
+            _glfwInitHints.x11.statistics = value ? GLFW_TRUE : GLFW_FALSE;
+            return;
         case GLFW_WAYLAND_LIBDECOR:
             _glfwInitHints.wl.libdecorMode = value;
             return;
@@ -26,7 +26,7 @@
 //========================================================================
 
 #include "internal.h"
-#include "mappings.h"
+#include "mapping_table.h"
 
 #include <assert.h>
 #include <float.h>
@@ -65,21 +65,142 @@ static GLFWbool initJoysticks(void)
     return _glfw.joysticksInitialized = GLFW_TRUE;
 }
 
-// Finds a mapping based on joystick GUID
+// Returns the FNV-1a hash of a joystick GUID string
 //
-static _GLFWmapping* findMapping(const char* guid)
+static uint32_t hashGUID(const char* guid)
 {
-    int i;
+    uint32_t hash = 2166136261u;
 
-    for (i = 0;  i < _glfw.mappingCount;  i++)
+    while (*guid)
     {
-        if (strcmp(_glfw.mappings[i].guid, guid) == 0)
-            return _glfw.mappings + i;
+        hash ^= (unsigned char) *guid++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+// Returns the mapping index slot of the specified GUID, either the one holding
+// its mapping or the empty slot where it belongs
+//
+static int* findMappingSlot(const char* guid)
+{
+    const int mask = _glfw.mappingIndexSize - 1;
+    int slot = (int) (hashGUID(guid) & (uint32_t) mask);
+
+    while (_glfw.mappingIndex[slot])
+    {
+        const _GLFWmapping* mapping = _glfw.mappings + _glfw.mappingIndex[slot] - 1;
+        if (strcmp(mapping->guid, guid) == 0)
+            break;
+
+        slot = (slot + 1) & mask;
+    }
+
+    return _glfw.mappingIndex + slot;
+}
+
+// Adds the last mapping to the index, growing it to keep it at most half full.
+// If the index cannot grow it is dropped until the next mapping is added, and
+// mappings are looked up with a linear search meanwhile
+//
+static void indexLastMapping(void)
+{
+    int* slot;
+
+    if (_glfw.mappingCount * 2 > _glfw.mappingIndexSize)
+    {
+        int i;
+        const int size = _glfw_max(64, _glfw.mappingIndexSize * 2);
+        int* index = _glfw_calloc(size, sizeof(int));
+        if (!index)
+        {
+            _glfw_free(_glfw.mappingIndex);
+            _glfw.mappingIndex = NULL;
+            _glfw.mappingIndexSize = 0;
+            return;
+        }
+
+        _glfw_free(_glfw.mappingIndex);
+        _glfw.mappingIndex = index;
+        _glfw.mappingIndexSize = size;
+
+        for (i = 0;  i < _glfw.mappingCount - 1;  i++)
+        {
+            slot = findMappingSlot(_glfw.mappings[i].guid);
+            if (!*slot)
+                *slot = i + 1;
+        }
+    }
+
+    slot = findMappingSlot(_glfw.mappings[_glfw.mappingCount - 1].guid);
+    if (!*slot)
+        *slot = _glfw.mappingCount;
+}
+
+// Finds a mapping added with glfwUpdateGamepadMappings based on joystick GUID
+//
+static _GLFWmapping* findUserMapping(const char* guid)
+{
+    const int* slot;
+
+    if (!_glfw.mappingIndexSize)
+    {
+        int i;
+
+        for (i = 0;  i < _glfw.mappingCount;  i++)
+        {
+            if (strcmp(_glfw.mappings[i].guid, guid) == 0)
+                return _glfw.mappings + i;
+        }
+
+        return NULL;
+    }
+
+    slot = findMappingSlot(guid);
+    if (!*slot)
+        return NULL;
+
+    return _glfw.mappings + *slot - 1;
+}
+
+// Finds a built-in mapping based on joystick GUID with a binary search of the
+// table generated from mappings.h
+//
+static const _GLFWmapping* findDefaultMapping(const char* guid)
+{
+    size_t first = 0;
+    size_t last = sizeof(_glfwDefaultMappingTable) /
+                  sizeof(_glfwDefaultMappingTable[0]) - 1;
+
+    while (first < last)
+    {
+        const size_t middle = first + (last - first) / 2;
+        const int order = strcmp(_glfwDefaultMappingTable[middle].guid, guid);
+
+        if (order == 0)
+            return _glfwDefaultMappingTable + middle;
+        else if (order < 0)
+            first = middle + 1;
+        else
+            last = middle;
     }
 
     return NULL;
 }
 
+// Finds a mapping based on joystick GUID, preferring mappings added with
+// glfwUpdateGamepadMappings over the built-in ones
+//
+static const _GLFWmapping* findMapping(const char* guid)
+{
+    const _GLFWmapping* mapping = findUserMapping(guid);
+    if (mapping)
+        return mapping;
+
+    return findDefaultMapping(guid);
+}
+
 // Checks whether a gamepad mapping element is present in the hardware
 //
 static GLFWbool isValidElementForJoystick(const _GLFWmapelement* e,
@@ -97,9 +218,9 @@ static GLFWbool isValidElementForJoystick(const _GLFWmapelement* e,
 
 // Finds a mapping based on joystick GUID and verifies element indices
 //
-static _GLFWmapping* findValidMapping(const _GLFWjoystick* js)
+static const _GLFWmapping* findValidMapping(const _GLFWjoystick* js)
 {
-    _GLFWmapping* mapping = findMapping(js->guid);
+    const _GLFWmapping* mapping = findMapping(js->guid);
     if (mapping)
     {
         int i;
@@ -120,11 +241,152 @@ static _GLFWmapping* findValidMapping(const _GLFWjoystick* js)
     return mapping;
 }
 
-// Parses an SDL_GameControllerDB line and adds it to the mapping list
+// Adds the gather of a gamepad output to the compiled mapping
 //
-static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
+static void addRemapSource(_GLFWremap* remap, int* count,
+                           int output, const _GLFWmapelement* e)
+{
+    remap->outputs[*count] = (uint8_t) output;
+    remap->indices[*count] = e->type == _GLFW_JOYSTICK_HATBIT ? e->index >> 4 : e->index;
+    remap->bits[*count] = e->index & 0xf;
+    (*count)++;
+}
+
+// Compiles the gamepad mapping of the specified joystick into its remap tables
+//
+static void compileMapping(_GLFWjoystick* js)
+{
+    int i, type, count = 0;
+    _GLFWremap* remap = &js->remap;
+
+    memset(remap, 0, sizeof(_GLFWremap));
+
+    // Unmapped buttons are released and unmapped axes centered
+    for (i = 0;  i <= GLFW_GAMEPAD_BUTTON_LAST;  i++)
+        remap->offset[i] = -1.f;
+
+    if (!js->mapping)
+        return;
+
+    for (i = 0;  i <= GLFW_GAMEPAD_BUTTON_LAST;  i++)
+    {
+        const _GLFWmapelement* e = js->mapping->buttons + i;
+        if (e->type == _GLFW_JOYSTICK_AXIS)
+        {
+            // Buttons pressed by negative values get a negated scale and offset
+            if (e->axisOffset < 0 || (e->axisOffset == 0 && e->axisScale > 0))
+            {
+                remap->scale[i] = e->axisScale;
+                remap->offset[i] = e->axisOffset;
+            }
+            else
+            {
+                // Pressed when the value is not positive
+                remap->scale[i] = -e->axisScale;
+                remap->offset[i] = -e->axisOffset;
+            }
+        }
+        else if (e->type == _GLFW_JOYSTICK_BUTTON || e->type == _GLFW_JOYSTICK_HATBIT)
+        {
+            // Pressed when the gathered state is one
+            remap->scale[i] = 1.f;
+            remap->offset[i] = -0.5f;
+        }
+    }
+
+    for (i = 0;  i <= GLFW_GAMEPAD_AXIS_LAST;  i++)
+    {
+        const _GLFWmapelement* e = js->mapping->axes + i;
+        const int output = GLFW_GAMEPAD_BUTTON_LAST + 1 + i;
+        if (e->type == _GLFW_JOYSTICK_AXIS)
+        {
+            remap->scale[output] = e->axisScale;
+            remap->offset[output] = e->axisOffset;
+        }
+        else if (e->type == _GLFW_JOYSTICK_BUTTON || e->type == _GLFW_JOYSTICK_HATBIT)
+        {
+            // Maps a gathered state of zero or one to -1 or 1
+            remap->scale[output] = 2.f;
+            remap->offset[output] = -1.f;
+        }
+    }
+
+    // Group the gathers by input type so each group is a branchless loop
+    for (type = _GLFW_JOYSTICK_AXIS;  type <= _GLFW_JOYSTICK_HATBIT;  type++)
+    {
+        const int first = count;
+
+        for (i = 0;  i <= GLFW_GAMEPAD_BUTTON_LAST;  i++)
+        {
+            if (js->mapping->buttons[i].type == type)
+                addRemapSource(remap, &count, i, js->mapping->buttons + i);
+        }
+
+        for (i = 0;  i <= GLFW_GAMEPAD_AXIS_LAST;  i++)
+        {
+            if (js->mapping->axes[i].type == type)
+            {
+                addRemapSource(remap, &count, GLFW_GAMEPAD_BUTTON_LAST + 1 + i,
+                               js->mapping->axes + i);
+            }
+        }
+
+        if (type == _GLFW_JOYSTICK_AXIS)
+            remap->axisSources = count - first;
+        else if (type == _GLFW_JOYSTICK_BUTTON)
+            remap->buttonSources = count - first;
+        else
+            remap->hatSources = count - first;
+    }
+}
+
+// Finds a valid mapping for the specified joystick and compiles it
+//
+static void bindMapping(_GLFWjoystick* js)
+{
+    js->mapping = findValidMapping(js);
+    compileMapping(js);
+}
+
+// Returns the length of the mapping field at c, ending at a comma or the end
+// of the line
+//
+static size_t fieldLength(const char* c, const char* end)
+{
+    const char* comma = memchr(c, ',', end - c);
+    if (comma)
+        return comma - c;
+
+    return end - c;
+}
+
+// Parses the decimal digits at c up to end and moves c past them
+//
+// Unlike strtoul this skips no leading whitespace, which could be the line
+// break and the start of the next line.
+//
+static unsigned long parseIndex(const char** c, const char* end)
+{
+    unsigned long value = 0;
+
+    while (*c < end && **c >= '0' && **c <= '9')
+    {
+        value = value * 10 + (unsigned long) (**c - '0');
+        *c += 1;
+    }
+
+    return value;
+}
+
+// Parses an SDL_GameControllerDB line in place, without copying it
+//
+// The line ends at end, which must point to a readable line break or
+// terminating null character.  Every scan stops at that character, so a line
+// in a larger buffer needs no terminator of its own.
+//
+static GLFWbool parseMapping(_GLFWmapping* mapping,
+                             const char* c, const char* end)
 {
-    const char* c = string;
     size_t i, length;
     struct
     {
@@ -156,8 +418,8 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
         { "righty",        mapping->axes + GLFW_GAMEPAD_AXIS_RIGHT_Y }
     };
 
-    length = strcspn(c, ",");
-    if (length != 32 || c[length] != ',')
+    length = fieldLength(c, end);
+    if (length != 32 || c + length == end)
     {
         _glfwInputError(GLFW_INVALID_VALUE, NULL);
         return GLFW_FALSE;
@@ -166,8 +428,8 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
     memcpy(mapping->guid, c, length);
     c += length + 1;
 
-    length = strcspn(c, ",");
-    if (length >= sizeof(mapping->name) || c[length] != ',')
+    length = fieldLength(c, end);
+    if (length >= sizeof(mapping->name) || c + length == end)
     {
         _glfwInputError(GLFW_INVALID_VALUE, NULL);
         return GLFW_FALSE;
@@ -176,7 +438,7 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
     memcpy(mapping->name, c, length);
     c += length + 1;
 
-    while (*c)
+    while (c < end)
     {
         // TODO: Implement output modifiers
         if (*c == '+' || *c == '-')
@@ -184,9 +446,17 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
 
         for (i = 0;  i < sizeof(fields) / sizeof(fields[0]);  i++)
         {
+            // Most names differ in the first character, which is much cheaper
+            // to check than the whole name for every field of every line
+            if (*c != fields[i].name[0])
+                continue;
+
             length = strlen(fields[i].name);
-            if (strncmp(c, fields[i].name, length) != 0 || c[length] != ':')
+            if ((size_t) (end - c) <= length ||
+                memcmp(c, fields[i].name, length) != 0 || c[length] != ':')
+            {
                 continue;
+            }
 
             c += length + 1;
 
@@ -216,14 +486,21 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
                 else
                     break;
 
+                c += 1;
+
                 if (e->type == _GLFW_JOYSTICK_HATBIT)
                 {
-                    const unsigned long hat = strtoul(c + 1, (char**) &c, 10);
-                    const unsigned long bit = strtoul(c + 1, (char**) &c, 10);
+                    const unsigned long hat = parseIndex(&c, end);
+                    unsigned long bit = 0;
+                    if (c < end)
+                    {
+                        c += 1;
+                        bit = parseIndex(&c, end);
+                    }
                     e->index = (uint8_t) ((hat << 4) | bit);
                 }
                 else
-                    e->index = (uint8_t) strtoul(c + 1, (char**) &c, 10);
+                    e->index = (uint8_t) parseIndex(&c, end);
 
                 if (e->type == _GLFW_JOYSTICK_AXIS)
                 {
@@ -241,15 +518,16 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
             {
                 const char* name = _glfw.platform.getMappingName();
                 length = strlen(name);
-                if (strncmp(c, name, length) != 0)
+                if ((size_t) (end - c) < length || memcmp(c, name, length) != 0)
                     return GLFW_FALSE;
             }
 
             break;
         }
 
-        c += strcspn(c, ",");
-        c += strspn(c, ",");
+        c += fieldLength(c, end);
+        while (c < end && *c == ',')
+            c++;
     }
 
     for (i = 0;  i < 32;  i++)
@@ -262,6 +540,142 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
     return GLFW_TRUE;
 }
 
+// Adds a parsed mapping or replaces the one with the same GUID, growing the
+// mapping array geometrically
+//
+static GLFWbool addMapping(const _GLFWmapping* mapping)
+{
+    _GLFWmapping* previous = findUserMapping(mapping->guid);
+    if (previous)
+    {
+        *previous = *mapping;
+        return GLFW_TRUE;
+    }
+
+    if (_glfw.mappingCount == _glfw.mappingCapacity)
+    {
+        const int capacity = _glfw_max(64, _glfw.mappingCapacity * 2);
+        _GLFWmapping* mappings =
+            _glfw_realloc(_glfw.mappings, sizeof(_GLFWmapping) * capacity);
+        if (!mappings)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return GLFW_FALSE;
+        }
+
+        _glfw.mappings = mappings;
+        _glfw.mappingCapacity = capacity;
+    }
+
+    _glfw.mappings[_glfw.mappingCount++] = *mapping;
+    indexLastMapping();
+    return GLFW_TRUE;
+}
+
+// Parses and adds every mapping line in the specified text, which ends at end
+// with a readable line break or terminating null character
+//
+static GLFWbool addMappings(const char* c, const char* end)
+{
+    int jid;
+    GLFWbool result = GLFW_TRUE;
+
+    while (result && c < end)
+    {
+        const char* line = c;
+        const char* lineEnd = c;
+
+        while (lineEnd < end && *lineEnd != '\r' && *lineEnd != '\n')
+            lineEnd++;
+
+        if ((*c >= '0' && *c <= '9') ||
+            (*c >= 'a' && *c <= 'f') ||
+            (*c >= 'A' && *c <= 'F'))
+        {
+            _GLFWmapping mapping = {{0}};
+
+            if (parseMapping(&mapping, line, lineEnd))
+            {
+                result = addMapping(&mapping);
+            }
+        }
+
+        c = lineEnd;
+        while (c < end && (*c == '\r' || *c == '\n'))
+            c++;
+    }
+
+    // NOTE: This is done even if a mapping could not be added, as the mapping
+    //       array may have moved before that
+    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        _GLFWjoystick* js = _glfw.joysticks + jid;
+        if (js->connected)
+            bindMapping(js);
+    }
+
+    return result;
+}
+
+
+// Returns the time of the event being reported in the timebase of
+// glfwGetTimerValue
+//
+static uint64_t getEventTime(void)
+{
+    if (_glfw.eventTime)
+        return _glfw.eventTime;
+
+    return _glfwPlatformGetTimerValue();
+}
+
+// Reports a cursor position event with the motion since the previous one
+//
+static void reportCursorPos(_GLFWwindow* window, double xpos, double ypos,
+                            double xdelta, double ydelta)
+{
+    window->cursorDeltaX = xdelta;
+    window->cursorDeltaY = ydelta;
+
+    if (window->eventQueue)
+    {
+        GLFWevent* event = _glfwPushEvent(window, GLFW_EVENT_CURSOR_POS);
+        if (event)
+        {
+            event->data.cursorPos.xpos = xpos;
+            event->data.cursorPos.ypos = ypos;
+            event->data.cursorPos.xdelta = xdelta;
+            event->data.cursorPos.ydelta = ydelta;
+        }
+    }
+    else if (window->callbacks.cursorPos)
+        window->callbacks.cursorPos((GLFWwindow*) window, xpos, ypos);
+}
+
+// Reports the merged cursor motion of the window, if any
+// This is called before every other input event of the window to keep the
+// order of events
+//
+static void flushCursorMotion(_GLFWwindow* window)
+{
+    double xdelta, ydelta;
+
+    if (!window->cursorMotionPending)
+        return;
+
+    xdelta = window->cursorMotionX;
+    ydelta = window->cursorMotionY;
+    window->cursorMotionX = 0.0;
+    window->cursorMotionY = 0.0;
+    window->cursorMotionPending = GLFW_FALSE;
+
+    _glfw.lastEventTime = window->cursorMotionTime;
+
+    reportCursorPos(window,
+                    window->virtualCursorPosX, window->virtualCursorPosY,
+                    xdelta, ydelta);
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
@@ -277,6 +691,8 @@ void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int m
     assert(action == GLFW_PRESS || action == GLFW_RELEASE);
     assert(mods == (mods & GLFW_MOD_MASK));
 
+    flushCursorMotion(window);
+
     if (key >= 0 && key <= GLFW_KEY_LAST)
     {
         GLFWbool repeated = GLFW_FALSE;
@@ -287,6 +703,12 @@ void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int m
         if (action == GLFW_PRESS && window->keys[key] == GLFW_PRESS)
             repeated = GLFW_TRUE;
 
+        // A sticky release is not reported until the key is polled
+        if (action == GLFW_PRESS && window->keys[key] == GLFW_RELEASE)
+            window->toggledKeys[key / 32] |= 1u << (key % 32);
+        else if (action == GLFW_RELEASE && !window->stickyKeys)
+            window->toggledKeys[key / 32] |= 1u << (key % 32);
+
         if (action == GLFW_RELEASE && window->stickyKeys)
             window->keys[key] = _GLFW_STICK;
         else
@@ -296,10 +718,23 @@ void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int m
             action = GLFW_REPEAT;
     }
 
+    _glfw.lastEventTime = getEventTime();
+
     if (!window->lockKeyMods)
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
-    if (window->callbacks.key)
+    if (window->eventQueue)
+    {
+        GLFWevent* event = _glfwPushEvent(window, GLFW_EVENT_KEY);
+        if (event)
+        {
+            event->data.key.key = key;
+            event->data.key.scancode = scancode;
+            event->data.key.action = action;
+            event->data.key.mods = mods;
+        }
+    }
+    else if (window->callbacks.key)
         window->callbacks.key((GLFWwindow*) window, key, scancode, action, mods);
 }
 
@@ -315,9 +750,29 @@ void _glfwInputChar(_GLFWwindow* window, uint32_t codepoint, int mods, GLFWbool
     if (codepoint < 32 || (codepoint > 126 && codepoint < 160))
         return;
 
+    flushCursorMotion(window);
+
+    _glfw.lastEventTime = getEventTime();
+
     if (!window->lockKeyMods)
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
+    if (window->eventQueue)
+    {
+        // Only plain text is queued, matching the character callback
+        if (plain)
+        {
+            GLFWevent* event = _glfwPushEvent(window, GLFW_EVENT_CHAR);
+            if (event)
+            {
+                event->data.character.codepoint = codepoint;
+                event->data.character.mods = mods;
+            }
+        }
+
+        return;
+    }
+
     if (window->callbacks.charmods)
         window->callbacks.charmods((GLFWwindow*) window, codepoint, mods);
 
@@ -338,7 +793,20 @@ void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset)
     assert(yoffset > -FLT_MAX);
     assert(yoffset < FLT_MAX);
 
-    if (window->callbacks.scroll)
+    flushCursorMotion(window);
+
+    _glfw.lastEventTime = getEventTime();
+
+    if (window->eventQueue)
+    {
+        GLFWevent* event = _glfwPushEvent(window, GLFW_EVENT_SCROLL);
+        if (event)
+        {
+            event->data.scroll.xoffset = xoffset;
+            event->data.scroll.yoffset = yoffset;
+        }
+    }
+    else if (window->callbacks.scroll)
         window->callbacks.scroll((GLFWwindow*) window, xoffset, yoffset);
 }
 
@@ -355,15 +823,37 @@ void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods)
     if (button < 0 || button > GLFW_MOUSE_BUTTON_LAST)
         return;
 
+    flushCursorMotion(window);
+
     if (!window->lockKeyMods)
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
+    // A sticky release is not reported until the button is polled
+    if ((action == GLFW_PRESS && window->mouseButtons[button] == GLFW_RELEASE) ||
+        (action == GLFW_RELEASE && window->mouseButtons[button] == GLFW_PRESS &&
+         !window->stickyMouseButtons))
+    {
+        window->toggledMouseButtons |= 1u << button;
+    }
+
     if (action == GLFW_RELEASE && window->stickyMouseButtons)
         window->mouseButtons[button] = _GLFW_STICK;
     else
         window->mouseButtons[button] = (char) action;
 
-    if (window->callbacks.mouseButton)
+    _glfw.lastEventTime = getEventTime();
+
+    if (window->eventQueue)
+    {
+        GLFWevent* event = _glfwPushEvent(window, GLFW_EVENT_MOUSE_BUTTON);
+        if (event)
+        {
+            event->data.mouseButton.button = button;
+            event->data.mouseButton.action = action;
+            event->data.mouseButton.mods = mods;
+        }
+    }
+    else if (window->callbacks.mouseButton)
         window->callbacks.mouseButton((GLFWwindow*) window, button, action, mods);
 }
 
@@ -372,6 +862,8 @@ void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods)
 //
 void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos)
 {
+    double xdelta, ydelta;
+
     assert(window != NULL);
     assert(xpos > -FLT_MAX);
     assert(xpos < FLT_MAX);
@@ -381,11 +873,40 @@ void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos)
     if (window->virtualCursorPosX == xpos && window->virtualCursorPosY == ypos)
         return;
 
+    xdelta = xpos - window->virtualCursorPosX;
+    ydelta = ypos - window->virtualCursorPosY;
+
     window->virtualCursorPosX = xpos;
     window->virtualCursorPosY = ypos;
 
-    if (window->callbacks.cursorPos)
-        window->callbacks.cursorPos((GLFWwindow*) window, xpos, ypos);
+    _glfw.lastEventTime = getEventTime();
+
+    if (window->coalesceCursor)
+    {
+        // NOTE: Path samples are only queued for windows that retrieve their
+        //       events, as nothing else would ever remove them from the queue
+        if (window->cursorPath && window->eventQueue)
+        {
+            GLFWevent* event = _glfwPushEvent(window, GLFW_EVENT_CURSOR_PATH);
+            if (event)
+            {
+                event->data.cursorPos.xpos = xpos;
+                event->data.cursorPos.ypos = ypos;
+                event->data.cursorPos.xdelta = xdelta;
+                event->data.cursorPos.ydelta = ydelta;
+            }
+        }
+
+        // The motion is reported by flushCursorMotion
+        window->cursorMotionX += xdelta;
+        window->cursorMotionY += ydelta;
+        window->cursorMotionTime = _glfw.lastEventTime;
+        window->cursorMotionPending = GLFW_TRUE;
+        _glfw.cursorMotionPending = GLFW_TRUE;
+        return;
+    }
+
+    reportCursorPos(window, xpos, ypos, xdelta, ydelta);
 }
 
 // Notifies shared code of a cursor enter/leave event
@@ -395,7 +916,17 @@ void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered)
     assert(window != NULL);
     assert(entered == GLFW_TRUE || entered == GLFW_FALSE);
 
-    if (window->callbacks.cursorEnter)
+    flushCursorMotion(window);
+
+    _glfw.lastEventTime = getEventTime();
+
+    if (window->eventQueue)
+    {
+        GLFWevent* event = _glfwPushEvent(window, GLFW_EVENT_CURSOR_ENTER);
+        if (event)
+            event->data.cursorEnter.entered = entered;
+    }
+    else if (window->callbacks.cursorEnter)
         window->callbacks.cursorEnter((GLFWwindow*) window, entered);
 }
 
@@ -435,6 +966,14 @@ void _glfwInputJoystickAxis(_GLFWjoystick* js, int axis, float value)
     assert(axis >= 0);
     assert(axis < js->axisCount);
 
+    js->eventTime = getEventTime();
+
+    if (js->axes[axis] != value && !js->platformSamples)
+    {
+        _glfwInputJoystickSample(js, GLFW_JOYSTICK_SAMPLE_AXIS, axis,
+                                 value, 0, js->eventTime);
+    }
+
     js->axes[axis] = value;
 }
 
@@ -447,6 +986,14 @@ void _glfwInputJoystickButton(_GLFWjoystick* js, int button, char value)
     assert(button < js->buttonCount);
     assert(value == GLFW_PRESS || value == GLFW_RELEASE);
 
+    js->eventTime = getEventTime();
+
+    if (js->buttons[button] != value && !js->platformSamples)
+    {
+        _glfwInputJoystickSample(js, GLFW_JOYSTICK_SAMPLE_BUTTON, button,
+                                 0.f, value, js->eventTime);
+    }
+
     js->buttons[button] = value;
 }
 
@@ -473,29 +1020,48 @@ void _glfwInputJoystickHat(_GLFWjoystick* js, int hat, char value)
     js->buttons[base + 2] = (value & 0x04) ? GLFW_PRESS : GLFW_RELEASE;
     js->buttons[base + 3] = (value & 0x08) ? GLFW_PRESS : GLFW_RELEASE;
 
-    js->hats[hat] = value;
-}
+    js->eventTime = getEventTime();
 
+    if (js->hats[hat] != value && !js->platformSamples)
+    {
+        _glfwInputJoystickSample(js, GLFW_JOYSTICK_SAMPLE_HAT, hat,
+                                 0.f, value, js->eventTime);
+    }
 
-//////////////////////////////////////////////////////////////////////////
-//////                       GLFW internal API                      //////
-//////////////////////////////////////////////////////////////////////////
+    js->hats[hat] = value;
+}
 
-// Adds the built-in set of gamepad mappings
+// Appends a joystick state change to the history of the specified joystick,
+// discarding it if the history is full
 //
-void _glfwInitGamepadMappings(void)
+void _glfwInputJoystickSample(_GLFWjoystick* js, int type, int index,
+                              float axis, int state, uint64_t time)
 {
-    size_t i;
-    const size_t count = sizeof(_glfwDefaultMappings) / sizeof(char*);
-    _glfw.mappings = _glfw_calloc(count, sizeof(_GLFWmapping));
+    GLFWjoysticksample* sample;
 
-    for (i = 0;  i < count;  i++)
-    {
-        if (parseMapping(&_glfw.mappings[_glfw.mappingCount], _glfwDefaultMappings[i]))
-            _glfw.mappingCount++;
-    }
+    assert(js != NULL);
+    assert(type == GLFW_JOYSTICK_SAMPLE_AXIS ||
+           type == GLFW_JOYSTICK_SAMPLE_BUTTON ||
+           type == GLFW_JOYSTICK_SAMPLE_HAT);
+
+    if (js->sampleCount == js->sampleCapacity)
+        return;
+
+    sample = js->samples +
+        (js->sampleFirst + js->sampleCount) % js->sampleCapacity;
+    sample->time = time;
+    sample->type = type;
+    sample->index = index;
+    sample->axis = axis;
+    sample->state = state;
+    js->sampleCount++;
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
 // Returns an available joystick object with arrays and name allocated
 //
 _GLFWjoystick* _glfwAllocJoystick(const char* name,
@@ -525,9 +1091,17 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
     js->buttonCount = buttonCount;
     js->hatCount    = hatCount;
 
+    if (_glfw.hints.init.joystickSamples)
+    {
+        js->samples = _glfw_calloc(_glfw.hints.init.joystickSamples,
+                                   sizeof(GLFWjoysticksample));
+        if (js->samples)
+            js->sampleCapacity = _glfw.hints.init.joystickSamples;
+    }
+
     strncpy(js->name, name, sizeof(js->name) - 1);
     strncpy(js->guid, guid, sizeof(js->guid) - 1);
-    js->mapping = findValidMapping(js);
+    bindMapping(js);
 
     return js;
 }
@@ -539,6 +1113,7 @@ void _glfwFreeJoystick(_GLFWjoystick* js)
     _glfw_free(js->axes);
     _glfw_free(js->buttons);
     _glfw_free(js->hats);
+    _glfw_free(js->samples);
     memset(js, 0, sizeof(_GLFWjoystick));
 }
 
@@ -552,6 +1127,89 @@ void _glfwCenterCursorInContentArea(_GLFWwindow* window)
     _glfw.platform.setCursorPos(window, width / 2.0, height / 2.0);
 }
 
+// Appends an event to the event queue, growing it as needed, and returns it
+// with its type, window and time set, or NULL and an error if the queue could
+// not grow.  The caller fills in the data.
+//
+GLFWevent* _glfwPushEvent(_GLFWwindow* window, int type)
+{
+    GLFWevent* event;
+
+    if (_glfw.eventQueue.first + _glfw.eventQueue.count ==
+        _glfw.eventQueue.capacity)
+    {
+        if (_glfw.eventQueue.first > 0)
+        {
+            // Reclaim the space of already retrieved events first
+            memmove(_glfw.eventQueue.events,
+                    _glfw.eventQueue.events + _glfw.eventQueue.first,
+                    _glfw.eventQueue.count * sizeof(GLFWevent));
+            _glfw.eventQueue.first = 0;
+        }
+        else
+        {
+            const int capacity = _glfw_max(64, _glfw.eventQueue.capacity * 2);
+            GLFWevent* events = _glfw_realloc(_glfw.eventQueue.events,
+                                              capacity * sizeof(GLFWevent));
+            if (!events)
+            {
+                _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+                return NULL;
+            }
+
+            _glfw.eventQueue.events = events;
+            _glfw.eventQueue.capacity = capacity;
+        }
+    }
+
+    event = _glfw.eventQueue.events +
+            _glfw.eventQueue.first + _glfw.eventQueue.count;
+    _glfw.eventQueue.count++;
+
+    event->type = type;
+    event->window = (GLFWwindow*) window;
+    event->time = _glfw.lastEventTime;
+    return event;
+}
+
+// Removes the queued events of the specified window, keeping the order of
+// the remaining events
+//
+void _glfwRemoveEvents(_GLFWwindow* window)
+{
+    int i, count = 0;
+    GLFWevent* events = _glfw.eventQueue.events + _glfw.eventQueue.first;
+
+    for (i = 0;  i < _glfw.eventQueue.count;  i++)
+    {
+        if (events[i].window != (GLFWwindow*) window)
+            events[count++] = events[i];
+    }
+
+    _glfw.eventQueue.count = count;
+}
+
+// Reports the merged cursor motion of every window, at the end of event
+// processing
+//
+void _glfwFlushCursorMotion(void)
+{
+    _GLFWwindow* window;
+
+    if (!_glfw.cursorMotionPending)
+        return;
+
+    _glfw.cursorMotionPending = GLFW_FALSE;
+
+    window = _glfw.windowListHead;
+    while (window)
+    {
+        _GLFWwindow* next = window->next;
+        flushCursorMotion(window);
+        window = next;
+    }
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                        GLFW public API                       //////
@@ -576,6 +1234,12 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* handle, int mode)
             return window->lockKeyMods;
         case GLFW_RAW_MOUSE_MOTION:
             return window->rawMouseMotion;
+        case GLFW_EVENT_QUEUE:
+            return window->eventQueue;
+        case GLFW_CURSOR_COALESCE:
+            return window->coalesceCursor;
+        case GLFW_CURSOR_PATH:
+            return window->cursorPath;
     }
 
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid input mode 0x%08X", mode);
@@ -683,11 +1347,73 @@ GLFWAPI void glfwSetInputMode(GLFWwindow* handle, int mode, int value)
             _glfw.platform.setRawMouseMotion(window, value);
             return;
         }
+
+        case GLFW_EVENT_QUEUE:
+        {
+            window->eventQueue = value ? GLFW_TRUE : GLFW_FALSE;
+            return;
+        }
+
+        case GLFW_CURSOR_COALESCE:
+        {
+            value = value ? GLFW_TRUE : GLFW_FALSE;
+            if (window->coalesceCursor == value)
+                return;
+
+            if (!value)
+                flushCursorMotion(window);
+
+            window->coalesceCursor = value;
+            return;
+        }
+
+        case GLFW_CURSOR_PATH:
+        {
+            window->cursorPath = value ? GLFW_TRUE : GLFW_FALSE;
+            return;
+        }
     }
 
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid input mode 0x%08X", mode);
 }
 
+GLFWAPI int glfwGetEvents(GLFWevent* events, int capacity)
+{
+    int count;
+
+    assert(events != NULL);
+    assert(capacity >= 0);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    if (capacity < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid event capacity %i", capacity);
+        return 0;
+    }
+
+    count = _glfw_min(capacity, _glfw.eventQueue.count);
+    if (count == 0)
+        return 0;
+
+    memcpy(events,
+           _glfw.eventQueue.events + _glfw.eventQueue.first,
+           count * sizeof(GLFWevent));
+
+    _glfw.eventQueue.first += count;
+    _glfw.eventQueue.count -= count;
+    if (_glfw.eventQueue.count == 0)
+        _glfw.eventQueue.first = 0;
+
+    return count;
+}
+
+GLFWAPI uint64_t glfwGetEventTime(void)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+    return _glfw.lastEventTime;
+}
+
 GLFWAPI int glfwRawMouseMotionSupported(void)
 {
     _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
@@ -778,6 +1504,69 @@ GLFWAPI int glfwGetMouseButton(GLFWwindow* handle, int button)
     return (int) window->mouseButtons[button];
 }
 
+GLFWAPI void glfwGetInputSnapshot(GLFWwindow* handle, GLFWinputsnapshot* snapshot)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(snapshot != NULL);
+
+    memset(snapshot, 0, sizeof(GLFWinputsnapshot));
+
+    _GLFW_REQUIRE_INIT();
+
+    // Most keys are released, so skip them eight at a time, with the last
+    // group checked key by key as it may be shorter
+    for (int first = 0;  first <= GLFW_KEY_LAST;  first += 8)
+    {
+        const int last = first + 7 < GLFW_KEY_LAST ? first + 7 : GLFW_KEY_LAST;
+
+        if (last == first + 7)
+        {
+            uint64_t group;
+            memcpy(&group, window->keys + first, sizeof(group));
+            if (!group)
+                continue;
+        }
+
+        for (int key = first;  key <= last;  key++)
+        {
+            if (window->keys[key] == GLFW_RELEASE)
+                continue;
+
+            // Sticky mode: release key now
+            if (window->keys[key] == _GLFW_STICK)
+                window->keys[key] = GLFW_RELEASE;
+
+            snapshot->keys[key / 32] |= 1u << (key % 32);
+        }
+    }
+
+    for (int i = 0;  i < (GLFW_KEY_LAST + 32) / 32;  i++)
+    {
+        snapshot->keysChanged[i] = (snapshot->keys[i] ^ window->snapshotKeys[i]) |
+                                   window->toggledKeys[i];
+        window->snapshotKeys[i] = snapshot->keys[i];
+        window->toggledKeys[i] = 0;
+    }
+
+    for (int button = 0;  button <= GLFW_MOUSE_BUTTON_LAST;  button++)
+    {
+        if (window->mouseButtons[button] == GLFW_RELEASE)
+            continue;
+
+        // Sticky mode: release mouse button now
+        if (window->mouseButtons[button] == _GLFW_STICK)
+            window->mouseButtons[button] = GLFW_RELEASE;
+
+        snapshot->mouseButtons |= 1u << button;
+    }
+
+    snapshot->mouseButtonsChanged = (snapshot->mouseButtons ^ window->snapshotMouseButtons) |
+                                    window->toggledMouseButtons;
+    window->snapshotMouseButtons = snapshot->mouseButtons;
+    window->toggledMouseButtons = 0;
+}
+
 GLFWAPI void glfwGetCursorPos(GLFWwindow* handle, double* xpos, double* ypos)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
@@ -801,6 +1590,24 @@ GLFWAPI void glfwGetCursorPos(GLFWwindow* handle, double* xpos, double* ypos)
         _glfw.platform.getCursorPos(window, xpos, ypos);
 }
 
+GLFWAPI void glfwGetCursorDelta(GLFWwindow* handle, double* xdelta, double* ydelta)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (xdelta)
+        *xdelta = 0;
+    if (ydelta)
+        *ydelta = 0;
+
+    _GLFW_REQUIRE_INIT();
+
+    if (xdelta)
+        *xdelta = window->cursorDeltaX;
+    if (ydelta)
+        *ydelta = window->cursorDeltaY;
+}
+
 GLFWAPI void glfwSetCursorPos(GLFWwindow* handle, double xpos, double ypos)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
@@ -1208,6 +2015,84 @@ GLFWAPI const char* glfwGetJoystickGUID(int jid)
     return js->guid;
 }
 
+GLFWAPI uint64_t glfwGetJoystickEventTime(int jid)
+{
+    _GLFWjoystick* js;
+
+    assert(jid >= GLFW_JOYSTICK_1);
+    assert(jid <= GLFW_JOYSTICK_LAST);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
+        return 0;
+    }
+
+    if (!initJoysticks())
+        return 0;
+
+    js = _glfw.joysticks + jid;
+    if (!js->connected)
+        return 0;
+
+    if (!_glfw.platform.pollJoystick(js, _GLFW_POLL_PRESENCE))
+        return 0;
+
+    return js->eventTime;
+}
+
+GLFWAPI int glfwGetJoystickSamples(int jid, GLFWjoysticksample* samples, int capacity)
+{
+    int count, first;
+    _GLFWjoystick* js;
+
+    assert(jid >= GLFW_JOYSTICK_1);
+    assert(jid <= GLFW_JOYSTICK_LAST);
+    assert(samples != NULL);
+    assert(capacity >= 0);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
+        return 0;
+    }
+
+    if (capacity < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid sample capacity %i", capacity);
+        return 0;
+    }
+
+    if (!initJoysticks())
+        return 0;
+
+    js = _glfw.joysticks + jid;
+    if (!js->connected)
+        return 0;
+
+    if (!_glfw.platform.pollJoystick(js, _GLFW_POLL_ALL))
+        return 0;
+
+    count = _glfw_min(capacity, js->sampleCount);
+    if (count == 0)
+        return 0;
+
+    // The oldest samples may wrap around the end of the history
+    first = _glfw_min(count, js->sampleCapacity - js->sampleFirst);
+    memcpy(samples, js->samples + js->sampleFirst,
+           first * sizeof(GLFWjoysticksample));
+    memcpy(samples + first, js->samples,
+           (count - first) * sizeof(GLFWjoysticksample));
+
+    js->sampleFirst = (js->sampleFirst + count) % js->sampleCapacity;
+    js->sampleCount -= count;
+    return count;
+}
+
 GLFWAPI void glfwSetJoystickUserPointer(int jid, void* pointer)
 {
     _GLFWjoystick* js;
@@ -1253,62 +2138,60 @@ GLFWAPI GLFWjoystickfun glfwSetJoystickCallback(GLFWjoystickfun cbfun)
 
 GLFWAPI int glfwUpdateGamepadMappings(const char* string)
 {
-    int jid;
-    const char* c = string;
-
     assert(string != NULL);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
 
-    while (*c)
-    {
-        if ((*c >= '0' && *c <= '9') ||
-            (*c >= 'a' && *c <= 'f') ||
-            (*c >= 'A' && *c <= 'F'))
-        {
-            char line[1024];
+    return addMappings(string, string + strlen(string));
+}
 
-            const size_t length = strcspn(c, "\r\n");
-            if (length < sizeof(line))
-            {
-                _GLFWmapping mapping = {{0}};
+GLFWAPI int glfwLoadGamepadMappingsFile(const char* path)
+{
+    void* data;
+    size_t size;
+    const char* begin;
+    const char* last;
+    const char* end;
+    GLFWbool result;
 
-                memcpy(line, c, length);
-                line[length] = '\0';
+    assert(path != NULL);
 
-                if (parseMapping(&mapping, line))
-                {
-                    _GLFWmapping* previous = findMapping(mapping.guid);
-                    if (previous)
-                        *previous = mapping;
-                    else
-                    {
-                        _glfw.mappingCount++;
-                        _glfw.mappings =
-                            _glfw_realloc(_glfw.mappings,
-                                          sizeof(_GLFWmapping) * _glfw.mappingCount);
-                        _glfw.mappings[_glfw.mappingCount - 1] = mapping;
-                    }
-                }
-            }
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!_glfwPlatformMapFile(path, &data, &size))
+        return GLFW_FALSE;
+
+    if (!size)
+        return GLFW_TRUE;
 
-            c += length;
+    begin = data;
+    end = begin + size;
+
+    // The parser reads the line break after each line, so a last line without
+    // one is parsed from a terminated copy instead of past the mapped file
+    last = end;
+    while (last > begin && last[-1] != '\r' && last[-1] != '\n')
+        last--;
+
+    result = addMappings(begin, last);
+    if (result && last < end)
+    {
+        char* line = _glfw_calloc(end - last + 1, 1);
+        if (line)
+        {
+            memcpy(line, last, end - last);
+            result = addMappings(line, line + (end - last));
+            _glfw_free(line);
         }
         else
         {
-            c += strcspn(c, "\r\n");
-            c += strspn(c, "\r\n");
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            result = GLFW_FALSE;
         }
     }
 
-    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
-    {
-        _GLFWjoystick* js = _glfw.joysticks + jid;
-        if (js->connected)
-            js->mapping = findValidMapping(js);
-    }
-
-    return GLFW_TRUE;
+    _glfwPlatformUnmapFile(data, size);
+    return result;
 }
 
 GLFWAPI int glfwJoystickIsGamepad(int jid)
@@ -1372,8 +2255,11 @@ GLFWAPI const char* glfwGetGamepadName(int jid)
 
 GLFWAPI int glfwGetGamepadState(int jid, GLFWgamepadstate* state)
 {
-    int i;
+    int i, source, end;
     _GLFWjoystick* js;
+    const _GLFWremap* remap;
+    float inputs[_GLFW_REMAP_SIZE];
+    float values[_GLFW_REMAP_SIZE];
 
     assert(jid >= GLFW_JOYSTICK_1);
     assert(jid <= GLFW_JOYSTICK_LAST);
@@ -1402,55 +2288,30 @@ GLFWAPI int glfwGetGamepadState(int jid, GLFWgamepadstate* state)
     if (!js->mapping)
         return GLFW_FALSE;
 
-    for (i = 0;  i <= GLFW_GAMEPAD_BUTTON_LAST;  i++)
+    remap = &js->remap;
+    memset(inputs, 0, sizeof(inputs));
+
+    source = 0;
+    for (end = remap->axisSources;  source < end;  source++)
+        inputs[remap->outputs[source]] = js->axes[remap->indices[source]];
+    for (end += remap->buttonSources;  source < end;  source++)
+        inputs[remap->outputs[source]] = js->buttons[remap->indices[source]];
+    for (end += remap->hatSources;  source < end;  source++)
     {
-        const _GLFWmapelement* e = js->mapping->buttons + i;
-        if (e->type == _GLFW_JOYSTICK_AXIS)
-        {
-            const float value = js->axes[e->index] * e->axisScale + e->axisOffset;
-            // HACK: This should be baked into the value transform
-            // TODO: Bake into transform when implementing output modifiers
-            if (e->axisOffset < 0 || (e->axisOffset == 0 && e->axisScale > 0))
-            {
-                if (value >= 0.f)
-                    state->buttons[i] = GLFW_PRESS;
-            }
-            else
-            {
-                if (value <= 0.f)
-                    state->buttons[i] = GLFW_PRESS;
-            }
-        }
-        else if (e->type == _GLFW_JOYSTICK_HATBIT)
-        {
-            const unsigned int hat = e->index >> 4;
-            const unsigned int bit = e->index & 0xf;
-            if (js->hats[hat] & bit)
-                state->buttons[i] = GLFW_PRESS;
-        }
-        else if (e->type == _GLFW_JOYSTICK_BUTTON)
-            state->buttons[i] = js->buttons[e->index];
+        inputs[remap->outputs[source]] =
+            (js->hats[remap->indices[source]] & remap->bits[source]) ? 1.f : 0.f;
     }
 
+    // This has no branches or dependencies between outputs and is vectorized
+    for (i = 0;  i < _GLFW_REMAP_SIZE;  i++)
+        values[i] = inputs[i] * remap->scale[i] + remap->offset[i];
+
+    for (i = 0;  i <= GLFW_GAMEPAD_BUTTON_LAST;  i++)
+        state->buttons[i] = values[i] >= 0.f ? GLFW_PRESS : GLFW_RELEASE;
     for (i = 0;  i <= GLFW_GAMEPAD_AXIS_LAST;  i++)
     {
-        const _GLFWmapelement* e = js->mapping->axes + i;
-        if (e->type == _GLFW_JOYSTICK_AXIS)
-        {
-            const float value = js->axes[e->index] * e->axisScale + e->axisOffset;
-            state->axes[i] = fminf(fmaxf(value, -1.f), 1.f);
-        }
-        else if (e->type == _GLFW_JOYSTICK_HATBIT)
-        {
-            const unsigned int hat = e->index >> 4;
-            const unsigned int bit = e->index & 0xf;
-            if (js->hats[hat] & bit)
-                state->axes[i] = 1.f;
-            else
-                state->axes[i] = -1.f;
-        }
-        else if (e->type == _GLFW_JOYSTICK_BUTTON)
-            state->axes[i] = js->buttons[e->index] * 2.f - 1.f;
+        const float value = values[GLFW_GAMEPAD_BUTTON_LAST + 1 + i];
+        state->axes[i] = value < -1.f ? -1.f : value > 1.f ? 1.f : value;
     }
 
     return GLFW_TRUE;
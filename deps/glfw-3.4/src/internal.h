@@ -74,7 +74,9 @@ typedef struct _GLFWmonitor     _GLFWmonitor;
 typedef struct _GLFWcursor      _GLFWcursor;
 typedef struct _GLFWmapelement  _GLFWmapelement;
 typedef struct _GLFWmapping     _GLFWmapping;
+typedef struct _GLFWremap       _GLFWremap;
 typedef struct _GLFWjoystick    _GLFWjoystick;
+typedef struct _GLFWuserevent   _GLFWuserevent;
 typedef struct _GLFWtls         _GLFWtls;
 typedef struct _GLFWmutex       _GLFWmutex;
 
@@ -350,6 +352,25 @@ typedef VkResult (APIENTRY * PFN_vkEnumerateInstanceExtensionProperties)(const c
         y = t;                 \
     }
 
+// Atomic pointer operations for data shared with threads other than the main
+// thread, with acquire and release ordering
+#if defined(_MSC_VER)
+ #include <intrin.h>
+ #define _glfwExchangePointer(ptr, value) \
+     _InterlockedExchangePointer((void* volatile*) (ptr), (value))
+ #define _glfwLoadPointer(ptr) \
+     _InterlockedCompareExchangePointer((void* volatile*) (ptr), NULL, NULL)
+ #define _glfwStorePointer(ptr, value) \
+     ((void) _InterlockedExchangePointer((void* volatile*) (ptr), (value)))
+#else
+ #define _glfwExchangePointer(ptr, value) \
+     __atomic_exchange_n((ptr), (value), __ATOMIC_ACQ_REL)
+ #define _glfwLoadPointer(ptr) \
+     __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+ #define _glfwStorePointer(ptr, value) \
+     __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#endif
+
 // Per-thread error structure
 //
 struct _GLFWerror
@@ -359,6 +380,15 @@ struct _GLFWerror
     char            description[_GLFW_MESSAGE_SIZE];
 };
 
+// Event posted with glfwPostUserEvent
+//
+struct _GLFWuserevent
+{
+    _GLFWuserevent* next;
+    int             type;
+    void*           payload;
+};
+
 // Initialization configuration
 //
 // Parameters relating to the initialization of the library
@@ -366,6 +396,9 @@ struct _GLFWerror
 struct _GLFWinitconfig
 {
     GLFWbool      hatButtons;
+    GLFWbool      eventQueue;
+    GLFWbool      joystickThread;
+    int           joystickSamples;
     int           angleType;
     int           platformID;
     PFN_vkGetInstanceProcAddr vulkanLoader;
@@ -375,6 +408,9 @@ struct _GLFWinitconfig
     } ns;
     struct {
         GLFWbool  xcbVulkanSurface;
+        GLFWbool  eventThread;
+        GLFWbool  cursorPosQuery;
+        GLFWbool  statistics;
     } x11;
     struct {
         int       libdecorMode;
@@ -547,9 +583,27 @@ struct _GLFWwindow
     int                 cursorMode;
     char                mouseButtons[GLFW_MOUSE_BUTTON_LAST + 1];
     char                keys[GLFW_KEY_LAST + 1];
+    // Keys and mouse buttons pressed in the previous input snapshot and those
+    // pressed or released since then, one bit each
+    uint32_t            snapshotKeys[(GLFW_KEY_LAST + 32) / 32];
+    uint32_t            toggledKeys[(GLFW_KEY_LAST + 32) / 32];
+    uint32_t            snapshotMouseButtons;
+    uint32_t            toggledMouseButtons;
     // Virtual cursor position when cursor is disabled
     double              virtualCursorPosX, virtualCursorPosY;
     GLFWbool            rawMouseMotion;
+    // Whether input events go to the event queue instead of the callbacks
+    GLFWbool            eventQueue;
+    // Whether consecutive cursor motion is merged and whether the merged
+    // motion is queued as a path
+    GLFWbool            coalesceCursor;
+    GLFWbool            cursorPath;
+    // Merged cursor motion not yet reported
+    GLFWbool            cursorMotionPending;
+    double              cursorMotionX, cursorMotionY;
+    uint64_t            cursorMotionTime;
+    // Motion of the latest cursor position event, for glfwGetCursorDelta
+    double              cursorDeltaX, cursorDeltaY;
 
     _GLFWcontext        context;
 
@@ -630,6 +684,31 @@ struct _GLFWmapping
     _GLFWmapelement axes[6];
 };
 
+// Number of gamepad outputs, the buttons followed by the axes
+#define _GLFW_REMAP_OUTPUTS (GLFW_GAMEPAD_BUTTON_LAST + 1 + GLFW_GAMEPAD_AXIS_LAST + 1)
+// Output arrays are padded to a whole number of four float vectors
+#define _GLFW_REMAP_SIZE ((_GLFW_REMAP_OUTPUTS + 3) & ~3)
+
+// Gamepad mapping compiled for a specific joystick
+//
+// Each mapped output gathers one joystick input, as a float, into the slot of
+// that output.  The axis sources come first, then the buttons, then the hat
+// bits.  Every output is then transformed by input * scale + offset, with
+// unmapped outputs gathering nothing.  Buttons are pressed if the result is
+// not negative and axes are clamped to [-1, 1].
+//
+struct _GLFWremap
+{
+    int             axisSources;
+    int             buttonSources;
+    int             hatSources;
+    uint8_t         outputs[_GLFW_REMAP_OUTPUTS];
+    uint8_t         indices[_GLFW_REMAP_OUTPUTS];
+    uint8_t         bits[_GLFW_REMAP_OUTPUTS];
+    float           scale[_GLFW_REMAP_SIZE];
+    float           offset[_GLFW_REMAP_SIZE];
+};
+
 // Joystick structure
 //
 struct _GLFWjoystick
@@ -645,7 +724,18 @@ struct _GLFWjoystick
     char            name[128];
     void*           userPointer;
     char            guid[33];
-    _GLFWmapping*   mapping;
+    const _GLFWmapping* mapping;
+    _GLFWremap      remap;
+    // Timestamp of the latest axis, button or hat change
+    uint64_t        eventTime;
+    // History of changes not yet retrieved, oldest at samples[sampleFirst]
+    // and wrapping around.  Platforms that record their own samples set
+    // platformSamples and report them with _glfwInputJoystickSample.
+    GLFWjoysticksample* samples;
+    int             sampleCapacity;
+    int             sampleFirst;
+    int             sampleCount;
+    GLFWbool        platformSamples;
 
     // This is defined in platform.h
     GLFW_PLATFORM_JOYSTICK_STATE
@@ -777,8 +867,39 @@ struct _GLFWlibrary
 
     GLFWbool            joysticksInitialized;
     _GLFWjoystick       joysticks[GLFW_JOYSTICK_LAST + 1];
+    // Mappings added with glfwUpdateGamepadMappings, and an open addressing
+    // hash index of them by GUID holding the mapping index plus one or zero
+    // for an empty slot, at most half full
     _GLFWmapping*       mappings;
     int                 mappingCount;
+    int                 mappingCapacity;
+    int*                mappingIndex;
+    int                 mappingIndexSize;
+
+    // Events queued for glfwGetEvents, oldest at events[first]
+    struct {
+        GLFWevent*      events;
+        int             first;
+        int             count;
+        int             capacity;
+    } eventQueue;
+
+    // Events posted with glfwPostUserEvent from any thread, a lock-free queue
+    // where posts are linked in at the head and event processing removes them
+    // from the tail, with the stub node keeping it from ever being empty
+    struct {
+        _GLFWuserevent* head;
+        _GLFWuserevent* tail;
+        _GLFWuserevent  stub;
+    } userEvents;
+
+    // Platform timer value of the event being reported, or zero to use the
+    // time it is processed
+    uint64_t            eventTime;
+    // Timestamp of the latest window input event, for glfwGetEventTime
+    uint64_t            lastEventTime;
+    // Whether any window may have merged cursor motion not yet reported
+    GLFWbool            cursorMotionPending;
 
     _GLFWtls            errorSlot;
     _GLFWtls            contextSlot;
@@ -790,6 +911,9 @@ struct _GLFWlibrary
         GLFW_PLATFORM_LIBRARY_TIMER_STATE
     } timer;
 
+    // This is defined in platform.h
+    GLFW_PLATFORM_LIBRARY_POLL_STATE
+
     struct {
         EGLenum         platform;
         EGLDisplay      display;
@@ -865,6 +989,7 @@ struct _GLFWlibrary
     struct {
         GLFWmonitorfun  monitor;
         GLFWjoystickfun joystick;
+        GLFWusereventfun userEvent;
     } callbacks;
 
     // These are defined in platform.h
@@ -900,6 +1025,9 @@ void* _glfwPlatformLoadModule(const char* path);
 void _glfwPlatformFreeModule(void* module);
 GLFWproc _glfwPlatformGetModuleSymbol(void* module, const char* name);
 
+GLFWbool _glfwPlatformMapFile(const char* path, void** data, size_t* size);
+void _glfwPlatformUnmapFile(void* data, size_t size);
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
@@ -930,6 +1058,8 @@ void _glfwInputJoystick(_GLFWjoystick* js, int event);
 void _glfwInputJoystickAxis(_GLFWjoystick* js, int axis, float value);
 void _glfwInputJoystickButton(_GLFWjoystick* js, int button, char value);
 void _glfwInputJoystickHat(_GLFWjoystick* js, int hat, char value);
+void _glfwInputJoystickSample(_GLFWjoystick* js, int type, int index,
+                              float axis, int state, uint64_t time);
 
 void _glfwInputMonitor(_GLFWmonitor* monitor, int action, int placement);
 void _glfwInputMonitorWindow(_GLFWmonitor* monitor, _GLFWwindow* window);
@@ -965,7 +1095,6 @@ void _glfwAllocGammaArrays(GLFWgammaramp* ramp, unsigned int size);
 void _glfwFreeGammaArrays(GLFWgammaramp* ramp);
 void _glfwSplitBPP(int bpp, int* red, int* green, int* blue);
 
-void _glfwInitGamepadMappings(void);
 _GLFWjoystick* _glfwAllocJoystick(const char* name,
                                   const char* guid,
                                   int axisCount,
@@ -973,6 +1102,9 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
                                   int hatCount);
 void _glfwFreeJoystick(_GLFWjoystick* js);
 void _glfwCenterCursorInContentArea(_GLFWwindow* window);
+GLFWevent* _glfwPushEvent(_GLFWwindow* window, int type);
+void _glfwRemoveEvents(_GLFWwindow* window);
+void _glfwFlushCursorMotion(void);
 
 GLFWbool _glfwInitEGL(void);
 void _glfwTerminateEGL(void);
@@ -32,9 +32,12 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/inotify.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <dirent.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -45,13 +48,143 @@
 #define SYN_DROPPED 3
 #endif
 
+#ifndef input_event_sec // < v4.16 kernel headers
+#define input_event_sec time.tv_sec
+#define input_event_usec time.tv_usec
+#endif
+
+// Locks the joysticks against the joystick thread, if there is one
+//
+static void lockJoysticks(void)
+{
+    if (_glfw.linjs.threaded)
+        pthread_mutex_lock(&_glfw.linjs.mutex);
+}
+
+// Unlocks the joysticks for the joystick thread, if there is one
+//
+static void unlockJoysticks(void)
+{
+    if (_glfw.linjs.threaded)
+        pthread_mutex_unlock(&_glfw.linjs.mutex);
+}
+
+// Sets the time of the event being applied to the specified joystick
+//
+static void setEventTime(_GLFWjoystick* js, const struct input_event* e)
+{
+    uint64_t time = 0;
+
+    if (js->linjs.monotonic)
+    {
+        time = _glfwTimerValueFromMonotonicPOSIX((uint64_t) e->input_event_sec * 1000000000 +
+                                                 (uint64_t) e->input_event_usec * 1000);
+    }
+
+    if (_glfw.linjs.threaded)
+        js->linjs.state.time = time ? time : _glfwPlatformGetTimerValue();
+    else
+        _glfw.eventTime = time;
+}
+
+// Records a state change on the joystick thread for the sample history,
+// discarding it if the ring is full
+//
+static void recordSample(_GLFWjoystick* js, int type, int index,
+                         float axis, int state)
+{
+    _GLFWjoystickLinux* linjs = &js->linjs;
+    const unsigned int head = linjs->sampleHead;
+    const unsigned int tail = __atomic_load_n(&linjs->sampleTail, __ATOMIC_ACQUIRE);
+
+    if (head - tail == linjs->sampleCapacity)
+        return;
+
+    GLFWjoysticksample* sample = linjs->samples + head % linjs->sampleCapacity;
+    sample->time = linjs->state.time;
+    sample->type = type;
+    sample->index = index;
+    sample->axis = axis;
+    sample->state = state;
+
+    __atomic_store_n(&linjs->sampleHead, head + 1, __ATOMIC_RELEASE);
+}
+
+// Moves the changes recorded by the joystick thread to the sample history
+//
+static void drainSamples(_GLFWjoystick* js)
+{
+    _GLFWjoystickLinux* linjs = &js->linjs;
+    const unsigned int head = __atomic_load_n(&linjs->sampleHead, __ATOMIC_ACQUIRE);
+    unsigned int tail = linjs->sampleTail;
+
+    for (;  tail != head;  tail++)
+    {
+        const GLFWjoysticksample* sample =
+            linjs->samples + tail % linjs->sampleCapacity;
+
+        _glfwInputJoystickSample(js, sample->type, sample->index,
+                                 sample->axis, sample->state, sample->time);
+    }
+
+    __atomic_store_n(&linjs->sampleTail, tail, __ATOMIC_RELEASE);
+}
+
+// Reports a new button state or stores it for the joystick thread to publish
+//
+static void inputButton(_GLFWjoystick* js, int button, char value)
+{
+    if (_glfw.linjs.threaded)
+    {
+        if (js->linjs.state.buttons[button] != value)
+        {
+            recordSample(js, GLFW_JOYSTICK_SAMPLE_BUTTON, button, 0.f, value);
+            js->linjs.state.buttons[button] = value;
+        }
+    }
+    else
+        _glfwInputJoystickButton(js, button, value);
+}
+
+// Reports a new axis value or stores it for the joystick thread to publish
+//
+static void inputAxis(_GLFWjoystick* js, int axis, float value)
+{
+    if (_glfw.linjs.threaded)
+    {
+        if (js->linjs.state.axes[axis] != value)
+        {
+            recordSample(js, GLFW_JOYSTICK_SAMPLE_AXIS, axis, value, 0);
+            js->linjs.state.axes[axis] = value;
+        }
+    }
+    else
+        _glfwInputJoystickAxis(js, axis, value);
+}
+
+// Reports a new hat state or stores it for the joystick thread to publish
+//
+static void inputHat(_GLFWjoystick* js, int hat, char value)
+{
+    if (_glfw.linjs.threaded)
+    {
+        if (js->linjs.state.hats[hat] != value)
+        {
+            recordSample(js, GLFW_JOYSTICK_SAMPLE_HAT, hat, 0.f, value);
+            js->linjs.state.hats[hat] = value;
+        }
+    }
+    else
+        _glfwInputJoystickHat(js, hat, value);
+}
+
 // Apply an EV_KEY event to the specified joystick
 //
 static void handleKeyEvent(_GLFWjoystick* js, int code, int value)
 {
-    _glfwInputJoystickButton(js,
-                             js->linjs.keyMap[code - BTN_MISC],
-                             value ? GLFW_PRESS : GLFW_RELEASE);
+    inputButton(js,
+                js->linjs.keyMap[code - BTN_MISC],
+                value ? GLFW_PRESS : GLFW_RELEASE);
 }
 
 // Apply an EV_ABS event to the specified joystick
@@ -82,7 +215,7 @@ static void handleAbsEvent(_GLFWjoystick* js, int code, int value)
         else if (value > 0)
             state[axis] = 2;
 
-        _glfwInputJoystickHat(js, index, stateMap[state[0]][state[1]]);
+        inputHat(js, index, stateMap[state[0]][state[1]]);
     }
     else
     {
@@ -98,7 +231,7 @@ static void handleAbsEvent(_GLFWjoystick* js, int code, int value)
             normalized = normalized * 2.0f - 1.0f;
         }
 
-        _glfwInputJoystickAxis(js, index, normalized);
+        inputAxis(js, index, normalized);
     }
 }
 
@@ -120,6 +253,192 @@ static void pollAbsState(_GLFWjoystick* js)
     }
 }
 
+// Publishes the state collected by the joystick thread as the latest one
+//
+static void publishState(_GLFWjoystick* js)
+{
+    _GLFWjoystickLinux* linjs = &js->linjs;
+
+    memcpy(linjs->buffers + linjs->back, &linjs->state, sizeof(linjs->state));
+    linjs->back = __atomic_exchange_n(&linjs->middle,
+                                      linjs->back | _GLFW_LINUX_STATE_DIRTY,
+                                      __ATOMIC_ACQ_REL) & ~_GLFW_LINUX_STATE_DIRTY;
+}
+
+// Applies the latest state published by the joystick thread, if it is new
+//
+static void applyPublishedState(_GLFWjoystick* js)
+{
+    _GLFWjoystickLinux* linjs = &js->linjs;
+    const _GLFWjoystickStateLinux* state;
+
+    if (!(__atomic_load_n(&linjs->middle, __ATOMIC_ACQUIRE) & _GLFW_LINUX_STATE_DIRTY))
+        return;
+
+    linjs->front = __atomic_exchange_n(&linjs->middle, linjs->front,
+                                       __ATOMIC_ACQ_REL) & ~_GLFW_LINUX_STATE_DIRTY;
+    state = linjs->buffers + linjs->front;
+
+    _glfw.eventTime = state->time;
+
+    for (int axis = 0;  axis < js->axisCount;  axis++)
+        _glfwInputJoystickAxis(js, axis, state->axes[axis]);
+    for (int button = 0;  button < js->buttonCount;  button++)
+        _glfwInputJoystickButton(js, button, state->buttons[button]);
+    for (int hat = 0;  hat < js->hatCount;  hat++)
+        _glfwInputJoystickHat(js, hat, state->hats[hat]);
+
+    _glfw.eventTime = 0;
+}
+
+// Reads all queued events of the specified joystick (non-blocking)
+//
+// Returns GLFW_FALSE if the device was disconnected.
+//
+static GLFWbool readJoystickEvents(_GLFWjoystick* js)
+{
+    for (;;)
+    {
+        struct input_event e;
+
+        errno = 0;
+        if (read(js->linjs.fd, &e, sizeof(e)) < 0)
+            return errno != ENODEV;
+
+        setEventTime(js, &e);
+
+        if (e.type == EV_SYN)
+        {
+            if (e.code == SYN_DROPPED)
+                _glfw.linjs.dropped = GLFW_TRUE;
+            else if (e.code == SYN_REPORT)
+            {
+                _glfw.linjs.dropped = GLFW_FALSE;
+                pollAbsState(js);
+
+                if (_glfw.linjs.threaded)
+                    publishState(js);
+            }
+        }
+
+        if (_glfw.linjs.dropped)
+            continue;
+
+        if (e.type == EV_KEY)
+            handleKeyEvent(js, e.code, e.value);
+        else if (e.type == EV_ABS)
+            handleAbsEvent(js, e.code, e.value);
+    }
+}
+
+// Adds the device of the specified joystick to the joystick thread epoll set
+//
+static void watchJoystick(_GLFWjoystick* js)
+{
+    struct epoll_event event = { EPOLLIN };
+
+    // The slot and descriptor together identify the device even if the slot
+    // has been reused by the time the thread sees the event
+    event.data.u64 = ((uint64_t) js->linjs.fd << 32) | (uint64_t) (js - _glfw.joysticks);
+
+    if (epoll_ctl(_glfw.linjs.epoll, EPOLL_CTL_ADD, js->linjs.fd, &event) == -1)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Linux: Failed to watch joystick device: %s",
+                        strerror(errno));
+    }
+}
+
+// Entry point of the joystick thread
+//
+static void* joystickThreadMain(void* arg)
+{
+    for (;;)
+    {
+        struct epoll_event events[16];
+
+        const int count = epoll_wait(_glfw.linjs.epoll, events, 16, -1);
+        if (count == -1 && errno != EINTR)
+            break;
+
+        pthread_mutex_lock(&_glfw.linjs.mutex);
+
+        if (_glfw.linjs.threadStopping)
+        {
+            pthread_mutex_unlock(&_glfw.linjs.mutex);
+            break;
+        }
+
+        for (int i = 0;  i < count;  i++)
+        {
+            const int jid = (int) (events[i].data.u64 & 0xffffffff);
+            const int fd = (int) (events[i].data.u64 >> 32);
+
+            if (jid > GLFW_JOYSTICK_LAST)
+                continue;
+
+            _GLFWjoystick* js = _glfw.joysticks + jid;
+            if (!js->allocated || js->linjs.fd != fd || js->linjs.disconnected)
+                continue;
+
+            if (!readJoystickEvents(js))
+            {
+                // The main thread closes the joystick on its next poll
+                epoll_ctl(_glfw.linjs.epoll, EPOLL_CTL_DEL, fd, NULL);
+                __atomic_store_n(&js->linjs.disconnected, GLFW_TRUE, __ATOMIC_RELEASE);
+            }
+        }
+
+        pthread_mutex_unlock(&_glfw.linjs.mutex);
+    }
+
+    return NULL;
+}
+
+// Starts the joystick thread, falling back to reading the devices on the main
+// thread if it cannot be started
+//
+static void startJoystickThread(void)
+{
+    sigset_t all, previous;
+    int result;
+
+    for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        if (_glfw.joysticks[jid].connected)
+            watchJoystick(_glfw.joysticks + jid);
+    }
+
+    // Leave all signals to the threads of the application
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &previous);
+    result = pthread_create(&_glfw.linjs.thread, NULL, joystickThreadMain, NULL);
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+    if (result != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Linux: Failed to create joystick thread: %s",
+                        strerror(result));
+
+        for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+        {
+            _GLFWjoystick* js = _glfw.joysticks + jid;
+            if (js->connected)
+            {
+                drainSamples(js);
+                applyPublishedState(js);
+                js->platformSamples = GLFW_FALSE;
+            }
+        }
+
+        _glfw.linjs.threaded = GLFW_FALSE;
+        return;
+    }
+
+    _glfw.linjs.threadStarted = GLFW_TRUE;
+}
+
 #define isBitSet(bit, arr) (arr[(bit) / 8] & (1 << ((bit) % 8)))
 
 // Attempt to open the specified joystick device
@@ -163,6 +482,13 @@ static GLFWbool openJoystickDevice(const char* path)
         return GLFW_FALSE;
     }
 
+#if defined(EVIOCSCLOCKID)
+    // Request event times from the clock used by the timer, when it can be
+    const int clock = CLOCK_MONOTONIC;
+    if (ioctl(linjs.fd, EVIOCSCLOCKID, &clock) == 0)
+        linjs.monotonic = GLFW_TRUE;
+#endif
+
     char name[256] = "";
 
     if (ioctl(linjs.fd, EVIOCGNAME(sizeof(name)), name) < 0)
@@ -222,19 +548,52 @@ static GLFWbool openJoystickDevice(const char* path)
         }
     }
 
+    strncpy(linjs.path, path, sizeof(linjs.path) - 1);
+    linjs.back = 0;
+    linjs.middle = 1;
+    linjs.front = 2;
+
+    lockJoysticks();
+
     _GLFWjoystick* js =
         _glfwAllocJoystick(name, guid, axisCount, buttonCount, hatCount);
     if (!js)
     {
+        unlockJoysticks();
         close(linjs.fd);
         return GLFW_FALSE;
     }
 
-    strncpy(linjs.path, path, sizeof(linjs.path) - 1);
     memcpy(&js->linjs, &linjs, sizeof(linjs));
 
+    if (_glfw.linjs.threaded)
+    {
+        js->platformSamples = GLFW_TRUE;
+        js->linjs.state.time = _glfwPlatformGetTimerValue();
+
+        if (js->sampleCapacity)
+        {
+            js->linjs.samples = _glfw_calloc(js->sampleCapacity,
+                                             sizeof(GLFWjoysticksample));
+            if (js->linjs.samples)
+                js->linjs.sampleCapacity = js->sampleCapacity;
+        }
+    }
+
     pollAbsState(js);
 
+    if (_glfw.linjs.threaded)
+    {
+        drainSamples(js);
+        publishState(js);
+        applyPublishedState(js);
+
+        if (_glfw.linjs.threadStarted)
+            watchJoystick(js);
+    }
+
+    unlockJoysticks();
+
     _glfwInputJoystick(js, GLFW_CONNECTED);
     return GLFW_TRUE;
 }
@@ -246,8 +605,12 @@ static GLFWbool openJoystickDevice(const char* path)
 static void closeJoystick(_GLFWjoystick* js)
 {
     _glfwInputJoystick(js, GLFW_DISCONNECTED);
+
+    lockJoysticks();
     close(js->linjs.fd);
+    _glfw_free(js->linjs.samples);
     _glfwFreeJoystick(js);
+    unlockJoysticks();
 }
 
 // Lexically compare joysticks by name; used by qsort
@@ -331,6 +694,29 @@ GLFWbool _glfwInitJoysticksLinux(void)
         return GLFW_FALSE;
     }
 
+    if (_glfw.hints.init.joystickThread)
+    {
+        _glfw.linjs.epoll = epoll_create1(EPOLL_CLOEXEC);
+        _glfw.linjs.wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        _glfw.linjs.mutexCreated =
+            (pthread_mutex_init(&_glfw.linjs.mutex, NULL) == 0);
+
+        if (_glfw.linjs.epoll == -1 || _glfw.linjs.wakeup == -1 ||
+            !_glfw.linjs.mutexCreated)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Linux: Failed to create joystick thread objects: %s",
+                            strerror(errno));
+            return GLFW_FALSE;
+        }
+
+        struct epoll_event event = { EPOLLIN };
+        event.data.u64 = UINT64_MAX;
+        epoll_ctl(_glfw.linjs.epoll, EPOLL_CTL_ADD, _glfw.linjs.wakeup, &event);
+
+        _glfw.linjs.threaded = GLFW_TRUE;
+    }
+
     int count = 0;
 
     DIR* dir = opendir(dirname);
@@ -359,11 +745,38 @@ GLFWbool _glfwInitJoysticksLinux(void)
     // Continue with no joysticks if enumeration fails
 
     qsort(_glfw.joysticks, count, sizeof(_GLFWjoystick), compareJoysticks);
+
+    // The thread identifies devices by slot, so it starts after sorting
+    if (_glfw.linjs.threaded)
+        startJoystickThread();
+
     return GLFW_TRUE;
 }
 
 void _glfwTerminateJoysticksLinux(void)
 {
+    if (_glfw.linjs.threadStarted)
+    {
+        const uint64_t one = 1;
+
+        pthread_mutex_lock(&_glfw.linjs.mutex);
+        _glfw.linjs.threadStopping = GLFW_TRUE;
+        pthread_mutex_unlock(&_glfw.linjs.mutex);
+
+        for (;;)
+        {
+            const ssize_t result = write(_glfw.linjs.wakeup, &one, sizeof(one));
+            if (result == sizeof(one) || (result == -1 && errno != EINTR))
+                break;
+        }
+
+        pthread_join(_glfw.linjs.thread, NULL);
+
+        _glfw.linjs.threadStarted = GLFW_FALSE;
+    }
+
+    _glfw.linjs.threaded = GLFW_FALSE;
+
     for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
     {
         _GLFWjoystick* js = _glfw.joysticks + jid;
@@ -381,45 +794,39 @@ void _glfwTerminateJoysticksLinux(void)
 
     if (_glfw.linjs.regexCompiled)
         regfree(&_glfw.linjs.regex);
+
+    if (_glfw.linjs.epoll > 0)
+        close(_glfw.linjs.epoll);
+    if (_glfw.linjs.wakeup > 0)
+        close(_glfw.linjs.wakeup);
+    if (_glfw.linjs.mutexCreated)
+        pthread_mutex_destroy(&_glfw.linjs.mutex);
 }
 
 GLFWbool _glfwPollJoystickLinux(_GLFWjoystick* js, int mode)
 {
-    // Read all queued events (non-blocking)
-    for (;;)
+    if (_glfw.linjs.threaded)
     {
-        struct input_event e;
-
-        errno = 0;
-        if (read(js->linjs.fd, &e, sizeof(e)) < 0)
+        // Only copy the state already read by the joystick thread
+        if (__atomic_load_n(&js->linjs.disconnected, __ATOMIC_ACQUIRE))
+            closeJoystick(js);
+        else if (mode != _GLFW_POLL_PRESENCE)
         {
-            // Reset the joystick slot if the device was disconnected
-            if (errno == ENODEV)
-                closeJoystick(js);
-
-            break;
+            drainSamples(js);
+            applyPublishedState(js);
         }
 
-        if (e.type == EV_SYN)
-        {
-            if (e.code == SYN_DROPPED)
-                _glfw.linjs.dropped = GLFW_TRUE;
-            else if (e.code == SYN_REPORT)
-            {
-                _glfw.linjs.dropped = GLFW_FALSE;
-                pollAbsState(js);
-            }
-        }
-
-        if (_glfw.linjs.dropped)
-            continue;
+        return js->connected;
+    }
 
-        if (e.type == EV_KEY)
-            handleKeyEvent(js, e.code, e.value);
-        else if (e.type == EV_ABS)
-            handleAbsEvent(js, e.code, e.value);
+    if (!readJoystickEvents(js))
+    {
+        // Reset the joystick slot if the device was disconnected
+        closeJoystick(js);
     }
 
+    _glfw.eventTime = 0;
+
     return js->connected;
 }
 
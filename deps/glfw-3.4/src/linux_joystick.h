@@ -26,11 +26,25 @@
 
 #include <linux/input.h>
 #include <linux/limits.h>
+#include <pthread.h>
 #include <regex.h>
 
 #define GLFW_LINUX_JOYSTICK_STATE         _GLFWjoystickLinux linjs;
 #define GLFW_LINUX_LIBRARY_JOYSTICK_STATE _GLFWlibraryLinux  linjs;
 
+// Flag set in the middle buffer index when it holds unread state
+#define _GLFW_LINUX_STATE_DIRTY 4
+
+// Joystick state collected by the joystick thread
+//
+typedef struct _GLFWjoystickStateLinux
+{
+    float                   axes[ABS_CNT];
+    unsigned char           buttons[KEY_CNT - BTN_MISC];
+    unsigned char           hats[4];
+    uint64_t                time;
+} _GLFWjoystickStateLinux;
+
 // Linux-specific joystick data
 //
 typedef struct _GLFWjoystickLinux
@@ -41,6 +55,25 @@ typedef struct _GLFWjoystickLinux
     int                     absMap[ABS_CNT];
     struct input_absinfo    absInfo[ABS_CNT];
     int                     hats[4][2];
+    GLFWbool                monotonic;
+    // With the joystick thread, events are applied to state by that thread and
+    // each complete report is published through a triple buffer.  The thread
+    // owns buffers[back], the main thread owns buffers[front] and they swap
+    // their buffer atomically with the latest published one in middle, so
+    // neither ever waits for the other.
+    _GLFWjoystickStateLinux state;
+    _GLFWjoystickStateLinux buffers[3];
+    int                     back;
+    int                     front;
+    int                     middle;
+    // Set by the joystick thread when the device is gone
+    int                     disconnected;
+    // Changes recorded by the joystick thread for the sample history, a single
+    // producer single consumer ring indexed by free running counters
+    GLFWjoysticksample*     samples;
+    unsigned int            sampleCapacity;
+    unsigned int            sampleHead;
+    unsigned int            sampleTail;
 } _GLFWjoystickLinux;
 
 // Linux-specific joystick API data
@@ -52,6 +85,17 @@ typedef struct _GLFWlibraryLinux
     regex_t                 regex;
     GLFWbool                regexCompiled;
     GLFWbool                dropped;
+    // The joystick thread waits on an epoll instance holding every device and
+    // an eventfd used to stop it.  The mutex is held by the thread while it
+    // reads devices and by the main thread while it opens or closes them.
+    GLFWbool                threaded;
+    GLFWbool                threadStarted;
+    GLFWbool                threadStopping;
+    pthread_t               thread;
+    pthread_mutex_t         mutex;
+    GLFWbool                mutexCreated;
+    int                     epoll;
+    int                     wakeup;
 } _GLFWlibraryLinux;
 
 void _glfwDetectJoystickConnectionLinux(void);
@@ -251,12 +251,21 @@ int _glfwInitNull(void)
             _glfw.null.scancodes[_glfw.null.keycodes[scancode]] = scancode;
     }
 
+#if defined(GLFW_BUILD_POSIX_POLL)
+    if (!_glfwCreateWakeupPOSIX(&_glfw.posixWakeup))
+        return GLFW_FALSE;
+#endif
+
     _glfwPollMonitorsNull();
     return GLFW_TRUE;
 }
 
 void _glfwTerminateNull(void)
 {
+#if defined(GLFW_BUILD_POSIX_POLL)
+    _glfwDestroyWakeupPOSIX(&_glfw.posixWakeup);
+#endif
+
     free(_glfw.null.clipboardString);
     _glfwTerminateOSMesa();
     _glfwTerminateEGL();
@@ -42,7 +42,8 @@ void _glfwTerminateJoysticksNull(void)
 
 GLFWbool _glfwPollJoystickNull(_GLFWjoystick* js, int mode)
 {
-    return GLFW_FALSE;
+    // Joysticks only exist here if injected through the joystick event API
+    return js->connected;
 }
 
 const char* _glfwGetMappingNameNull(void)
@@ -486,18 +486,37 @@ GLFWbool _glfwWindowVisibleNull(_GLFWwindow* window)
 
 void _glfwPollEventsNull(void)
 {
+#if defined(GLFW_BUILD_POSIX_POLL)
+    _glfwConsumeWakeupPOSIX(&_glfw.posixWakeup);
+    _glfwPollEventSourcesPOSIX();
+#endif
 }
 
 void _glfwWaitEventsNull(void)
 {
+#if defined(GLFW_BUILD_POSIX_POLL)
+    // There are no window system events, so only empty events, event sources
+    // and the deadline can end the wait
+    struct pollfd fd = { _glfw.posixWakeup.fds[0], POLLIN };
+    _glfwWaitPOSIX(&fd, 1, NULL);
+    _glfwPollEventsNull();
+#endif
 }
 
 void _glfwWaitEventsTimeoutNull(double timeout)
 {
+#if defined(GLFW_BUILD_POSIX_POLL)
+    struct pollfd fd = { _glfw.posixWakeup.fds[0], POLLIN };
+    _glfwWaitPOSIX(&fd, 1, &timeout);
+    _glfwPollEventsNull();
+#endif
 }
 
 void _glfwPostEmptyEventNull(void)
 {
+#if defined(GLFW_BUILD_POSIX_POLL)
+    _glfwPostWakeupPOSIX(&_glfw.posixWakeup);
+#endif
 }
 
 void _glfwGetCursorPosNull(_GLFWwindow* window, double* xpos, double* ypos)
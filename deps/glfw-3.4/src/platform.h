@@ -27,16 +27,31 @@
 
 #if defined(GLFW_BUILD_WIN32_TIMER) || \
     defined(GLFW_BUILD_WIN32_MODULE) || \
+    defined(GLFW_BUILD_WIN32_FILE) || \
     defined(GLFW_BUILD_WIN32_THREAD) || \
     defined(GLFW_BUILD_COCOA_TIMER) || \
     defined(GLFW_BUILD_POSIX_TIMER) || \
     defined(GLFW_BUILD_POSIX_MODULE) || \
+    defined(GLFW_BUILD_POSIX_FILE) || \
     defined(GLFW_BUILD_POSIX_THREAD) || \
     defined(GLFW_BUILD_POSIX_POLL) || \
     defined(GLFW_BUILD_LINUX_JOYSTICK)
  #error "You must not define these; define zero or more _GLFW_<platform> macros instead"
 #endif
 
+// The poll helpers come before the platform headers, which may embed their
+// wakeup type
+#if !defined(_WIN32)
+ #define GLFW_BUILD_POSIX_POLL
+#endif
+
+#if defined(GLFW_BUILD_POSIX_POLL)
+ #include "posix_poll.h"
+ #define GLFW_PLATFORM_LIBRARY_POLL_STATE  GLFW_POSIX_LIBRARY_POLL_STATE
+#else
+ #define GLFW_PLATFORM_LIBRARY_POLL_STATE
+#endif
+
 #include "null_platform.h"
 #define GLFW_EXPOSE_NATIVE_EGL
 #define GLFW_EXPOSE_NATIVE_OSMESA
@@ -202,11 +217,9 @@
 
 #if defined(_WIN32)
  #define GLFW_BUILD_WIN32_MODULE
+ #define GLFW_BUILD_WIN32_FILE
 #else
  #define GLFW_BUILD_POSIX_MODULE
-#endif
-
-#if defined(_GLFW_WAYLAND) || defined(_GLFW_X11)
- #define GLFW_BUILD_POSIX_POLL
+ #define GLFW_BUILD_POSIX_FILE
 #endif
 
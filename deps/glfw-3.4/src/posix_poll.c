@@ -33,6 +33,125 @@
 #include <signal.h>
 #include <time.h>
 #include <errno.h>
+#include <assert.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#if defined(__linux__)
+ #include <sys/timerfd.h>
+ #include <sys/eventfd.h>
+#endif
+
+// Returns the descriptors of the event sources
+//
+static struct pollfd* getSourceFds(void)
+{
+    return _glfw.posixPoll.fds + _GLFW_POSIX_DEADLINE_FD + 1;
+}
+
+// Makes room for the specified number of event sources
+//
+static GLFWbool reserveEventSources(int count)
+{
+    struct pollfd* fds;
+    GLFWeventsourcefun* callbacks;
+    int capacity;
+
+    if (_glfw.posixPoll.fds && count <= _glfw.posixPoll.sourceCapacity)
+        return GLFW_TRUE;
+
+    capacity = _glfw_max(count, _glfw_max(8, _glfw.posixPoll.sourceCapacity * 2));
+
+    fds = _glfw_realloc(_glfw.posixPoll.fds,
+                        (_GLFW_POSIX_DEADLINE_FD + 1 + capacity) *
+                        sizeof(struct pollfd));
+    if (!fds)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
+
+    if (!_glfw.posixPoll.fds)
+    {
+        fds[_GLFW_POSIX_DEADLINE_FD].fd = -1;
+        fds[_GLFW_POSIX_DEADLINE_FD].events = POLLIN;
+    }
+
+    _glfw.posixPoll.fds = fds;
+
+    callbacks = _glfw_realloc(_glfw.posixPoll.callbacks,
+                              capacity * sizeof(GLFWeventsourcefun));
+    if (!callbacks)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
+
+    _glfw.posixPoll.callbacks = callbacks;
+    _glfw.posixPoll.sourceCapacity = capacity;
+    return GLFW_TRUE;
+}
+
+// Returns the index of the event source with the specified descriptor, or -1
+//
+static int findEventSource(int fd)
+{
+    const struct pollfd* sources = getSourceFds();
+
+    for (int i = 0;  i < _glfw.posixPoll.sourceCount;  i++)
+    {
+        if (sources[i].fd == fd)
+            return i;
+    }
+
+    return -1;
+}
+
+// Calls the deadline callback if the deadline timer expired and the callbacks
+// of ready event sources
+// The scan restarts after every callback, as callbacks may add and remove
+// event sources
+//
+static void dispatchEventSources(void)
+{
+    struct pollfd* timer = _glfw.posixPoll.fds + _GLFW_POSIX_DEADLINE_FD;
+
+    if (timer->revents)
+    {
+        uint64_t expirations;
+
+        timer->revents = 0;
+
+        if (read(timer->fd, &expirations, sizeof(expirations)) == 8)
+        {
+            const uint64_t deadline = _glfw.posixPoll.deadline;
+            const GLFWdeadlinefun callback = _glfw.posixPoll.deadlineCallback;
+
+            // The deadline is cleared first so the callback can set a new one
+            timer->fd = -1;
+            _glfw.posixPoll.deadline = 0;
+            _glfw.posixPoll.deadlineCallback = NULL;
+
+            if (callback)
+                callback(deadline);
+        }
+    }
+
+    for (int i = 0;  i < _glfw.posixPoll.sourceCount;  )
+    {
+        struct pollfd* source = getSourceFds() + i;
+
+        if (source->revents)
+        {
+            source->revents = 0;
+            _glfw.posixPoll.callbacks[i](source->fd);
+            i = 0;
+        }
+        else
+            i++;
+    }
+}
 
 GLFWbool _glfwPollPOSIX(struct pollfd* fds, nfds_t count, double* timeout)
 {
@@ -79,5 +198,286 @@ GLFWbool _glfwPollPOSIX(struct pollfd* fds, nfds_t count, double* timeout)
     }
 }
 
-#endif // GLFW_BUILD_POSIX_POLL
+// Waits like _glfwPollPOSIX for the specified platform descriptors and also for
+// the event sources and the deadline, calling their callbacks when ready
+// Returns GLFW_FALSE if no platform descriptor is ready, which ends the wait
+// when only event sources or the deadline were
+//
+GLFWbool _glfwWaitPOSIX(struct pollfd* fds, nfds_t count, double* timeout)
+{
+    struct pollfd* all;
+    GLFWbool ready = GLFW_FALSE;
+
+    assert(count <= _GLFW_POSIX_PLATFORM_FDS);
+
+    if (!_glfw.posixPoll.sourceCount && !_glfw.posixPoll.deadline)
+        return _glfwPollPOSIX(fds, count, timeout);
+
+    all = _glfw.posixPoll.fds + _GLFW_POSIX_PLATFORM_FDS - count;
+    if (count)
+        memcpy(all, fds, count * sizeof(struct pollfd));
+
+    _glfw.posixPoll.polled = GLFW_TRUE;
+
+    if (!_glfwPollPOSIX(all, count + 1 + _glfw.posixPoll.sourceCount, timeout))
+        return GLFW_FALSE;
+
+    for (nfds_t i = 0;  i < count;  i++)
+    {
+        fds[i].revents = all[i].revents;
+        if (fds[i].revents)
+            ready = GLFW_TRUE;
+    }
+
+    dispatchEventSources();
+    return ready;
+}
+
+// Calls the callbacks of ready event sources and the expired deadline without
+// waiting, unless the event wait preceding this event processing already did
+//
+void _glfwPollEventSourcesPOSIX(void)
+{
+    double timeout = 0.0;
+
+    if (_glfw.posixPoll.polled)
+    {
+        _glfw.posixPoll.polled = GLFW_FALSE;
+        return;
+    }
+
+    if (!_glfw.posixPoll.sourceCount && !_glfw.posixPoll.deadline)
+        return;
+
+    _glfwWaitPOSIX(NULL, 0, &timeout);
+    _glfw.posixPoll.polled = GLFW_FALSE;
+}
+
+GLFWbool _glfwAddEventSourcePOSIX(int fd, GLFWeventsourcefun callback)
+{
+    int index = findEventSource(fd);
+    if (index == -1)
+    {
+        struct pollfd* source;
+
+        if (!reserveEventSources(_glfw.posixPoll.sourceCount + 1))
+            return GLFW_FALSE;
+
+        index = _glfw.posixPoll.sourceCount++;
+        source = getSourceFds() + index;
+        source->fd = fd;
+        source->events = POLLIN;
+        source->revents = 0;
+    }
+
+    _glfw.posixPoll.callbacks[index] = callback;
+    return GLFW_TRUE;
+}
+
+void _glfwRemoveEventSourcePOSIX(int fd)
+{
+    const int index = findEventSource(fd);
+    if (index == -1)
+        return;
+
+    const int last = --_glfw.posixPoll.sourceCount;
+    getSourceFds()[index] = getSourceFds()[last];
+    _glfw.posixPoll.callbacks[index] = _glfw.posixPoll.callbacks[last];
+}
+
+GLFWbool _glfwSetEventDeadlinePOSIX(uint64_t deadline, GLFWdeadlinefun callback)
+{
+#if defined(__linux__)
+    const uint64_t frequency = _glfw.timer.posix.frequency;
+    struct itimerspec spec = {0};
+
+    if (!reserveEventSources(0))
+        return GLFW_FALSE;
+
+    if (_glfw.posixPoll.timerfd < 0)
+    {
+        if (!deadline)
+            return GLFW_TRUE;
+
+        // The timer value is a reading of this clock, so the deadline can be
+        // used as an absolute timer expiration
+        _glfw.posixPoll.timerfd = timerfd_create(_glfw.timer.posix.clock,
+                                                 TFD_CLOEXEC | TFD_NONBLOCK);
+        if (_glfw.posixPoll.timerfd == -1)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "POSIX: Failed to create deadline timer: %s",
+                            strerror(errno));
+            return GLFW_FALSE;
+        }
+    }
+
+    // A zero expiration disarms the timer
+    spec.it_value.tv_sec = (time_t) (deadline / frequency);
+    spec.it_value.tv_nsec = (long) ((deadline % frequency) * 1000000000 / frequency);
+
+    if (timerfd_settime(_glfw.posixPoll.timerfd, TFD_TIMER_ABSTIME, &spec, NULL) == -1)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "POSIX: Failed to set deadline timer: %s",
+                        strerror(errno));
+        return GLFW_FALSE;
+    }
+
+    _glfw.posixPoll.deadline = deadline;
+    _glfw.posixPoll.deadlineCallback = deadline ? callback : NULL;
+    _glfw.posixPoll.fds[_GLFW_POSIX_DEADLINE_FD].fd =
+        deadline ? _glfw.posixPoll.timerfd : -1;
+    _glfw.posixPoll.fds[_GLFW_POSIX_DEADLINE_FD].revents = 0;
+    return GLFW_TRUE;
+#else
+    _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                    "POSIX: Event deadlines require timerfd");
+    return GLFW_FALSE;
+#endif
+}
+
+// Marks the deadline timer as not yet created, as zero is a valid descriptor
+//
+void _glfwInitEventSourcesPOSIX(void)
+{
+    memset(&_glfw.posixPoll, 0, sizeof(_glfw.posixPoll));
+    _glfw.posixPoll.timerfd = -1;
+}
+
+void _glfwTerminateEventSourcesPOSIX(void)
+{
+    if (_glfw.posixPoll.timerfd >= 0)
+        close(_glfw.posixPoll.timerfd);
+
+    _glfw_free(_glfw.posixPoll.fds);
+    _glfw_free(_glfw.posixPoll.callbacks);
+    _glfwInitEventSourcesPOSIX();
+}
+
+// Marks a wakeup as having no descriptors, so that destroying it before it has
+// been created does nothing
+//
+void _glfwInitWakeupPOSIX(_GLFWwakeupPOSIX* wakeup)
+{
+    wakeup->fds[0] = -1;
+    wakeup->fds[1] = -1;
+    wakeup->pending = 0;
+}
+
+// Creates the descriptors of a wakeup, like the one for empty events, an
+// eventfd where available and otherwise a pipe, without assuming the OS has
+// pipe2(2)
+//
+GLFWbool _glfwCreateWakeupPOSIX(_GLFWwakeupPOSIX* wakeup)
+{
+    _glfwInitWakeupPOSIX(wakeup);
+
+#if defined(__linux__)
+    const int fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (fd == -1)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "POSIX: Failed to create wakeup descriptor: %s",
+                        strerror(errno));
+        return GLFW_FALSE;
+    }
 
+    wakeup->fds[0] = fd;
+    wakeup->fds[1] = fd;
+#else
+    if (pipe(wakeup->fds) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "POSIX: Failed to create wakeup pipe: %s",
+                        strerror(errno));
+        _glfwInitWakeupPOSIX(wakeup);
+        return GLFW_FALSE;
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        const int sf = fcntl(wakeup->fds[i], F_GETFL, 0);
+        const int df = fcntl(wakeup->fds[i], F_GETFD, 0);
+
+        if (sf == -1 || df == -1 ||
+            fcntl(wakeup->fds[i], F_SETFL, sf | O_NONBLOCK) == -1 ||
+            fcntl(wakeup->fds[i], F_SETFD, df | FD_CLOEXEC) == -1)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "POSIX: Failed to set flags for wakeup pipe: %s",
+                            strerror(errno));
+            _glfwDestroyWakeupPOSIX(wakeup);
+            return GLFW_FALSE;
+        }
+    }
+#endif
+
+    __atomic_store_n(&wakeup->pending, 0, __ATOMIC_RELAXED);
+    return GLFW_TRUE;
+}
+
+void _glfwDestroyWakeupPOSIX(_GLFWwakeupPOSIX* wakeup)
+{
+    if (wakeup->fds[0] >= 0)
+        close(wakeup->fds[0]);
+    if (wakeup->fds[1] >= 0 && wakeup->fds[1] != wakeup->fds[0])
+        close(wakeup->fds[1]);
+
+    _glfwInitWakeupPOSIX(wakeup);
+}
+
+// Makes the wakeup descriptor readable, unless an earlier post has not yet
+// been consumed by the waiting thread, in which case this one would only cost
+// a system call and wake it up for the same reason
+//
+void _glfwPostWakeupPOSIX(_GLFWwakeupPOSIX* wakeup)
+{
+    if (__atomic_exchange_n(&wakeup->pending, 1, __ATOMIC_ACQ_REL))
+        return;
+
+    for (;;)
+    {
+#if defined(__linux__)
+        const uint64_t value = 1;
+#else
+        const char value = 0;
+#endif
+        const ssize_t result = write(wakeup->fds[1], &value, sizeof(value));
+        if (result == sizeof(value) || (result == -1 && errno != EINTR))
+            break;
+    }
+}
+
+// Consumes a posted wakeup, if any, so the descriptor stops being readable
+// and the next post writes to it again
+//
+void _glfwConsumeWakeupPOSIX(_GLFWwakeupPOSIX* wakeup)
+{
+    // Nothing can have been written unless the flag is set
+    if (!__atomic_load_n(&wakeup->pending, __ATOMIC_ACQUIRE))
+        return;
+
+    for (;;)
+    {
+#if defined(__linux__)
+        uint64_t value;
+#else
+        char value[64];
+#endif
+        const ssize_t result = read(wakeup->fds[0], &value, sizeof(value));
+        if (result > 0)
+            break;
+
+        // The poster has set the flag but not yet written, so leave it set
+        // and let the descriptor wake the next wait instead
+        if (result == -1 && errno != EINTR)
+            return;
+    }
+
+    // Posts that find the flag still set until here are covered by the wakeup
+    // just consumed, and the exchange makes what they did before visible
+    __atomic_exchange_n(&wakeup->pending, 0, __ATOMIC_ACQ_REL);
+}
+
+#endif // GLFW_BUILD_POSIX_POLL
@@ -26,5 +26,57 @@
 
 #include <poll.h>
 
+#define GLFW_POSIX_LIBRARY_POLL_STATE \
+        _GLFWpollPOSIX posixPoll; \
+        _GLFWwakeupPOSIX posixWakeup;
+
+// Number of slots reserved for platform file descriptors in front of the
+// event sources
+#define _GLFW_POSIX_PLATFORM_FDS 5
+// Slot of the deadline timer, between the platform descriptors and the event
+// sources
+#define _GLFW_POSIX_DEADLINE_FD _GLFW_POSIX_PLATFORM_FDS
+
+
+// POSIX-specific global event source data
+//
+typedef struct _GLFWpollPOSIX
+{
+    // Platform descriptors, the deadline timer and then the event sources
+    struct pollfd*      fds;
+    GLFWeventsourcefun* callbacks;
+    int                 sourceCount;
+    int                 sourceCapacity;
+    int                 timerfd;
+    uint64_t            deadline;
+    GLFWdeadlinefun     deadlineCallback;
+    // Whether the event sources were polled since the last event processing
+    GLFWbool            polled;
+} _GLFWpollPOSIX;
+
+// POSIX-specific wakeup data, used for empty events
+//
+typedef struct _GLFWwakeupPOSIX
+{
+    // Read and write ends, the same eventfd on Linux and a pipe elsewhere
+    int                 fds[2];
+    // Set by the first post since the wakeup was last consumed,
+    // accessed only with atomic builtins
+    int                 pending;
+} _GLFWwakeupPOSIX;
+
+
 GLFWbool _glfwPollPOSIX(struct pollfd* fds, nfds_t count, double* timeout);
+GLFWbool _glfwWaitPOSIX(struct pollfd* fds, nfds_t count, double* timeout);
+void _glfwPollEventSourcesPOSIX(void);
+GLFWbool _glfwAddEventSourcePOSIX(int fd, GLFWeventsourcefun callback);
+void _glfwRemoveEventSourcePOSIX(int fd);
+GLFWbool _glfwSetEventDeadlinePOSIX(uint64_t deadline, GLFWdeadlinefun callback);
+void _glfwInitEventSourcesPOSIX(void);
+void _glfwTerminateEventSourcesPOSIX(void);
+void _glfwInitWakeupPOSIX(_GLFWwakeupPOSIX* wakeup);
+GLFWbool _glfwCreateWakeupPOSIX(_GLFWwakeupPOSIX* wakeup);
+void _glfwDestroyWakeupPOSIX(_GLFWwakeupPOSIX* wakeup);
+void _glfwPostWakeupPOSIX(_GLFWwakeupPOSIX* wakeup);
+void _glfwConsumeWakeupPOSIX(_GLFWwakeupPOSIX* wakeup);
 
@@ -33,6 +33,48 @@
 #include <sys/time.h>
 
 
+// Event timestamps older than this are assumed to come from another clock
+//
+#define _GLFW_MAX_EVENT_AGE_MS 10000
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Converts a CLOCK_MONOTONIC time in nanoseconds, like evdev timestamps, to a
+// timer value, or returns the current timer value if the timer uses another
+// clock
+//
+uint64_t _glfwTimerValueFromMonotonicPOSIX(uint64_t nanoseconds)
+{
+    if (_glfw.timer.posix.clock != CLOCK_MONOTONIC)
+        return _glfwPlatformGetTimerValue();
+
+    return nanoseconds;
+}
+
+// Converts a wrapping 32-bit CLOCK_MONOTONIC time in milliseconds, like X11 and
+// Wayland event times, to a timer value.  Times from the future or too far in
+// the past, like those of a remote X server, are replaced by the current time.
+//
+uint64_t _glfwTimerValueFromMillisecondsPOSIX(uint32_t milliseconds)
+{
+    const uint64_t now = _glfwPlatformGetTimerValue();
+    uint32_t age;
+
+    if (_glfw.timer.posix.clock != CLOCK_MONOTONIC)
+        return now;
+
+    // Unsigned subtraction handles the wrap-around every 49.7 days
+    age = (uint32_t) (now / 1000000) - milliseconds;
+    if (age > _GLFW_MAX_EVENT_AGE_MS)
+        return now;
+
+    return now - now % 1000000 - (uint64_t) age * 1000000;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
 //////////////////////////////////////////////////////////////////////////
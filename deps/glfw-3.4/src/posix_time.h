@@ -39,3 +39,7 @@ typedef struct _GLFWtimerPOSIX
     uint64_t    frequency;
 } _GLFWtimerPOSIX;
 
+
+uint64_t _glfwTimerValueFromMonotonicPOSIX(uint64_t nanoseconds);
+uint64_t _glfwTimerValueFromMillisecondsPOSIX(uint32_t milliseconds);
+
@@ -0,0 +1,112 @@
+//========================================================================
+// GLFW 3.4 Win32 - www.glfw.org
+//------------------------------------------------------------------------
+// Copyright (c) 2026 The Computer Graphics HW1 authors
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+
+#include "internal.h"
+
+#if defined(GLFW_BUILD_WIN32_FILE)
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW platform API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWbool _glfwPlatformMapFile(const char* path, void** data, size_t* size)
+{
+    HANDLE file, mapping;
+    LARGE_INTEGER length;
+    WCHAR* wpath;
+
+    // This is built for the null platform as well, without the Win32 helpers
+    const int count = MultiByteToWideChar(CP_UTF8, 0, path, -1, NULL, 0);
+    if (!count)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Win32: Failed to convert path from UTF-8");
+        return GLFW_FALSE;
+    }
+
+    wpath = _glfw_calloc(count, sizeof(WCHAR));
+    if (!wpath)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
+
+    MultiByteToWideChar(CP_UTF8, 0, path, -1, wpath, count);
+
+    file = CreateFileW(wpath, GENERIC_READ, FILE_SHARE_READ, NULL,
+                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    _glfw_free(wpath);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Win32: Failed to open %s", path);
+        return GLFW_FALSE;
+    }
+
+    if (!GetFileSizeEx(file, &length))
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Win32: Failed to query size of %s", path);
+        CloseHandle(file);
+        return GLFW_FALSE;
+    }
+
+    *data = NULL;
+    *size = (size_t) length.QuadPart;
+
+    // Empty files cannot be mapped
+    if (*size)
+    {
+        mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping)
+        {
+            *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+
+        if (!*data)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Win32: Failed to map %s", path);
+            CloseHandle(file);
+            return GLFW_FALSE;
+        }
+    }
+
+    CloseHandle(file);
+    return GLFW_TRUE;
+}
+
+void _glfwPlatformUnmapFile(void* data, size_t size)
+{
+    if (size)
+        UnmapViewOfFile(data);
+}
+
+#endif // GLFW_BUILD_WIN32_FILE
+
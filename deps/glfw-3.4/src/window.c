@@ -173,6 +173,127 @@ void _glfwInputWindowMonitor(_GLFWwindow* window, _GLFWmonitor* monitor)
     window->monitor = monitor;
 }
 
+// Returns whether the current platform waits for event sources, emitting an
+// error if it does not
+//
+static GLFWbool eventSourcesSupported(void)
+{
+#if defined(GLFW_BUILD_POSIX_POLL)
+    if (_glfw.platform.platformID == GLFW_PLATFORM_X11 ||
+        _glfw.platform.platformID == GLFW_PLATFORM_WAYLAND ||
+        _glfw.platform.platformID == GLFW_PLATFORM_NULL)
+    {
+        return GLFW_TRUE;
+    }
+#endif
+
+    _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                    "Event sources are not supported by the current platform");
+    return GLFW_FALSE;
+}
+
+// Links a user event in at the head of the queue, from any thread
+//
+static void pushUserEvent(_GLFWuserevent* event)
+{
+    _GLFWuserevent* previous;
+
+    event->next = NULL;
+    previous = _glfwExchangePointer(&_glfw.userEvents.head, event);
+    _glfwStorePointer(&previous->next, event);
+}
+
+// Removes the oldest user event from the tail of the queue, or returns NULL
+// if there is none or the oldest is still being linked in by its poster
+//
+static _GLFWuserevent* popUserEvent(void)
+{
+    _GLFWuserevent* stub = &_glfw.userEvents.stub;
+    _GLFWuserevent* tail = _glfw.userEvents.tail;
+    _GLFWuserevent* next = _glfwLoadPointer(&tail->next);
+
+    if (tail == stub)
+    {
+        if (!next)
+            return NULL;
+
+        _glfw.userEvents.tail = next;
+        tail = next;
+        next = _glfwLoadPointer(&tail->next);
+    }
+
+    if (next)
+    {
+        _glfw.userEvents.tail = next;
+        return tail;
+    }
+
+    // A post that has already replaced the head but not yet linked itself
+    // wakes up event processing again when it is done
+    if (tail != _glfwLoadPointer(&_glfw.userEvents.head))
+        return NULL;
+
+    // The last event can only be removed with the stub behind it
+    pushUserEvent(stub);
+
+    next = _glfwLoadPointer(&tail->next);
+    if (next)
+    {
+        _glfw.userEvents.tail = next;
+        return tail;
+    }
+
+    return NULL;
+}
+
+// Delivers the user events posted before event processing got here, to the
+// callback or else to the event queue
+//
+static void dispatchUserEvents(void)
+{
+    _GLFWuserevent* stub = &_glfw.userEvents.stub;
+    _GLFWuserevent* last = _glfwLoadPointer(&_glfw.userEvents.head);
+    uint64_t time = 0;
+
+    for (;;)
+    {
+        _GLFWuserevent* event;
+        GLFWbool done;
+
+        // Events behind a stub that was the head are newer than this dispatch
+        if (_glfw.userEvents.tail == stub && last == stub)
+            break;
+
+        event = popUserEvent();
+        if (!event)
+            break;
+
+        if (_glfw.callbacks.userEvent)
+            _glfw.callbacks.userEvent(event->type, event->payload);
+        else
+        {
+            GLFWevent* queued = _glfwPushEvent(NULL, GLFW_EVENT_USER);
+            if (queued)
+            {
+                // Posts are not timestamped, as reading the timer would cost
+                // more than the rest of posting
+                if (!time)
+                    time = _glfwPlatformGetTimerValue();
+
+                queued->time = time;
+                queued->data.user.type = event->type;
+                queued->data.user.payload = event->payload;
+            }
+        }
+
+        done = event == last;
+        _glfw_free(event);
+
+        if (done)
+            break;
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 //////                        GLFW public API                       //////
 //////////////////////////////////////////////////////////////////////////
@@ -233,6 +354,7 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
     window->focusOnShow      = wndconfig.focusOnShow;
     window->mousePassthrough = wndconfig.mousePassthrough;
     window->cursorMode       = GLFW_CURSOR_NORMAL;
+    window->eventQueue       = _glfw.hints.init.eventQueue;
 
     window->doublebuffer = fbconfig.doublebuffer;
 
@@ -485,6 +607,9 @@ GLFWAPI void glfwDestroyWindow(GLFWwindow* handle)
 
     _glfw.platform.destroyWindow(window);
 
+    // Drop queued events that would refer to the destroyed window
+    _glfwRemoveEvents(window);
+
     // Unlink window from global linked list
     {
         _GLFWwindow** prev = &_glfw.windowListHead;
@@ -1140,12 +1265,16 @@ GLFWAPI void glfwPollEvents(void)
 {
     _GLFW_REQUIRE_INIT();
     _glfw.platform.pollEvents();
+    _glfwFlushCursorMotion();
+    dispatchUserEvents();
 }
 
 GLFWAPI void glfwWaitEvents(void)
 {
     _GLFW_REQUIRE_INIT();
     _glfw.platform.waitEvents();
+    _glfwFlushCursorMotion();
+    dispatchUserEvents();
 }
 
 GLFWAPI void glfwWaitEventsTimeout(double timeout)
@@ -1162,6 +1291,8 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout)
     }
 
     _glfw.platform.waitEventsTimeout(timeout);
+    _glfwFlushCursorMotion();
+    dispatchUserEvents();
 }
 
 GLFWAPI void glfwPostEmptyEvent(void)
@@ -1170,3 +1301,76 @@ GLFWAPI void glfwPostEmptyEvent(void)
     _glfw.platform.postEmptyEvent();
 }
 
+GLFWAPI void glfwPostUserEvent(int type, void* payload)
+{
+    _GLFWuserevent* event;
+
+    _GLFW_REQUIRE_INIT();
+
+    event = _glfw_calloc(1, sizeof(_GLFWuserevent));
+    if (!event)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return;
+    }
+
+    event->type = type;
+    event->payload = payload;
+
+    pushUserEvent(event);
+    _glfw.platform.postEmptyEvent();
+}
+
+GLFWAPI GLFWusereventfun glfwSetUserEventCallback(GLFWusereventfun cbfun)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP(GLFWusereventfun, _glfw.callbacks.userEvent, cbfun);
+    return cbfun;
+}
+
+GLFWAPI int glfwAddEventSource(int fd, GLFWeventsourcefun callback)
+{
+    assert(fd >= 0);
+    assert(callback != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (fd < 0 || !callback)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid event source %i", fd);
+        return GLFW_FALSE;
+    }
+
+    if (!eventSourcesSupported())
+        return GLFW_FALSE;
+
+#if defined(GLFW_BUILD_POSIX_POLL)
+    return _glfwAddEventSourcePOSIX(fd, callback);
+#else
+    return GLFW_FALSE;
+#endif
+}
+
+GLFWAPI void glfwRemoveEventSource(int fd)
+{
+    _GLFW_REQUIRE_INIT();
+
+#if defined(GLFW_BUILD_POSIX_POLL)
+    _glfwRemoveEventSourcePOSIX(fd);
+#endif
+}
+
+GLFWAPI int glfwSetEventDeadline(uint64_t deadline, GLFWdeadlinefun callback)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!eventSourcesSupported())
+        return GLFW_FALSE;
+
+#if defined(GLFW_BUILD_POSIX_POLL)
+    return _glfwSetEventDeadlinePOSIX(deadline, callback);
+#else
+    return GLFW_FALSE;
+#endif
+}
+
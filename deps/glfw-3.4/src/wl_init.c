@@ -859,6 +859,9 @@ int _glfwInitWayland(void)
             timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
     }
 
+    if (!_glfwCreateWakeupPOSIX(&_glfw.posixWakeup))
+        return GLFW_FALSE;
+
     if (!_glfw.wl.wmBase)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -996,6 +999,8 @@ void _glfwTerminateWayland(void)
     if (_glfw.wl.cursorTimerfd >= 0)
         close(_glfw.wl.cursorTimerfd);
 
+    _glfwDestroyWakeupPOSIX(&_glfw.posixWakeup);
+
     _glfw_free(_glfw.wl.clipboardString);
 }
 
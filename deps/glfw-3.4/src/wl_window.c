@@ -1210,13 +1210,14 @@ static void handleEvents(double* timeout)
 #endif
 
     GLFWbool event = GLFW_FALSE;
-    enum { DISPLAY_FD, KEYREPEAT_FD, CURSOR_FD, LIBDECOR_FD };
+    enum { DISPLAY_FD, KEYREPEAT_FD, CURSOR_FD, LIBDECOR_FD, WAKEUP_FD };
     struct pollfd fds[] =
     {
         [DISPLAY_FD] = { wl_display_get_fd(_glfw.wl.display), POLLIN },
         [KEYREPEAT_FD] = { _glfw.wl.keyRepeatTimerfd, POLLIN },
         [CURSOR_FD] = { _glfw.wl.cursorTimerfd, POLLIN },
-        [LIBDECOR_FD] = { -1, POLLIN }
+        [LIBDECOR_FD] = { -1, POLLIN },
+        [WAKEUP_FD] = { _glfw.posixWakeup.fds[0], POLLIN }
     };
 
     if (_glfw.wl.libdecor.context)
@@ -1246,7 +1247,7 @@ static void handleEvents(double* timeout)
             return;
         }
 
-        if (!_glfwPollPOSIX(fds, sizeof(fds) / sizeof(fds[0]), timeout))
+        if (!_glfwWaitPOSIX(fds, sizeof(fds) / sizeof(fds[0]), timeout))
         {
             wl_display_cancel_read(_glfw.wl.display);
             return;
@@ -1294,6 +1295,12 @@ static void handleEvents(double* timeout)
             if (libdecor_dispatch(_glfw.wl.libdecor.context, 0) > 0)
                 event = GLFW_TRUE;
         }
+
+        if (fds[WAKEUP_FD].revents & POLLIN)
+        {
+            _glfwConsumeWakeupPOSIX(&_glfw.posixWakeup);
+            event = GLFW_TRUE;
+        }
     }
 }
 
@@ -1446,7 +1453,9 @@ static void pointerHandleMotion(void* userData,
     if (window->wl.hovered)
     {
         _glfw.wl.cursorPreviousName = NULL;
+        _glfw.eventTime = _glfwTimerValueFromMillisecondsPOSIX(time);
         _glfwInputCursorPos(window, xpos, ypos);
+        _glfw.eventTime = 0;
         return;
     }
 
@@ -1542,10 +1551,12 @@ static void pointerHandleButton(void* userData,
     {
         _glfw.wl.serial = serial;
 
+        _glfw.eventTime = _glfwTimerValueFromMillisecondsPOSIX(time);
         _glfwInputMouseClick(window,
                              button - BTN_LEFT,
                              state == WL_POINTER_BUTTON_STATE_PRESSED,
                              _glfw.wl.xkb.modifiers);
+        _glfw.eventTime = 0;
         return;
     }
 
@@ -1615,11 +1626,15 @@ static void pointerHandleAxis(void* userData,
     if (!window)
         return;
 
+    _glfw.eventTime = _glfwTimerValueFromMillisecondsPOSIX(time);
+
     // NOTE: 10 units of motion per mouse wheel step seems to be a common ratio
     if (axis == WL_POINTER_AXIS_HORIZONTAL_SCROLL)
         _glfwInputScroll(window, -wl_fixed_to_double(value) / 10.0, 0.0);
     else if (axis == WL_POINTER_AXIS_VERTICAL_SCROLL)
         _glfwInputScroll(window, 0.0, -wl_fixed_to_double(value) / 10.0);
+
+    _glfw.eventTime = 0;
 }
 
 static const struct wl_pointer_listener pointerListener =
@@ -1801,10 +1816,13 @@ static void keyboardHandleKey(void* userData,
 
     timerfd_settime(_glfw.wl.keyRepeatTimerfd, 0, &timer, NULL);
 
+    _glfw.eventTime = _glfwTimerValueFromMillisecondsPOSIX(time);
     _glfwInputKey(window, key, scancode, action, _glfw.wl.xkb.modifiers);
 
     if (action == GLFW_PRESS)
         inputText(window, scancode);
+
+    _glfw.eventTime = 0;
 }
 
 static void keyboardHandleModifiers(void* userData,
@@ -2639,22 +2657,24 @@ void _glfwPollEventsWayland(void)
 {
     double timeout = 0.0;
     handleEvents(&timeout);
+    _glfwPollEventSourcesPOSIX();
 }
 
 void _glfwWaitEventsWayland(void)
 {
     handleEvents(NULL);
+    _glfwPollEventSourcesPOSIX();
 }
 
 void _glfwWaitEventsTimeoutWayland(double timeout)
 {
     handleEvents(&timeout);
+    _glfwPollEventSourcesPOSIX();
 }
 
 void _glfwPostEmptyEventWayland(void)
 {
-    wl_display_sync(_glfw.wl.display);
-    flushDisplay();
+    _glfwPostWakeupPOSIX(&_glfw.posixWakeup);
 }
 
 void _glfwGetCursorPosWayland(_GLFWwindow* window, double* xpos, double* ypos)
@@ -2891,7 +2911,11 @@ static void relativePointerHandleRelativeMotion(void* userData,
         ypos += wl_fixed_to_double(dy);
     }
 
+    // The relative motion time is in microseconds
+    const uint64_t time = ((uint64_t) timeHi << 32) | timeLo;
+    _glfw.eventTime = _glfwTimerValueFromMonotonicPOSIX(time * 1000);
     _glfwInputCursorPos(window, xpos, ypos);
+    _glfw.eventTime = 0;
 }
 
 static const struct zwp_relative_pointer_v1_listener relativePointerListener =
@@ -35,7 +35,6 @@
 #include <stdio.h>
 #include <locale.h>
 #include <unistd.h>
-#include <fcntl.h>
 #include <errno.h>
 #include <assert.h>
 
@@ -748,7 +747,10 @@ static GLFWbool initExtensions(void)
 
     if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
     {
+        // NOTE: Screen and CRTC changes invalidate the cached monitor state
         XRRSelectInput(_glfw.x11.display, _glfw.x11.root,
+                       RRScreenChangeNotifyMask |
+                       RRCrtcChangeNotifyMask |
                        RROutputChangeNotifyMask);
     }
 
@@ -1045,48 +1047,187 @@ static Window createHelperWindow(void)
                          CWEventMask, &wa);
 }
 
-// Create the pipe for empty events without assumuing the OS has pipe2(2)
+// X error handler
 //
-static GLFWbool createEmptyEventPipe(void)
+static int errorHandler(Display *display, XErrorEvent* event)
 {
-    if (pipe(_glfw.x11.emptyEventPipe) != 0)
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "X11: Failed to create empty event pipe: %s",
-                        strerror(errno));
-        return GLFW_FALSE;
-    }
+    if (_glfw.x11.display != display)
+        return 0;
+
+    _glfw.x11.errorCode = event->error_code;
+    return 0;
+}
+
+// Returns the statistics entry for the specified call site, adding it if new
+//
+static _GLFWreplysiteX11* findReplySite(const char* name, const char* file, int line)
+{
+    _GLFWstatisticsX11* stats = _glfw.x11.statistics;
+    // The last entry is left for the call sites that do not fit
+    const int count = _GLFW_X11_REPLY_SITES - 1;
 
-    for (int i = 0; i < 2; i++)
+    for (int i = 0;  i < count;  i++)
     {
-        const int sf = fcntl(_glfw.x11.emptyEventPipe[i], F_GETFL, 0);
-        const int df = fcntl(_glfw.x11.emptyEventPipe[i], F_GETFD, 0);
+        _GLFWreplysiteX11* site = stats->sites + (line + i) % count;
+        if (!site->file)
+        {
+            site->name = name;
+            site->file = file;
+            site->line = line;
+            return site;
+        }
 
-        if (sf == -1 || df == -1 ||
-            fcntl(_glfw.x11.emptyEventPipe[i], F_SETFL, sf | O_NONBLOCK) == -1 ||
-            fcntl(_glfw.x11.emptyEventPipe[i], F_SETFD, df | FD_CLOEXEC) == -1)
+        if (site->line == line &&
+            (site->name == name || strcmp(site->name, name) == 0) &&
+            (site->file == file || strcmp(site->file, file) == 0))
         {
-            _glfwInputError(GLFW_PLATFORM_ERROR,
-                            "X11: Failed to set flags for empty event pipe: %s",
-                            strerror(errno));
-            return GLFW_FALSE;
+            return site;
         }
     }
 
-    return GLFW_TRUE;
+    return stats->sites + count;
 }
 
-// X error handler
+// Sorts call sites by time spent waiting, longest first
 //
-static int errorHandler(Display *display, XErrorEvent* event)
+static int compareReplySites(const void* fp, const void* sp)
 {
-    if (_glfw.x11.display != display)
-        return 0;
+    const _GLFWreplysiteX11* fs = *((const _GLFWreplysiteX11**) fp);
+    const _GLFWreplysiteX11* ss = *((const _GLFWreplysiteX11**) sp);
+
+    if (fs->time != ss->time)
+        return fs->time < ss->time ? 1 : -1;
+    if (fs->count != ss->count)
+        return fs->count < ss->count ? 1 : -1;
 
-    _glfw.x11.errorCode = event->error_code;
     return 0;
 }
 
+// Returns the name of the specified event type, or NULL if unknown
+//
+static const char* getEventName(int type)
+{
+    static const char* names[LASTEvent] =
+    {
+        [KeyPress] = "KeyPress",
+        [KeyRelease] = "KeyRelease",
+        [ButtonPress] = "ButtonPress",
+        [ButtonRelease] = "ButtonRelease",
+        [MotionNotify] = "MotionNotify",
+        [EnterNotify] = "EnterNotify",
+        [LeaveNotify] = "LeaveNotify",
+        [FocusIn] = "FocusIn",
+        [FocusOut] = "FocusOut",
+        [KeymapNotify] = "KeymapNotify",
+        [Expose] = "Expose",
+        [GraphicsExpose] = "GraphicsExpose",
+        [NoExpose] = "NoExpose",
+        [VisibilityNotify] = "VisibilityNotify",
+        [CreateNotify] = "CreateNotify",
+        [DestroyNotify] = "DestroyNotify",
+        [UnmapNotify] = "UnmapNotify",
+        [MapNotify] = "MapNotify",
+        [MapRequest] = "MapRequest",
+        [ReparentNotify] = "ReparentNotify",
+        [ConfigureNotify] = "ConfigureNotify",
+        [ConfigureRequest] = "ConfigureRequest",
+        [GravityNotify] = "GravityNotify",
+        [ResizeRequest] = "ResizeRequest",
+        [CirculateNotify] = "CirculateNotify",
+        [CirculateRequest] = "CirculateRequest",
+        [PropertyNotify] = "PropertyNotify",
+        [SelectionClear] = "SelectionClear",
+        [SelectionRequest] = "SelectionRequest",
+        [SelectionNotify] = "SelectionNotify",
+        [ColormapNotify] = "ColormapNotify",
+        [ClientMessage] = "ClientMessage",
+        [MappingNotify] = "MappingNotify",
+        [GenericEvent] = "GenericEvent"
+    };
+
+    if (type < LASTEvent)
+        return names[type];
+
+    if (_glfw.x11.randr.available)
+    {
+        if (type == _glfw.x11.randr.eventBase + RRScreenChangeNotify)
+            return "RRScreenChangeNotify";
+        if (type == _glfw.x11.randr.eventBase + RRNotify)
+            return "RRNotify";
+    }
+
+    if (_glfw.x11.xkb.available)
+    {
+        if (type == _glfw.x11.xkb.eventBase + XkbEventCode)
+            return "XkbEvent";
+    }
+
+    return NULL;
+}
+
+// Prints the recorded connection statistics to stderr
+//
+static void printStatistics(void)
+{
+    _GLFWstatisticsX11* stats = _glfw.x11.statistics;
+    _GLFWreplysiteX11* sites[_GLFW_X11_REPLY_SITES];
+    const double frequency = (double) _glfwPlatformGetTimerFrequency();
+    const uint64_t elapsed = _glfwPlatformGetTimerValue() - stats->start;
+    uint64_t blocked = 0;
+    int siteCount = 0;
+
+    for (int i = 0;  i < _GLFW_X11_REPLY_SITES;  i++)
+    {
+        if (stats->sites[i].count)
+        {
+            sites[siteCount++] = stats->sites + i;
+            blocked += stats->sites[i].time;
+        }
+    }
+
+    qsort(sites, siteCount, sizeof(sites[0]), compareReplySites);
+
+    fprintf(stderr, "GLFW X11 statistics over %.3f s\n", elapsed / frequency);
+    fprintf(stderr, "  %lu round trips, %.3f ms blocked, %lu flushes\n",
+            _glfw.x11.roundTrips, blocked * 1e3 / frequency, _glfw.x11.flushes);
+
+    if (siteCount)
+        fprintf(stderr, "  Round trips by call site:\n");
+
+    for (int i = 0;  i < siteCount;  i++)
+    {
+        const _GLFWreplysiteX11* site = sites[i];
+        char location[64];
+
+        if (site->file)
+        {
+            const char* file = strrchr(site->file, '/');
+            snprintf(location, sizeof(location), "%s:%i",
+                     file ? file + 1 : site->file, site->line);
+        }
+        else
+            snprintf(location, sizeof(location), "other call sites");
+
+        fprintf(stderr, "    %-24s %-28s %8lu %10.3f ms\n",
+                location, site->name ? site->name : "",
+                site->count, site->time * 1e3 / frequency);
+    }
+
+    fprintf(stderr, "  Events by type:\n");
+
+    for (int type = 0;  type < 128;  type++)
+    {
+        if (!stats->events[type])
+            continue;
+
+        const char* name = getEventName(type);
+        if (name)
+            fprintf(stderr, "    %-24s %8lu\n", name, stats->events[type]);
+        else
+            fprintf(stderr, "    event %-18i %8lu\n", type, stats->events[type]);
+    }
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -1157,6 +1298,52 @@ Cursor _glfwCreateNativeCursorX11(const GLFWimage* image, int xhot, int yhot)
     return cursor;
 }
 
+// Records the start of a call to an Xlib function that waits for a reply
+//
+void _glfwBeginReplyX11(const char* name, const char* file, int line)
+{
+    _GLFWstatisticsX11* stats = _glfw.x11.statistics;
+    if (!stats)
+        return;
+
+    // NOTE: Calls nested deeper than this are counted but not timed
+    if (stats->depth < _GLFW_X11_REPLY_DEPTH)
+    {
+        stats->calls[stats->depth].site = findReplySite(name, file, line);
+        stats->calls[stats->depth].start = _glfwPlatformGetTimerValue();
+    }
+
+    stats->depth++;
+}
+
+// Records the end of a call to an Xlib function that waits for a reply and
+// passes on its result
+//
+unsigned long _glfwEndReplyX11(unsigned long result)
+{
+    _GLFWstatisticsX11* stats = _glfw.x11.statistics;
+
+    _glfw.x11.roundTrips++;
+
+    if (stats && --stats->depth < _GLFW_X11_REPLY_DEPTH)
+    {
+        _GLFWreplysiteX11* site = stats->calls[stats->depth].site;
+        site->count++;
+        site->time += _glfwPlatformGetTimerValue() - stats->calls[stats->depth].start;
+    }
+
+    return result;
+}
+
+// Records the end of a call to an Xlib function that waits for a reply and
+// passes on its pointer result
+//
+void* _glfwEndReplyPointerX11(void* result)
+{
+    _glfwEndReplyX11(0);
+    return result;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -1409,6 +1596,8 @@ int _glfwInitX11(void)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XIconifyWindow");
     _glfw.x11.xlib.InternAtom = (PFN_XInternAtom)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XInternAtom");
+    _glfw.x11.xlib.LockDisplay = (PFN_XLockDisplay)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XLockDisplay");
     _glfw.x11.xlib.LookupString = (PFN_XLookupString)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XLookupString");
     _glfw.x11.xlib.MapRaised = (PFN_XMapRaised)
@@ -1477,6 +1666,8 @@ int _glfwInitX11(void)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XUndefineCursor");
     _glfw.x11.xlib.UngrabPointer = (PFN_XUngrabPointer)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XUngrabPointer");
+    _glfw.x11.xlib.UnlockDisplay = (PFN_XUnlockDisplay)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XUnlockDisplay");
     _glfw.x11.xlib.UnmapWindow = (PFN_XUnmapWindow)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XUnmapWindow");
     _glfw.x11.xlib.UnsetICFocus = (PFN_XUnsetICFocus)
@@ -1521,13 +1712,23 @@ int _glfwInitX11(void)
     if (_glfw.x11.xlib.utf8LookupString && _glfw.x11.xlib.utf8SetWMProperties)
         _glfw.x11.xlib.utf8 = GLFW_TRUE;
 
+    if (_glfw.hints.init.x11.statistics)
+    {
+        // NOTE: The timer is otherwise only set up after platform initialization
+        _glfwPlatformInitTimer();
+
+        _glfw.x11.statistics = _glfw_calloc(1, sizeof(_GLFWstatisticsX11));
+        if (_glfw.x11.statistics)
+            _glfw.x11.statistics->start = _glfwPlatformGetTimerValue();
+    }
+
     _glfw.x11.screen = DefaultScreen(_glfw.x11.display);
     _glfw.x11.root = RootWindow(_glfw.x11.display, _glfw.x11.screen);
     _glfw.x11.context = XUniqueContext();
 
     getSystemContentScale(&_glfw.x11.contentScaleX, &_glfw.x11.contentScaleY);
 
-    if (!createEmptyEventPipe())
+    if (!_glfwCreateWakeupPOSIX(&_glfw.posixWakeup))
         return GLFW_FALSE;
 
     if (!initExtensions())
@@ -1548,11 +1749,23 @@ int _glfwInitX11(void)
     }
 
     _glfwPollMonitorsX11();
+
+    if (_glfw.hints.init.x11.eventThread)
+        _glfwStartEventThreadX11();
+
     return GLFW_TRUE;
 }
 
 void _glfwTerminateX11(void)
 {
+    _glfwStopEventThreadX11();
+
+    if (_glfw.x11.randr.resources)
+    {
+        XRRFreeScreenResources(_glfw.x11.randr.resources);
+        _glfw.x11.randr.resources = NULL;
+    }
+
     if (_glfw.x11.helperWindowHandle)
     {
         if (XGetSelectionOwner(_glfw.x11.display, _glfw.x11.CLIPBOARD) ==
@@ -1645,10 +1858,13 @@ void _glfwTerminateX11(void)
         _glfw.x11.xlib.handle = NULL;
     }
 
-    if (_glfw.x11.emptyEventPipe[0] || _glfw.x11.emptyEventPipe[1])
+    _glfwDestroyWakeupPOSIX(&_glfw.posixWakeup);
+
+    if (_glfw.x11.statistics)
     {
-        close(_glfw.x11.emptyEventPipe[0]);
-        close(_glfw.x11.emptyEventPipe[1]);
+        printStatistics();
+        _glfw_free(_glfw.x11.statistics);
+        _glfw.x11.statistics = NULL;
     }
 }
 
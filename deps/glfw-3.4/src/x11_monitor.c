@@ -92,6 +92,85 @@ static GLFWvidmode vidmodeFromModeInfo(const XRRModeInfo* mi,
 }
 
 
+// Returns the screen resources, querying them if changed since last time
+//
+static XRRScreenResources* getScreenResources(void)
+{
+    if (!_glfw.x11.randr.resources)
+    {
+        _glfw.x11.randr.resources =
+            XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
+    }
+
+    return _glfw.x11.randr.resources;
+}
+
+// Returns the CRTC info of the monitor, querying it if changed since last time
+//
+static XRRCrtcInfo* getCrtcInfo(_GLFWmonitor* monitor)
+{
+    if (!monitor->x11.crtcInfo)
+    {
+        monitor->x11.crtcInfo = XRRGetCrtcInfo(_glfw.x11.display,
+                                               getScreenResources(),
+                                               monitor->x11.crtc);
+    }
+
+    return monitor->x11.crtcInfo;
+}
+
+// Returns the output info of the monitor, querying it if changed since last
+// time
+//
+static XRROutputInfo* getOutputInfo(_GLFWmonitor* monitor)
+{
+    if (!monitor->x11.outputInfo)
+    {
+        monitor->x11.outputInfo = XRRGetOutputInfo(_glfw.x11.display,
+                                                   getScreenResources(),
+                                                   monitor->x11.output);
+    }
+
+    return monitor->x11.outputInfo;
+}
+
+// Returns the gamma ramp size of the monitor, querying it if changed since
+// last time
+//
+static int getGammaSize(_GLFWmonitor* monitor)
+{
+    // NOTE: A size of zero is cached too, as CRTCs without gamma report it
+    if (!monitor->x11.gammaSizeCached)
+    {
+        monitor->x11.gammaSize = XRRGetCrtcGammaSize(_glfw.x11.display,
+                                                     monitor->x11.crtc);
+        monitor->x11.gammaSizeCached = GLFW_TRUE;
+    }
+
+    return monitor->x11.gammaSize;
+}
+
+// Frees the cached RandR state of the monitor
+//
+static void invalidateMonitor(_GLFWmonitor* monitor)
+{
+    if (monitor->x11.outputInfo)
+    {
+        XRRFreeOutputInfo(monitor->x11.outputInfo);
+        monitor->x11.outputInfo = NULL;
+    }
+
+    if (monitor->x11.crtcInfo)
+    {
+        XRRFreeCrtcInfo(monitor->x11.crtcInfo);
+        monitor->x11.crtcInfo = NULL;
+    }
+
+    monitor->x11.gammaSize = 0;
+    monitor->x11.gammaSizeCached = GLFW_FALSE;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
@@ -174,6 +253,9 @@ void _glfwPollMonitorsX11(void)
             _GLFWmonitor* monitor = _glfwAllocMonitor(oi->name, widthMM, heightMM);
             monitor->x11.output = sr->outputs[i];
             monitor->x11.crtc   = oi->crtc;
+            // The new monitor keeps the state queried for it
+            monitor->x11.outputInfo = oi;
+            monitor->x11.crtcInfo   = ci;
 
             for (j = 0;  j < screenCount;  j++)
             {
@@ -193,12 +275,13 @@ void _glfwPollMonitorsX11(void)
                 type = _GLFW_INSERT_LAST;
 
             _glfwInputMonitor(monitor, GLFW_CONNECTED, type);
-
-            XRRFreeOutputInfo(oi);
-            XRRFreeCrtcInfo(ci);
         }
 
-        XRRFreeScreenResources(sr);
+        // NOTE: The monitor callback may already have queried the resources
+        if (_glfw.x11.randr.resources)
+            XRRFreeScreenResources(sr);
+        else
+            _glfw.x11.randr.resources = sr;
 
         if (screens)
             XFree(screens);
@@ -236,10 +319,9 @@ void _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired)
         if (_glfwCompareVideoModes(&current, best) == 0)
             return;
 
-        XRRScreenResources* sr =
-            XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
-        XRRCrtcInfo* ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
-        XRROutputInfo* oi = XRRGetOutputInfo(_glfw.x11.display, sr, monitor->x11.output);
+        XRRScreenResources* sr = getScreenResources();
+        XRRCrtcInfo* ci = getCrtcInfo(monitor);
+        XRROutputInfo* oi = getOutputInfo(monitor);
 
         for (int i = 0;  i < oi->nmode;  i++)
         {
@@ -268,11 +350,10 @@ void _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired)
                              ci->rotation,
                              ci->outputs,
                              ci->noutput);
-        }
 
-        XRRFreeOutputInfo(oi);
-        XRRFreeCrtcInfo(ci);
-        XRRFreeScreenResources(sr);
+            // Do not wait for the RandR events to see the new mode
+            _glfwInvalidateMonitorsX11();
+        }
     }
 }
 
@@ -285,9 +366,8 @@ void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor)
         if (monitor->x11.oldMode == None)
             return;
 
-        XRRScreenResources* sr =
-            XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
-        XRRCrtcInfo* ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
+        XRRScreenResources* sr = getScreenResources();
+        XRRCrtcInfo* ci = getCrtcInfo(monitor);
 
         XRRSetCrtcConfig(_glfw.x11.display,
                          sr, monitor->x11.crtc,
@@ -298,13 +378,28 @@ void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor)
                          ci->outputs,
                          ci->noutput);
 
-        XRRFreeCrtcInfo(ci);
-        XRRFreeScreenResources(sr);
+        // Do not wait for the RandR events to see the old mode
+        _glfwInvalidateMonitorsX11();
 
         monitor->x11.oldMode = None;
     }
 }
 
+// Frees the cached RandR state of all monitors, to be queried again when next
+// needed
+//
+void _glfwInvalidateMonitorsX11(void)
+{
+    for (int i = 0;  i < _glfw.monitorCount;  i++)
+        invalidateMonitor(_glfw.monitors[i]);
+
+    if (_glfw.x11.randr.resources)
+    {
+        XRRFreeScreenResources(_glfw.x11.randr.resources);
+        _glfw.x11.randr.resources = NULL;
+    }
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -312,15 +407,14 @@ void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor)
 
 void _glfwFreeMonitorX11(_GLFWmonitor* monitor)
 {
+    invalidateMonitor(monitor);
 }
 
 void _glfwGetMonitorPosX11(_GLFWmonitor* monitor, int* xpos, int* ypos)
 {
     if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
     {
-        XRRScreenResources* sr =
-            XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
-        XRRCrtcInfo* ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
+        const XRRCrtcInfo* ci = getCrtcInfo(monitor);
 
         if (ci)
         {
@@ -328,11 +422,7 @@ void _glfwGetMonitorPosX11(_GLFWmonitor* monitor, int* xpos, int* ypos)
                 *xpos = ci->x;
             if (ypos)
                 *ypos = ci->y;
-
-            XRRFreeCrtcInfo(ci);
         }
-
-        XRRFreeScreenResources(sr);
     }
 }
 
@@ -353,9 +443,8 @@ void _glfwGetMonitorWorkareaX11(_GLFWmonitor* monitor,
 
     if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
     {
-        XRRScreenResources* sr =
-            XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
-        XRRCrtcInfo* ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
+        const XRRScreenResources* sr = getScreenResources();
+        const XRRCrtcInfo* ci = getCrtcInfo(monitor);
 
         areaX = ci->x;
         areaY = ci->y;
@@ -372,9 +461,6 @@ void _glfwGetMonitorWorkareaX11(_GLFWmonitor* monitor,
             areaWidth  = mi->width;
             areaHeight = mi->height;
         }
-
-        XRRFreeCrtcInfo(ci);
-        XRRFreeScreenResources(sr);
     }
     else
     {
@@ -447,10 +533,9 @@ GLFWvidmode* _glfwGetVideoModesX11(_GLFWmonitor* monitor, int* count)
 
     if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
     {
-        XRRScreenResources* sr =
-            XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
-        XRRCrtcInfo* ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
-        XRROutputInfo* oi = XRRGetOutputInfo(_glfw.x11.display, sr, monitor->x11.output);
+        const XRRScreenResources* sr = getScreenResources();
+        const XRRCrtcInfo* ci = getCrtcInfo(monitor);
+        const XRROutputInfo* oi = getOutputInfo(monitor);
 
         result = _glfw_calloc(oi->nmode, sizeof(GLFWvidmode));
 
@@ -476,10 +561,6 @@ GLFWvidmode* _glfwGetVideoModesX11(_GLFWmonitor* monitor, int* count)
             (*count)++;
             result[*count - 1] = mode;
         }
-
-        XRRFreeOutputInfo(oi);
-        XRRFreeCrtcInfo(ci);
-        XRRFreeScreenResources(sr);
     }
     else
     {
@@ -495,22 +576,16 @@ GLFWbool _glfwGetVideoModeX11(_GLFWmonitor* monitor, GLFWvidmode* mode)
 {
     if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
     {
-        XRRScreenResources* sr =
-            XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
         const XRRModeInfo* mi = NULL;
 
-        XRRCrtcInfo* ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
+        const XRRCrtcInfo* ci = getCrtcInfo(monitor);
         if (ci)
         {
-            mi = getModeInfo(sr, ci->mode);
+            mi = getModeInfo(getScreenResources(), ci->mode);
             if (mi)
                 *mode = vidmodeFromModeInfo(mi, ci);
-
-            XRRFreeCrtcInfo(ci);
         }
 
-        XRRFreeScreenResources(sr);
-
         if (!mi)
         {
             _glfwInputError(GLFW_PLATFORM_ERROR, "X11: Failed to query video mode");
@@ -534,8 +609,7 @@ GLFWbool _glfwGetGammaRampX11(_GLFWmonitor* monitor, GLFWgammaramp* ramp)
 {
     if (_glfw.x11.randr.available && !_glfw.x11.randr.gammaBroken)
     {
-        const size_t size = XRRGetCrtcGammaSize(_glfw.x11.display,
-                                                monitor->x11.crtc);
+        const size_t size = getGammaSize(monitor);
         XRRCrtcGamma* gamma = XRRGetCrtcGamma(_glfw.x11.display,
                                               monitor->x11.crtc);
 
@@ -572,7 +646,7 @@ void _glfwSetGammaRampX11(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
 {
     if (_glfw.x11.randr.available && !_glfw.x11.randr.gammaBroken)
     {
-        if (XRRGetCrtcGammaSize(_glfw.x11.display, monitor->x11.crtc) != ramp->size)
+        if (getGammaSize(monitor) != ramp->size)
         {
             _glfwInputError(GLFW_PLATFORM_ERROR,
                             "X11: Gamma ramp size must match current ramp size");
@@ -28,6 +28,7 @@
 #include <unistd.h>
 #include <signal.h>
 #include <stdint.h>
+#include <pthread.h>
 
 #include <X11/Xlib.h>
 #include <X11/keysym.h>
@@ -143,6 +144,7 @@ typedef int (* PFN_XGrabPointer)(Display*,Window,Bool,unsigned int,int,int,Windo
 typedef Status (* PFN_XIconifyWindow)(Display*,Window,int);
 typedef Status (* PFN_XInitThreads)(void);
 typedef Atom (* PFN_XInternAtom)(Display*,const char*,Bool);
+typedef void (* PFN_XLockDisplay)(Display*);
 typedef int (* PFN_XLookupString)(XKeyEvent*,char*,int,KeySym*,XComposeStatus*);
 typedef int (* PFN_XMapRaised)(Display*,Window);
 typedef int (* PFN_XMapWindow)(Display*,Window);
@@ -178,6 +180,7 @@ typedef int (* PFN_XSync)(Display*,Bool);
 typedef Bool (* PFN_XTranslateCoordinates)(Display*,Window,Window,int,int,int*,int*,Window*);
 typedef int (* PFN_XUndefineCursor)(Display*,Window);
 typedef int (* PFN_XUngrabPointer)(Display*,Time);
+typedef void (* PFN_XUnlockDisplay)(Display*);
 typedef int (* PFN_XUnmapWindow)(Display*,Window);
 typedef void (* PFN_XUnsetICFocus)(XIC);
 typedef VisualID (* PFN_XVisualIDFromVisual)(Visual*);
@@ -199,6 +202,22 @@ typedef XrmQuark (* PFN_XrmUniqueQuark)(void);
 typedef Bool (* PFN_XUnregisterIMInstantiateCallback)(Display*,void*,char*,char*,XIDProc,XPointer);
 typedef int (* PFN_Xutf8LookupString)(XIC,XKeyPressedEvent*,char*,int,KeySym*,Status*);
 typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char*,char**,int,XSizeHints*,XWMHints*,XClassHint*);
+
+// Xlib functions that wait for a reply from the server count themselves when
+// called, for glfwGetX11RoundTripCount, and with GLFW_X11_STATISTICS also time
+// themselves per call site
+//
+#define _GLFW_X11_REPLY(name, call) \
+    (_glfwBeginReplyX11(#name, __FILE__, __LINE__), \
+     _glfwEndReplyX11((unsigned long) (call)))
+#define _GLFW_X11_REPLY_POINTER(name, call) \
+    (_glfwBeginReplyX11(#name, __FILE__, __LINE__), \
+     _glfwEndReplyPointerX11((void*) (call)))
+
+// Xlib functions that flush the request buffer count themselves when called
+//
+#define _GLFW_X11_FLUSH(proc) (_glfw.x11.flushes++, proc)
+
 #define XAllocClassHint _glfw.x11.xlib.AllocClassHint
 #define XAllocSizeHints _glfw.x11.xlib.AllocSizeHints
 #define XAllocWMHints _glfw.x11.xlib.AllocWMHints
@@ -224,7 +243,7 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XEventsQueued _glfw.x11.xlib.EventsQueued
 #define XFilterEvent _glfw.x11.xlib.FilterEvent
 #define XFindContext _glfw.x11.xlib.FindContext
-#define XFlush _glfw.x11.xlib.Flush
+#define XFlush _GLFW_X11_FLUSH(_glfw.x11.xlib.Flush)
 #define XFree _glfw.x11.xlib.Free
 #define XFreeColormap _glfw.x11.xlib.FreeColormap
 #define XFreeCursor _glfw.x11.xlib.FreeCursor
@@ -233,17 +252,18 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XGetEventData _glfw.x11.xlib.GetEventData
 #define XGetICValues _glfw.x11.xlib.GetICValues
 #define XGetIMValues _glfw.x11.xlib.GetIMValues
-#define XGetInputFocus _glfw.x11.xlib.GetInputFocus
-#define XGetKeyboardMapping _glfw.x11.xlib.GetKeyboardMapping
-#define XGetScreenSaver _glfw.x11.xlib.GetScreenSaver
-#define XGetSelectionOwner _glfw.x11.xlib.GetSelectionOwner
+#define XGetInputFocus(...) _GLFW_X11_REPLY(XGetInputFocus, _glfw.x11.xlib.GetInputFocus(__VA_ARGS__))
+#define XGetKeyboardMapping(...) _GLFW_X11_REPLY_POINTER(XGetKeyboardMapping, _glfw.x11.xlib.GetKeyboardMapping(__VA_ARGS__))
+#define XGetScreenSaver(...) _GLFW_X11_REPLY(XGetScreenSaver, _glfw.x11.xlib.GetScreenSaver(__VA_ARGS__))
+#define XGetSelectionOwner(...) _GLFW_X11_REPLY(XGetSelectionOwner, _glfw.x11.xlib.GetSelectionOwner(__VA_ARGS__))
 #define XGetVisualInfo _glfw.x11.xlib.GetVisualInfo
-#define XGetWMNormalHints _glfw.x11.xlib.GetWMNormalHints
-#define XGetWindowAttributes _glfw.x11.xlib.GetWindowAttributes
-#define XGetWindowProperty _glfw.x11.xlib.GetWindowProperty
-#define XGrabPointer _glfw.x11.xlib.GrabPointer
+#define XGetWMNormalHints(...) _GLFW_X11_REPLY(XGetWMNormalHints, _glfw.x11.xlib.GetWMNormalHints(__VA_ARGS__))
+#define XGetWindowAttributes(...) _GLFW_X11_REPLY(XGetWindowAttributes, _glfw.x11.xlib.GetWindowAttributes(__VA_ARGS__))
+#define XGetWindowProperty(...) _GLFW_X11_REPLY(XGetWindowProperty, _glfw.x11.xlib.GetWindowProperty(__VA_ARGS__))
+#define XGrabPointer(...) _GLFW_X11_REPLY(XGrabPointer, _glfw.x11.xlib.GrabPointer(__VA_ARGS__))
 #define XIconifyWindow _glfw.x11.xlib.IconifyWindow
-#define XInternAtom _glfw.x11.xlib.InternAtom
+#define XInternAtom(...) _GLFW_X11_REPLY(XInternAtom, _glfw.x11.xlib.InternAtom(__VA_ARGS__))
+#define XLockDisplay _glfw.x11.xlib.LockDisplay
 #define XLookupString _glfw.x11.xlib.LookupString
 #define XMapRaised _glfw.x11.xlib.MapRaised
 #define XMapWindow _glfw.x11.xlib.MapWindow
@@ -252,9 +272,9 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XNextEvent _glfw.x11.xlib.NextEvent
 #define XOpenIM _glfw.x11.xlib.OpenIM
 #define XPeekEvent _glfw.x11.xlib.PeekEvent
-#define XPending _glfw.x11.xlib.Pending
-#define XQueryExtension _glfw.x11.xlib.QueryExtension
-#define XQueryPointer _glfw.x11.xlib.QueryPointer
+#define XPending _GLFW_X11_FLUSH(_glfw.x11.xlib.Pending)
+#define XQueryExtension(...) _GLFW_X11_REPLY(XQueryExtension, _glfw.x11.xlib.QueryExtension(__VA_ARGS__))
+#define XQueryPointer(...) _GLFW_X11_REPLY(XQueryPointer, _glfw.x11.xlib.QueryPointer(__VA_ARGS__))
 #define XRaiseWindow _glfw.x11.xlib.RaiseWindow
 #define XRegisterIMInstantiateCallback _glfw.x11.xlib.RegisterIMInstantiateCallback
 #define XResizeWindow _glfw.x11.xlib.ResizeWindow
@@ -274,23 +294,24 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XSetWMNormalHints _glfw.x11.xlib.SetWMNormalHints
 #define XSetWMProtocols _glfw.x11.xlib.SetWMProtocols
 #define XSupportsLocale _glfw.x11.xlib.SupportsLocale
-#define XSync _glfw.x11.xlib.Sync
-#define XTranslateCoordinates _glfw.x11.xlib.TranslateCoordinates
+#define XSync(...) _GLFW_X11_REPLY(XSync, _glfw.x11.xlib.Sync(__VA_ARGS__))
+#define XTranslateCoordinates(...) _GLFW_X11_REPLY(XTranslateCoordinates, _glfw.x11.xlib.TranslateCoordinates(__VA_ARGS__))
 #define XUndefineCursor _glfw.x11.xlib.UndefineCursor
 #define XUngrabPointer _glfw.x11.xlib.UngrabPointer
+#define XUnlockDisplay _glfw.x11.xlib.UnlockDisplay
 #define XUnmapWindow _glfw.x11.xlib.UnmapWindow
 #define XUnsetICFocus _glfw.x11.xlib.UnsetICFocus
 #define XVisualIDFromVisual _glfw.x11.xlib.VisualIDFromVisual
 #define XWarpPointer _glfw.x11.xlib.WarpPointer
 #define XkbFreeKeyboard _glfw.x11.xkb.FreeKeyboard
 #define XkbFreeNames _glfw.x11.xkb.FreeNames
-#define XkbGetMap _glfw.x11.xkb.GetMap
-#define XkbGetNames _glfw.x11.xkb.GetNames
-#define XkbGetState _glfw.x11.xkb.GetState
+#define XkbGetMap(...) _GLFW_X11_REPLY_POINTER(XkbGetMap, _glfw.x11.xkb.GetMap(__VA_ARGS__))
+#define XkbGetNames(...) _GLFW_X11_REPLY(XkbGetNames, _glfw.x11.xkb.GetNames(__VA_ARGS__))
+#define XkbGetState(...) _GLFW_X11_REPLY(XkbGetState, _glfw.x11.xkb.GetState(__VA_ARGS__))
 #define XkbKeycodeToKeysym _glfw.x11.xkb.KeycodeToKeysym
-#define XkbQueryExtension _glfw.x11.xkb.QueryExtension
+#define XkbQueryExtension(...) _GLFW_X11_REPLY(XkbQueryExtension, _glfw.x11.xkb.QueryExtension(__VA_ARGS__))
 #define XkbSelectEventDetails _glfw.x11.xkb.SelectEventDetails
-#define XkbSetDetectableAutoRepeat _glfw.x11.xkb.SetDetectableAutoRepeat
+#define XkbSetDetectableAutoRepeat(...) _GLFW_X11_REPLY(XkbSetDetectableAutoRepeat, _glfw.x11.xkb.SetDetectableAutoRepeat(__VA_ARGS__))
 #define XrmDestroyDatabase _glfw.x11.xrm.DestroyDatabase
 #define XrmGetResource _glfw.x11.xrm.GetResource
 #define XrmGetStringDatabase _glfw.x11.xrm.GetStringDatabase
@@ -321,16 +342,16 @@ typedef int (* PFN_XRRUpdateConfiguration)(XEvent*);
 #define XRRFreeGamma _glfw.x11.randr.FreeGamma
 #define XRRFreeOutputInfo _glfw.x11.randr.FreeOutputInfo
 #define XRRFreeScreenResources _glfw.x11.randr.FreeScreenResources
-#define XRRGetCrtcGamma _glfw.x11.randr.GetCrtcGamma
-#define XRRGetCrtcGammaSize _glfw.x11.randr.GetCrtcGammaSize
-#define XRRGetCrtcInfo _glfw.x11.randr.GetCrtcInfo
-#define XRRGetOutputInfo _glfw.x11.randr.GetOutputInfo
-#define XRRGetOutputPrimary _glfw.x11.randr.GetOutputPrimary
-#define XRRGetScreenResourcesCurrent _glfw.x11.randr.GetScreenResourcesCurrent
-#define XRRQueryExtension _glfw.x11.randr.QueryExtension
-#define XRRQueryVersion _glfw.x11.randr.QueryVersion
+#define XRRGetCrtcGamma(...) _GLFW_X11_REPLY_POINTER(XRRGetCrtcGamma, _glfw.x11.randr.GetCrtcGamma(__VA_ARGS__))
+#define XRRGetCrtcGammaSize(...) _GLFW_X11_REPLY(XRRGetCrtcGammaSize, _glfw.x11.randr.GetCrtcGammaSize(__VA_ARGS__))
+#define XRRGetCrtcInfo(...) _GLFW_X11_REPLY_POINTER(XRRGetCrtcInfo, _glfw.x11.randr.GetCrtcInfo(__VA_ARGS__))
+#define XRRGetOutputInfo(...) _GLFW_X11_REPLY_POINTER(XRRGetOutputInfo, _glfw.x11.randr.GetOutputInfo(__VA_ARGS__))
+#define XRRGetOutputPrimary(...) _GLFW_X11_REPLY(XRRGetOutputPrimary, _glfw.x11.randr.GetOutputPrimary(__VA_ARGS__))
+#define XRRGetScreenResourcesCurrent(...) _GLFW_X11_REPLY_POINTER(XRRGetScreenResourcesCurrent, _glfw.x11.randr.GetScreenResourcesCurrent(__VA_ARGS__))
+#define XRRQueryExtension(...) _GLFW_X11_REPLY(XRRQueryExtension, _glfw.x11.randr.QueryExtension(__VA_ARGS__))
+#define XRRQueryVersion(...) _GLFW_X11_REPLY(XRRQueryVersion, _glfw.x11.randr.QueryVersion(__VA_ARGS__))
 #define XRRSelectInput _glfw.x11.randr.SelectInput
-#define XRRSetCrtcConfig _glfw.x11.randr.SetCrtcConfig
+#define XRRSetCrtcConfig(...) _GLFW_X11_REPLY(XRRSetCrtcConfig, _glfw.x11.randr.SetCrtcConfig(__VA_ARGS__))
 #define XRRSetCrtcGamma _glfw.x11.randr.SetCrtcGamma
 #define XRRUpdateConfiguration _glfw.x11.randr.UpdateConfiguration
 
@@ -350,9 +371,9 @@ typedef XcursorImage* (* PFN_XcursorLibraryLoadImage)(const char*,const char*,in
 typedef Bool (* PFN_XineramaIsActive)(Display*);
 typedef Bool (* PFN_XineramaQueryExtension)(Display*,int*,int*);
 typedef XineramaScreenInfo* (* PFN_XineramaQueryScreens)(Display*,int*);
-#define XineramaIsActive _glfw.x11.xinerama.IsActive
-#define XineramaQueryExtension _glfw.x11.xinerama.QueryExtension
-#define XineramaQueryScreens _glfw.x11.xinerama.QueryScreens
+#define XineramaIsActive(...) _GLFW_X11_REPLY(XineramaIsActive, _glfw.x11.xinerama.IsActive(__VA_ARGS__))
+#define XineramaQueryExtension(...) _GLFW_X11_REPLY(XineramaQueryExtension, _glfw.x11.xinerama.QueryExtension(__VA_ARGS__))
+#define XineramaQueryScreens(...) _GLFW_X11_REPLY_POINTER(XineramaQueryScreens, _glfw.x11.xinerama.QueryScreens(__VA_ARGS__))
 
 typedef XID xcb_window_t;
 typedef XID xcb_visualid_t;
@@ -371,14 +392,14 @@ typedef Bool (* PFN_XF86VidModeGetGammaRampSize)(Display*,int,int*);
 
 typedef Status (* PFN_XIQueryVersion)(Display*,int*,int*);
 typedef int (* PFN_XISelectEvents)(Display*,Window,XIEventMask*,int);
-#define XIQueryVersion _glfw.x11.xi.QueryVersion
+#define XIQueryVersion(...) _GLFW_X11_REPLY(XIQueryVersion, _glfw.x11.xi.QueryVersion(__VA_ARGS__))
 #define XISelectEvents _glfw.x11.xi.SelectEvents
 
 typedef Bool (* PFN_XRenderQueryExtension)(Display*,int*,int*);
 typedef Status (* PFN_XRenderQueryVersion)(Display*dpy,int*,int*);
 typedef XRenderPictFormat* (* PFN_XRenderFindVisualFormat)(Display*,Visual const*);
-#define XRenderQueryExtension _glfw.x11.xrender.QueryExtension
-#define XRenderQueryVersion _glfw.x11.xrender.QueryVersion
+#define XRenderQueryExtension(...) _GLFW_X11_REPLY(XRenderQueryExtension, _glfw.x11.xrender.QueryExtension(__VA_ARGS__))
+#define XRenderQueryVersion(...) _GLFW_X11_REPLY(XRenderQueryVersion, _glfw.x11.xrender.QueryVersion(__VA_ARGS__))
 #define XRenderFindVisualFormat _glfw.x11.xrender.FindVisualFormat
 
 typedef Bool (* PFN_XShapeQueryExtension)(Display*,int*,int*);
@@ -386,8 +407,8 @@ typedef Status (* PFN_XShapeQueryVersion)(Display*dpy,int*,int*);
 typedef void (* PFN_XShapeCombineRegion)(Display*,Window,int,int,int,Region,int);
 typedef void (* PFN_XShapeCombineMask)(Display*,Window,int,int,int,Pixmap,int);
 
-#define XShapeQueryExtension _glfw.x11.xshape.QueryExtension
-#define XShapeQueryVersion _glfw.x11.xshape.QueryVersion
+#define XShapeQueryExtension(...) _GLFW_X11_REPLY(XShapeQueryExtension, _glfw.x11.xshape.QueryExtension(__VA_ARGS__))
+#define XShapeQueryVersion(...) _GLFW_X11_REPLY(XShapeQueryVersion, _glfw.x11.xshape.QueryVersion(__VA_ARGS__))
 #define XShapeCombineRegion _glfw.x11.xshape.ShapeCombineRegion
 #define XShapeCombineMask _glfw.x11.xshape.ShapeCombineMask
 
@@ -453,7 +474,6 @@ typedef VkResult (APIENTRY *PFN_vkCreateXcbSurfaceKHR)(VkInstance,const VkXcbSur
 typedef VkBool32 (APIENTRY *PFN_vkGetPhysicalDeviceXcbPresentationSupportKHR)(VkPhysicalDevice,uint32_t,xcb_connection_t*,xcb_visualid_t);
 
 #include "xkb_unicode.h"
-#include "posix_poll.h"
 
 #define GLFW_X11_WINDOW_STATE           _GLFWwindowX11 x11;
 #define GLFW_X11_LIBRARY_WINDOW_STATE   _GLFWlibraryX11 x11;
@@ -518,6 +538,37 @@ typedef struct _GLFWlibraryGLX
     GLFWbool        ARB_context_flush_control;
 } _GLFWlibraryGLX;
 
+#define _GLFW_X11_REPLY_SITES 256
+#define _GLFW_X11_REPLY_DEPTH 4
+
+// Round trips and time spent waiting for them at one call site
+//
+typedef struct _GLFWreplysiteX11
+{
+    const char*     name;
+    const char*     file;
+    int             line;
+    unsigned long   count;
+    uint64_t        time;
+} _GLFWreplysiteX11;
+
+// X11 connection statistics recorded with GLFW_X11_STATISTICS
+//
+typedef struct _GLFWstatisticsX11
+{
+    uint64_t        start;
+    // Call sites hashed by line, with the last one taking any that do not fit
+    _GLFWreplysiteX11 sites[_GLFW_X11_REPLY_SITES];
+    // Calls waiting for a reply, innermost last
+    struct {
+        _GLFWreplysiteX11* site;
+        uint64_t    start;
+    }               calls[_GLFW_X11_REPLY_DEPTH];
+    int             depth;
+    // Events processed, by type without the send_event bit
+    unsigned long   events[128];
+} _GLFWstatisticsX11;
+
 // X11-specific per-window data
 //
 typedef struct _GLFWwindowX11
@@ -530,18 +581,28 @@ typedef struct _GLFWwindowX11
     GLFWbool        overrideRedirect;
     GLFWbool        iconified;
     GLFWbool        maximized;
+    // The last WM_STATE set by the window manager
+    int             wmState;
 
     // Whether the visual supports framebuffer transparency
     GLFWbool        transparent;
 
-    // Cached position and size used to filter out duplicate events
+    // Cached position and size used to filter out duplicate events and to
+    // answer the getters, with the position current unless reparented since
     int             width, height;
     int             xpos, ypos;
+    GLFWbool        posCurrent;
 
     // The last received cursor position, regardless of source
     int             lastCursorPosX, lastCursorPosY;
     // The last position the cursor was warped to by GLFW
     int             warpCursorPosX, warpCursorPosY;
+    // The cursor position from the last pointer event, warp or query, which
+    // is current while the cursor is in the window and the window has not
+    // moved since
+    int             cursorPosX, cursorPosY;
+    GLFWbool        cursorPosCurrent;
+    GLFWbool        cursorInside;
 
     // The time of the last KeyPress event per keycode, for discarding
     // duplicate key events generated for some keys by ibus
@@ -555,6 +616,11 @@ typedef struct _GLFWlibraryX11
     Display*        display;
     int             screen;
     Window          root;
+    // Calls made to Xlib functions that wait for a reply or flush
+    unsigned long   roundTrips;
+    unsigned long   flushes;
+    // Recorded with the GLFW_X11_STATISTICS init hint, otherwise NULL
+    _GLFWstatisticsX11* statistics;
 
     // System content scale
     float           contentScaleX, contentScaleY;
@@ -584,7 +650,20 @@ typedef struct _GLFWlibraryX11
     double          restoreCursorPosX, restoreCursorPosY;
     // The window whose disabled cursor mode is active
     _GLFWwindow*    disabledCursorWindow;
-    int             emptyEventPipe[2];
+
+    // The event thread moves input events from the Xlib queue to a buffer
+    // guarded by the display lock, which the main thread swaps with the batch
+    // it then processes
+    struct {
+        GLFWbool    started;
+        pthread_t   thread;
+        _GLFWwakeupPOSIX stop;
+        XEvent*     events;
+        int         count;
+        int         capacity;
+        XEvent*     batch;
+        int         batchCapacity;
+    } eventThread;
 
     // Window manager atoms
     Atom            NET_SUPPORTED;
@@ -690,6 +769,7 @@ typedef struct _GLFWlibraryX11
         PFN_XGrabPointer GrabPointer;
         PFN_XIconifyWindow IconifyWindow;
         PFN_XInternAtom InternAtom;
+        PFN_XLockDisplay LockDisplay;
         PFN_XLookupString LookupString;
         PFN_XMapRaised MapRaised;
         PFN_XMapWindow MapWindow;
@@ -724,6 +804,7 @@ typedef struct _GLFWlibraryX11
         PFN_XTranslateCoordinates TranslateCoordinates;
         PFN_XUndefineCursor UndefineCursor;
         PFN_XUngrabPointer UngrabPointer;
+        PFN_XUnlockDisplay UnlockDisplay;
         PFN_XUnmapWindow UnmapWindow;
         PFN_XUnsetICFocus UnsetICFocus;
         PFN_XVisualIDFromVisual VisualIDFromVisual;
@@ -749,6 +830,9 @@ typedef struct _GLFWlibraryX11
         int         minor;
         GLFWbool    gammaBroken;
         GLFWbool    monitorBroken;
+        // Cached screen resources, or NULL until queried after the last
+        // RandR change
+        XRRScreenResources* resources;
         PFN_XRRAllocGamma AllocGamma;
         PFN_XRRFreeCrtcInfo FreeCrtcInfo;
         PFN_XRRFreeGamma FreeGamma;
@@ -884,6 +968,13 @@ typedef struct _GLFWmonitorX11
     RRCrtc          crtc;
     RRMode          oldMode;
 
+    // Cached RandR state of the output and CRTC, or NULL and not cached until
+    // queried after the last RandR change
+    XRROutputInfo*  outputInfo;
+    XRRCrtcInfo*    crtcInfo;
+    int             gammaSize;
+    GLFWbool        gammaSizeCached;
+
     // Index of corresponding Xinerama screen,
     // for EWMH full screen window placement
     int             index;
@@ -973,6 +1064,7 @@ GLFWbool _glfwGetGammaRampX11(_GLFWmonitor* monitor, GLFWgammaramp* ramp);
 void _glfwSetGammaRampX11(_GLFWmonitor* monitor, const GLFWgammaramp* ramp);
 
 void _glfwPollMonitorsX11(void);
+void _glfwInvalidateMonitorsX11(void);
 void _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired);
 void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor);
 
@@ -990,6 +1082,11 @@ void _glfwInputErrorX11(int error, const char* message);
 
 void _glfwPushSelectionToManagerX11(void);
 void _glfwCreateInputContextX11(_GLFWwindow* window);
+void _glfwStartEventThreadX11(void);
+void _glfwStopEventThreadX11(void);
+void _glfwBeginReplyX11(const char* name, const char* file, int line);
+unsigned long _glfwEndReplyX11(unsigned long result);
+void* _glfwEndReplyPointerX11(void* result);
 
 GLFWbool _glfwInitGLX(void);
 void _glfwTerminateGLX(void);
@@ -56,12 +56,204 @@
 
 #define _GLFW_XDND_VERSION 5
 
+// Returns whether the event is one of the input events read ahead by the event
+// thread
+// This is called by Xlib with the display locked and must not call Xlib
+//
+static Bool isThreadEvent(Display* display, XEvent* event, XPointer pointer)
+{
+    switch (event->type)
+    {
+        case KeyPress:
+        case KeyRelease:
+        case ButtonPress:
+        case ButtonRelease:
+        case MotionNotify:
+        case EnterNotify:
+        case LeaveNotify:
+        case FocusIn:
+        case FocusOut:
+        case GenericEvent:
+            return True;
+    }
+
+    return False;
+}
+
+// Moves the input events in the Xlib queue to the end of the event thread
+// buffer, keeping their order and discarding the releases of server-generated
+// key repeats
+// Without reading, only the input events at the head of the queue are moved, as
+// searching past them with XCheckIfEvent reads the connection when it finds
+// nothing
+// The display must be locked by the calling thread
+//
+static void collectThreadEvents(GLFWbool read)
+{
+    for (;;)
+    {
+        if (_glfw.x11.eventThread.count == _glfw.x11.eventThread.capacity)
+        {
+            const int capacity = _glfw_max(64, _glfw.x11.eventThread.capacity * 2);
+            XEvent* events = _glfw_realloc(_glfw.x11.eventThread.events,
+                                           capacity * sizeof(XEvent));
+            // The remaining events are processed from the Xlib queue instead
+            if (!events)
+                return;
+
+            _glfw.x11.eventThread.events = events;
+            _glfw.x11.eventThread.capacity = capacity;
+        }
+
+        XEvent* event = _glfw.x11.eventThread.events + _glfw.x11.eventThread.count;
+        if (read)
+        {
+            if (!XCheckIfEvent(_glfw.x11.display, event, isThreadEvent, NULL))
+                return;
+        }
+        else
+        {
+            // NOTE: Neither of these reads the connection while the queue is
+            //       not empty
+            if (!QLength(_glfw.x11.display))
+                return;
+
+            XPeekEvent(_glfw.x11.display, event);
+            if (!isThreadEvent(_glfw.x11.display, event, NULL))
+                return;
+
+            XNextEvent(_glfw.x11.display, event);
+        }
+
+        // The data of unclaimed cookies is freed by the next Xlib call that
+        // takes an event, so claim it now and leave freeing it to processEvent
+        if (event->type == GenericEvent)
+            XGetEventData(_glfw.x11.display, &event->xcookie);
+
+        // HACK: See the KeyRelease case of processEvent
+        if (event->type == KeyPress &&
+            !_glfw.x11.xkb.detectable &&
+            _glfw.x11.eventThread.count > 0)
+        {
+            XEvent* previous = event - 1;
+
+            if (previous->type == KeyRelease &&
+                previous->xkey.window == event->xkey.window &&
+                previous->xkey.keycode == event->xkey.keycode &&
+                (event->xkey.time - previous->xkey.time) < 20)
+            {
+                *previous = *event;
+                continue;
+            }
+        }
+
+        _glfw.x11.eventThread.count++;
+    }
+}
+
+// Entry point of the event thread
+//
+static void* eventThreadMain(void* arg)
+{
+    enum { XLIB_FD, STOP_FD };
+    struct pollfd fds[] =
+    {
+        [XLIB_FD] = { ConnectionNumber(_glfw.x11.display), POLLIN },
+        [STOP_FD] = { _glfw.x11.eventThread.stop.fds[0], POLLIN }
+    };
+
+    for (;;)
+    {
+        if (poll(fds, sizeof(fds) / sizeof(fds[0]), -1) == -1)
+        {
+            if (errno == EINTR)
+                continue;
+
+            break;
+        }
+
+        if (fds[STOP_FD].revents & POLLIN)
+            break;
+
+        XLockDisplay(_glfw.x11.display);
+        XEventsQueued(_glfw.x11.display, QueuedAfterReading);
+        collectThreadEvents(GLFW_TRUE);
+        const GLFWbool queued = _glfw.x11.eventThread.count > 0 ||
+                                QLength(_glfw.x11.display) > 0;
+        XUnlockDisplay(_glfw.x11.display);
+
+        if (queued)
+            _glfwPostWakeupPOSIX(&_glfw.posixWakeup);
+    }
+
+    return NULL;
+}
+
+// Returns whether there are events ready to be processed, reading the display
+// connection only if no event thread does so
+//
+static GLFWbool eventsPending(void)
+{
+    if (_glfw.x11.eventThread.started)
+    {
+        XLockDisplay(_glfw.x11.display);
+        const GLFWbool pending = _glfw.x11.eventThread.count > 0 ||
+                                 QLength(_glfw.x11.display) > 0;
+        XUnlockDisplay(_glfw.x11.display);
+        return pending;
+    }
+
+    return XPending(_glfw.x11.display) > 0;
+}
+
 // Wait for event data to arrive on the X11 display socket
 // This avoids blocking other threads via the per-display Xlib lock that also
 // covers GLX functions
 //
 static GLFWbool waitForX11Event(double* timeout)
 {
+    if (_glfw.x11.eventThread.started)
+    {
+        // The event thread reads the socket and posts a wakeup when an event
+        // is queued, so wait for that instead and post it again afterwards,
+        // as it may also have been an empty event
+        struct pollfd fd = { _glfw.posixWakeup.fds[0], POLLIN };
+        GLFWbool consumed = GLFW_FALSE;
+        GLFWbool result = GLFW_TRUE;
+
+        XFlush(_glfw.x11.display);
+
+        for (;;)
+        {
+            // Only the events left in the Xlib queue can be what the caller
+            // is waiting for
+            // NOTE: The caller reads the connection itself while it looks for
+            //       its event, so the input events that brings in are moved
+            //       here without reading again
+            XLockDisplay(_glfw.x11.display);
+            collectThreadEvents(GLFW_FALSE);
+            const GLFWbool queued = QLength(_glfw.x11.display) > 0;
+            XUnlockDisplay(_glfw.x11.display);
+
+            if (queued)
+                break;
+
+            if (!_glfwPollPOSIX(&fd, 1, timeout))
+            {
+                result = GLFW_FALSE;
+                break;
+            }
+
+            _glfwConsumeWakeupPOSIX(&_glfw.posixWakeup);
+            consumed = GLFW_TRUE;
+        }
+
+        if (consumed)
+            _glfwPostWakeupPOSIX(&_glfw.posixWakeup);
+
+        return result;
+    }
+
     struct pollfd fd = { ConnectionNumber(_glfw.x11.display), POLLIN };
 
     while (!XPending(_glfw.x11.display))
@@ -73,17 +265,17 @@ static GLFWbool waitForX11Event(double* timeout)
     return GLFW_TRUE;
 }
 
-// Wait for event data to arrive on any event file descriptor
+// Wait for event data to arrive on any event file descriptor or event source
 // This avoids blocking other threads via the per-display Xlib lock that also
 // covers GLX functions
 //
 static GLFWbool waitForAnyEvent(double* timeout)
 {
-    enum { XLIB_FD, PIPE_FD, INOTIFY_FD };
+    enum { XLIB_FD, WAKEUP_FD, INOTIFY_FD };
     struct pollfd fds[] =
     {
         [XLIB_FD] = { ConnectionNumber(_glfw.x11.display), POLLIN },
-        [PIPE_FD] = { _glfw.x11.emptyEventPipe[0], POLLIN },
+        [WAKEUP_FD] = { _glfw.posixWakeup.fds[0], POLLIN },
         [INOTIFY_FD] = { -1, POLLIN }
     };
 
@@ -92,9 +284,16 @@ static GLFWbool waitForAnyEvent(double* timeout)
         fds[INOTIFY_FD].fd = _glfw.linjs.inotify;
 #endif
 
-    while (!XPending(_glfw.x11.display))
+    // The event thread reads the socket and posts a wakeup for what it reads
+    if (_glfw.x11.eventThread.started)
+    {
+        fds[XLIB_FD].fd = -1;
+        XFlush(_glfw.x11.display);
+    }
+
+    while (!eventsPending())
     {
-        if (!_glfwPollPOSIX(fds, sizeof(fds) / sizeof(fds[0]), timeout))
+        if (!_glfwWaitPOSIX(fds, sizeof(fds) / sizeof(fds[0]), timeout))
             return GLFW_FALSE;
 
         for (int i = 1; i < sizeof(fds) / sizeof(fds[0]); i++)
@@ -107,32 +306,6 @@ static GLFWbool waitForAnyEvent(double* timeout)
     return GLFW_TRUE;
 }
 
-// Writes a byte to the empty event pipe
-//
-static void writeEmptyEvent(void)
-{
-    for (;;)
-    {
-        const char byte = 0;
-        const ssize_t result = write(_glfw.x11.emptyEventPipe[1], &byte, 1);
-        if (result == 1 || (result == -1 && errno != EINTR))
-            break;
-    }
-}
-
-// Drains available data from the empty event pipe
-//
-static void drainEmptyEvents(void)
-{
-    for (;;)
-    {
-        char dummy[64];
-        const ssize_t result = read(_glfw.x11.emptyEventPipe[0], dummy, sizeof(dummy));
-        if (result == -1 && errno != EINTR)
-            break;
-    }
-}
-
 // Waits until a VisibilityNotify event arrives for the specified window or the
 // timeout period elapses (ICCCM section 4.2.2)
 //
@@ -177,6 +350,42 @@ static int getWindowState(_GLFWwindow* window)
     return result;
 }
 
+// Returns whether the window is maximized
+//
+static GLFWbool getWindowMaximized(_GLFWwindow* window)
+{
+    Atom* states;
+    GLFWbool maximized = GLFW_FALSE;
+
+    if (!_glfw.x11.NET_WM_STATE ||
+        !_glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
+        !_glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ)
+    {
+        return maximized;
+    }
+
+    const unsigned long count =
+        _glfwGetWindowPropertyX11(window->x11.handle,
+                                  _glfw.x11.NET_WM_STATE,
+                                  XA_ATOM,
+                                  (unsigned char**) &states);
+
+    for (unsigned long i = 0;  i < count;  i++)
+    {
+        if (states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
+            states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ)
+        {
+            maximized = GLFW_TRUE;
+            break;
+        }
+    }
+
+    if (states)
+        XFree(states);
+
+    return maximized;
+}
+
 // Returns whether the event is a selection event
 //
 static Bool isSelectionEvent(Display* display, XEvent* event, XPointer pointer)
@@ -781,8 +990,21 @@ static GLFWbool createNativeWindow(_GLFWwindow* window,
         _glfwCreateInputContextX11(window);
 
     _glfwSetWindowTitleX11(window, wndconfig->title);
-    _glfwGetWindowPosX11(window, &window->x11.xpos, &window->x11.ypos);
-    _glfwGetWindowSizeX11(window, &window->x11.width, &window->x11.height);
+
+    // From here on the position and size getters are answered from these,
+    // which ConfigureNotify keeps current
+    {
+        Window dummy;
+        XWindowAttributes attribs;
+
+        XTranslateCoordinates(_glfw.x11.display, window->x11.handle, _glfw.x11.root,
+                              0, 0, &window->x11.xpos, &window->x11.ypos, &dummy);
+        XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &attribs);
+
+        window->x11.width = attribs.width;
+        window->x11.height = attribs.height;
+        window->x11.posCurrent = GLFW_TRUE;
+    }
 
     return GLFW_TRUE;
 }
@@ -1141,6 +1363,47 @@ static void releaseMonitor(_GLFWwindow* window)
     }
 }
 
+// Sets the time of the event for the input functions, for the event types
+// that carry one
+//
+static void setEventTime(const XEvent* event)
+{
+    Time time;
+
+    switch (event->type)
+    {
+        case KeyPress:
+        case KeyRelease:
+            time = event->xkey.time;
+            break;
+        case ButtonPress:
+        case ButtonRelease:
+            time = event->xbutton.time;
+            break;
+        case MotionNotify:
+            time = event->xmotion.time;
+            break;
+        case EnterNotify:
+        case LeaveNotify:
+            time = event->xcrossing.time;
+            break;
+        default:
+            return;
+    }
+
+    _glfw.eventTime = _glfwTimerValueFromMillisecondsPOSIX((uint32_t) time);
+}
+
+// Updates the cursor position returned by glfwGetCursorPos from an event or
+// query
+//
+static void updateCursorPos(_GLFWwindow* window, int x, int y)
+{
+    window->x11.cursorPosX = x;
+    window->x11.cursorPosY = y;
+    window->x11.cursorPosCurrent = GLFW_TRUE;
+}
+
 // Process the specified X event
 //
 static void processEvent(XEvent *event)
@@ -1148,18 +1411,33 @@ static void processEvent(XEvent *event)
     int keycode = 0;
     Bool filtered = False;
 
+    if (_glfw.x11.statistics)
+        _glfw.x11.statistics->events[event->type & 0x7f]++;
+
     // HACK: Save scancode as some IMs clear the field in XFilterEvent
     if (event->type == KeyPress || event->type == KeyRelease)
         keycode = event->xkey.keycode;
 
     filtered = XFilterEvent(event, None);
+    setEventTime(event);
 
     if (_glfw.x11.randr.available)
     {
+        if (event->type == _glfw.x11.randr.eventBase + RRScreenChangeNotify)
+        {
+            XRRUpdateConfiguration(event);
+            _glfwInvalidateMonitorsX11();
+            return;
+        }
+
         if (event->type == _glfw.x11.randr.eventBase + RRNotify)
         {
             XRRUpdateConfiguration(event);
-            _glfwPollMonitorsX11();
+            _glfwInvalidateMonitorsX11();
+
+            if (((XRRNotifyEvent*) event)->subtype == RRNotify_OutputChange)
+                _glfwPollMonitorsX11();
+
             return;
         }
     }
@@ -1184,15 +1462,21 @@ static void processEvent(XEvent *event)
         {
             _GLFWwindow* window = _glfw.x11.disabledCursorWindow;
 
+            // NOTE: The event thread has already claimed the data of the
+            //       events it moved
             if (window &&
                 window->rawMouseMotion &&
                 event->xcookie.extension == _glfw.x11.xi.majorOpcode &&
-                XGetEventData(_glfw.x11.display, &event->xcookie) &&
+                (event->xcookie.data ||
+                 XGetEventData(_glfw.x11.display, &event->xcookie)) &&
                 event->xcookie.evtype == XI_RawMotion)
             {
                 XIRawEvent* re = event->xcookie.data;
                 if (re->valuators.mask_len)
                 {
+                    _glfw.eventTime =
+                        _glfwTimerValueFromMillisecondsPOSIX((uint32_t) re->time);
+
                     const double* values = re->raw_values;
                     double xpos = window->virtualCursorPosX;
                     double ypos = window->virtualCursorPosY;
@@ -1237,6 +1521,9 @@ static void processEvent(XEvent *event)
         case ReparentNotify:
         {
             window->x11.parent = event->xreparent.parent;
+
+            // The position is queried until the next ConfigureNotify
+            window->x11.posCurrent = GLFW_FALSE;
             return;
         }
 
@@ -1317,7 +1604,8 @@ static void processEvent(XEvent *event)
             const int key = translateKey(keycode);
             const int mods = translateState(event->xkey.state);
 
-            if (!_glfw.x11.xkb.detectable)
+            // The event thread discards these before they are processed
+            if (!_glfw.x11.xkb.detectable && !_glfw.x11.eventThread.started)
             {
                 // HACK: Key repeat events will arrive as KeyRelease/KeyPress
                 //       pairs with similar or identical time stamps
@@ -1357,6 +1645,8 @@ static void processEvent(XEvent *event)
         {
             const int mods = translateState(event->xbutton.state);
 
+            updateCursorPos(window, event->xbutton.x, event->xbutton.y);
+
             if (event->xbutton.button == Button1)
                 _glfwInputMouseClick(window, GLFW_MOUSE_BUTTON_LEFT, GLFW_PRESS, mods);
             else if (event->xbutton.button == Button2)
@@ -1391,6 +1681,8 @@ static void processEvent(XEvent *event)
         {
             const int mods = translateState(event->xbutton.state);
 
+            updateCursorPos(window, event->xbutton.x, event->xbutton.y);
+
             if (event->xbutton.button == Button1)
             {
                 _glfwInputMouseClick(window,
@@ -1441,11 +1733,14 @@ static void processEvent(XEvent *event)
 
             window->x11.lastCursorPosX = x;
             window->x11.lastCursorPosY = y;
+            window->x11.cursorInside = GLFW_TRUE;
+            updateCursorPos(window, x, y);
             return;
         }
 
         case LeaveNotify:
         {
+            window->x11.cursorInside = GLFW_FALSE;
             _glfwInputCursorEnter(window, GLFW_FALSE);
             return;
         }
@@ -1455,6 +1750,8 @@ static void processEvent(XEvent *event)
             const int x = event->xmotion.x;
             const int y = event->xmotion.y;
 
+            updateCursorPos(window, x, y);
+
             if (x != window->x11.warpCursorPosX ||
                 y != window->x11.warpCursorPosY)
             {
@@ -1523,11 +1820,16 @@ static void processEvent(XEvent *event)
                     return;
             }
 
+            window->x11.posCurrent = GLFW_TRUE;
+
             if (xpos != window->x11.xpos || ypos != window->x11.ypos)
             {
                 window->x11.xpos = xpos;
                 window->x11.ypos = ypos;
 
+                // The cursor may not have moved with the window
+                window->x11.cursorPosCurrent = GLFW_FALSE;
+
                 _glfwInputWindowPos(window, xpos, ypos);
             }
 
@@ -1791,12 +2093,17 @@ static void processEvent(XEvent *event)
 
         case PropertyNotify:
         {
-            if (event->xproperty.state != PropertyNewValue)
-                return;
+            // NOTE: The iconified and maximized getters are answered from the
+            //       state read here, so a deleted property is read as well
+            const GLFWbool deleted =
+                event->xproperty.state != PropertyNewValue;
 
             if (event->xproperty.atom == _glfw.x11.WM_STATE)
             {
-                const int state = getWindowState(window);
+                const int state = deleted ? WithdrawnState
+                                          : getWindowState(window);
+                window->x11.wmState = state;
+
                 if (state != IconicState && state != NormalState)
                     return;
 
@@ -1817,7 +2124,8 @@ static void processEvent(XEvent *event)
             }
             else if (event->xproperty.atom == _glfw.x11.NET_WM_STATE)
             {
-                const GLFWbool maximized = _glfwWindowMaximizedX11(window);
+                const GLFWbool maximized =
+                    deleted ? GLFW_FALSE : getWindowMaximized(window);
                 if (window->x11.maximized != maximized)
                 {
                     window->x11.maximized = maximized;
@@ -1833,6 +2141,67 @@ static void processEvent(XEvent *event)
     }
 }
 
+// Returns whether the motion event can be dropped because the next event moves
+// the cursor of the same window with the same buttons and modifiers, and the
+// window coalesces its cursor motion anyway
+//
+static GLFWbool isCoalescedMotion(const XEvent* event, const XEvent* next)
+{
+    _GLFWwindow* window = NULL;
+
+    if (next->type != MotionNotify ||
+        next->xmotion.window != event->xmotion.window ||
+        next->xmotion.state != event->xmotion.state)
+    {
+        return GLFW_FALSE;
+    }
+
+    if (XFindContext(_glfw.x11.display,
+                     event->xmotion.window,
+                     _glfw.x11.context,
+                     (XPointer*) &window) != 0)
+    {
+        return GLFW_FALSE;
+    }
+
+    // The disabled cursor is re-centered with motion events that must be seen
+    return window->coalesceCursor &&
+           !(window->cursorPath && window->eventQueue) &&
+           window != _glfw.x11.disabledCursorWindow;
+}
+
+// Processes the input events read ahead by the event thread
+// This only swaps buffers under the display lock and never reads the connection
+//
+static void processThreadEvents(void)
+{
+    XLockDisplay(_glfw.x11.display);
+
+    XEvent* events = _glfw.x11.eventThread.events;
+    const int count = _glfw.x11.eventThread.count;
+    const int capacity = _glfw.x11.eventThread.capacity;
+
+    _glfw.x11.eventThread.events = _glfw.x11.eventThread.batch;
+    _glfw.x11.eventThread.capacity = _glfw.x11.eventThread.batchCapacity;
+    _glfw.x11.eventThread.count = 0;
+    _glfw.x11.eventThread.batch = events;
+    _glfw.x11.eventThread.batchCapacity = capacity;
+    XUnlockDisplay(_glfw.x11.display);
+
+    for (int i = 0;  i < count;  i++)
+    {
+        if (events[i].type == MotionNotify &&
+            i + 1 < count &&
+            isCoalescedMotion(events + i, events + i + 1))
+        {
+            continue;
+        }
+
+        processEvent(events + i);
+        _glfw.eventTime = 0;
+    }
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -1951,6 +2320,59 @@ void _glfwCreateInputContextX11(_GLFWwindow* window)
     }
 }
 
+// Starts the event thread, falling back to reading events on the main thread
+// if it cannot be started
+//
+void _glfwStartEventThreadX11(void)
+{
+    sigset_t all, previous;
+    int result;
+
+    if (!_glfwCreateWakeupPOSIX(&_glfw.x11.eventThread.stop))
+        return;
+
+    // Leave all signals to the threads of the application
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &previous);
+    result = pthread_create(&_glfw.x11.eventThread.thread, NULL, eventThreadMain, NULL);
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+    if (result != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Failed to create event thread: %s",
+                        strerror(result));
+        _glfwDestroyWakeupPOSIX(&_glfw.x11.eventThread.stop);
+        return;
+    }
+
+    _glfw.x11.eventThread.started = GLFW_TRUE;
+}
+
+void _glfwStopEventThreadX11(void)
+{
+    if (_glfw.x11.eventThread.started)
+    {
+        _glfwPostWakeupPOSIX(&_glfw.x11.eventThread.stop);
+        pthread_join(_glfw.x11.eventThread.thread, NULL);
+
+        // The data of moved generic events was claimed when they were moved
+        for (int i = 0;  i < _glfw.x11.eventThread.count;  i++)
+        {
+            XEvent* event = _glfw.x11.eventThread.events + i;
+            if (event->type == GenericEvent)
+                XFreeEventData(_glfw.x11.display, &event->xcookie);
+        }
+
+        // The wakeup exists only while the thread does
+        _glfwDestroyWakeupPOSIX(&_glfw.x11.eventThread.stop);
+    }
+
+    _glfw_free(_glfw.x11.eventThread.events);
+    _glfw_free(_glfw.x11.eventThread.batch);
+    memset(&_glfw.x11.eventThread, 0, sizeof(_glfw.x11.eventThread));
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -2154,11 +2576,16 @@ void _glfwSetWindowIconX11(_GLFWwindow* window, int count, const GLFWimage* imag
 
 void _glfwGetWindowPosX11(_GLFWwindow* window, int* xpos, int* ypos)
 {
-    Window dummy;
-    int x, y;
+    int x = window->x11.xpos, y = window->x11.ypos;
 
-    XTranslateCoordinates(_glfw.x11.display, window->x11.handle, _glfw.x11.root,
-                          0, 0, &x, &y, &dummy);
+    // NOTE: The query is not cached, so the next ConfigureNotify still reports
+    //       any move caused by reparenting
+    if (!window->x11.posCurrent)
+    {
+        Window dummy;
+        XTranslateCoordinates(_glfw.x11.display, window->x11.handle, _glfw.x11.root,
+                              0, 0, &x, &y, &dummy);
+    }
 
     if (xpos)
         *xpos = x;
@@ -2192,13 +2619,10 @@ void _glfwSetWindowPosX11(_GLFWwindow* window, int xpos, int ypos)
 
 void _glfwGetWindowSizeX11(_GLFWwindow* window, int* width, int* height)
 {
-    XWindowAttributes attribs;
-    XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &attribs);
-
     if (width)
-        *width = attribs.width;
+        *width = window->x11.width;
     if (height)
-        *height = attribs.height;
+        *height = window->x11.height;
 }
 
 void _glfwSetWindowSizeX11(_GLFWwindow* window, int width, int height)
@@ -2534,7 +2958,7 @@ GLFWbool _glfwWindowFocusedX11(_GLFWwindow* window)
 
 GLFWbool _glfwWindowIconifiedX11(_GLFWwindow* window)
 {
-    return getWindowState(window) == IconicState;
+    return window->x11.wmState == IconicState;
 }
 
 GLFWbool _glfwWindowVisibleX11(_GLFWwindow* window)
@@ -2546,36 +2970,7 @@ GLFWbool _glfwWindowVisibleX11(_GLFWwindow* window)
 
 GLFWbool _glfwWindowMaximizedX11(_GLFWwindow* window)
 {
-    Atom* states;
-    GLFWbool maximized = GLFW_FALSE;
-
-    if (!_glfw.x11.NET_WM_STATE ||
-        !_glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
-        !_glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ)
-    {
-        return maximized;
-    }
-
-    const unsigned long count =
-        _glfwGetWindowPropertyX11(window->x11.handle,
-                                  _glfw.x11.NET_WM_STATE,
-                                  XA_ATOM,
-                                  (unsigned char**) &states);
-
-    for (unsigned long i = 0;  i < count;  i++)
-    {
-        if (states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
-            states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ)
-        {
-            maximized = GLFW_TRUE;
-            break;
-        }
-    }
-
-    if (states)
-        XFree(states);
-
-    return maximized;
+    return window->x11.maximized;
 }
 
 GLFWbool _glfwWindowHoveredX11(_GLFWwindow* window)
@@ -2781,19 +3176,43 @@ GLFWbool _glfwRawMouseMotionSupportedX11(void)
 
 void _glfwPollEventsX11(void)
 {
-    drainEmptyEvents();
+    _glfwConsumeWakeupPOSIX(&_glfw.posixWakeup);
+    _glfwPollEventSourcesPOSIX();
 
 #if defined(GLFW_BUILD_LINUX_JOYSTICK)
     if (_glfw.joysticksInitialized)
         _glfwDetectJoystickConnectionLinux();
 #endif
-    XPending(_glfw.x11.display);
 
-    while (QLength(_glfw.x11.display))
+    // The event thread has already read the socket, and what it read since is
+    // left to the next call
+    // NOTE: The events left in the Xlib queue are taken with XNextEvent, which
+    //       does not read the connection while the queue is not empty
+    if (_glfw.x11.eventThread.started)
+    {
+        XFlush(_glfw.x11.display);
+        processThreadEvents();
+    }
+    else
+        XPending(_glfw.x11.display);
+
+    for (;;)
     {
         XEvent event;
-        XNextEvent(_glfw.x11.display, &event);
+
+        // The event thread may take the last queued event between checking
+        // the queue and taking from it, which would make XNextEvent read
+        XLockDisplay(_glfw.x11.display);
+        const GLFWbool queued = QLength(_glfw.x11.display) > 0;
+        if (queued)
+            XNextEvent(_glfw.x11.display, &event);
+        XUnlockDisplay(_glfw.x11.display);
+
+        if (!queued)
+            break;
+
         processEvent(&event);
+        _glfw.eventTime = 0;
     }
 
     _GLFWwindow* window = _glfw.x11.disabledCursorWindow;
@@ -2828,11 +3247,25 @@ void _glfwWaitEventsTimeoutX11(double timeout)
 
 void _glfwPostEmptyEventX11(void)
 {
-    writeEmptyEvent();
+    _glfwPostWakeupPOSIX(&_glfw.posixWakeup);
 }
 
 void _glfwGetCursorPosX11(_GLFWwindow* window, double* xpos, double* ypos)
 {
+    // While the cursor is in the window, every move of it is reported with
+    // a MotionNotify, so the position from the last one saves a round trip
+    if (window->x11.cursorInside &&
+        window->x11.cursorPosCurrent &&
+        !_glfw.hints.init.x11.cursorPosQuery)
+    {
+        if (xpos)
+            *xpos = window->x11.cursorPosX;
+        if (ypos)
+            *ypos = window->x11.cursorPosY;
+
+        return;
+    }
+
     Window root, child;
     int rootX, rootY, childX, childY;
     unsigned int mask;
@@ -2842,6 +3275,8 @@ void _glfwGetCursorPosX11(_GLFWwindow* window, double* xpos, double* ypos)
                   &rootX, &rootY, &childX, &childY,
                   &mask);
 
+    updateCursorPos(window, childX, childY);
+
     if (xpos)
         *xpos = childX;
     if (ypos)
@@ -2853,6 +3288,7 @@ void _glfwSetCursorPosX11(_GLFWwindow* window, double x, double y)
     // Store the new position so it can be recognized later
     window->x11.warpCursorPosX = (int) x;
     window->x11.warpCursorPosY = (int) y;
+    updateCursorPos(window, (int) x, (int) y);
 
     XWarpPointer(_glfw.x11.display, None, window->x11.handle,
                  0,0,0,0, (int) x, (int) y);
@@ -3353,5 +3789,18 @@ GLFWAPI const char* glfwGetX11SelectionString(void)
     return getSelectionString(_glfw.x11.PRIMARY);
 }
 
+GLFWAPI unsigned long glfwGetX11RoundTripCount(void)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    if (_glfw.platform.platformID != GLFW_PLATFORM_X11)
+    {
+        _glfwInputError(GLFW_PLATFORM_UNAVAILABLE, "X11: Platform not initialized");
+        return 0;
+    }
+
+    return _glfw.x11.roundTrips;
+}
+
 #endif // _GLFW_X11
 
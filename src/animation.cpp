@@ -0,0 +1,397 @@
+#include"animation.h"
+
+#include<cmath>
+#include<cstring>
+
+#include"job_system.h"
+
+#if defined(__SSE2__)||defined(_M_X64)||(defined(_M_IX86_FP)&&_M_IX86_FP>=2)
+#define ANIMATION_SSE2 1
+#include<emmintrin.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+//////                        4-wide vectors                        //////
+//////////////////////////////////////////////////////////////////////////
+
+// The kernels below are written once against this small vector type, which
+// maps to SSE2 where available and to plain loops elsewhere
+
+namespace {
+
+#ifdef ANIMATION_SSE2
+
+struct Float4 {
+    __m128 v;
+};
+
+inline Float4 make4(__m128 v) { Float4 r={v}; return r; }
+inline Float4 load4(const float* p) { return make4(_mm_loadu_ps(p)); }
+inline void store4(float* p, Float4 a) { _mm_storeu_ps(p,a.v); }
+inline Float4 splat(float x) { return make4(_mm_set1_ps(x)); }
+inline Float4 set4(float x, float y, float z, float w) { return make4(_mm_setr_ps(x,y,z,w)); }
+inline Float4 operator+(Float4 a, Float4 b) { return make4(_mm_add_ps(a.v,b.v)); }
+inline Float4 operator-(Float4 a, Float4 b) { return make4(_mm_sub_ps(a.v,b.v)); }
+inline Float4 operator*(Float4 a, Float4 b) { return make4(_mm_mul_ps(a.v,b.v)); }
+
+// Reciprocal square root estimate refined by one Newton-Raphson step, good to
+// about 22 bits
+inline Float4 rsqrt(Float4 a) {
+    const __m128 estimate=_mm_rsqrt_ps(a.v);
+    const __m128 half=_mm_mul_ps(_mm_set1_ps(0.5f),a.v);
+    const __m128 refine=_mm_sub_ps(_mm_set1_ps(1.5f),_mm_mul_ps(half,_mm_mul_ps(estimate,estimate)));
+    return make4(_mm_mul_ps(estimate,refine));
+}
+
+// a with its sign flipped wherever s is negative
+inline Float4 flipSign(Float4 a, Float4 s) {
+    return make4(_mm_xor_ps(a.v,_mm_and_ps(s.v,_mm_set1_ps(-0.f))));
+}
+
+inline void transpose(Float4& a, Float4& b, Float4& c, Float4& d) {
+    _MM_TRANSPOSE4_PS(a.v,b.v,c.v,d.v);
+}
+
+#else
+
+struct Float4 {
+    float v[4];
+};
+
+inline Float4 load4(const float* p) { Float4 r; std::memcpy(r.v,p,sizeof(r.v)); return r; }
+inline void store4(float* p, Float4 a) { std::memcpy(p,a.v,sizeof(a.v)); }
+inline Float4 splat(float x) { Float4 r={{x,x,x,x}}; return r; }
+inline Float4 set4(float x, float y, float z, float w) { Float4 r={{x,y,z,w}}; return r; }
+
+#define FLOAT4_OPERATOR(op) \
+    inline Float4 operator op(Float4 a, Float4 b) { \
+        Float4 r; \
+        for(int i=0;i<4;i++) r.v[i]=a.v[i] op b.v[i]; \
+        return r; \
+    }
+FLOAT4_OPERATOR(+)
+FLOAT4_OPERATOR(-)
+FLOAT4_OPERATOR(*)
+#undef FLOAT4_OPERATOR
+
+inline Float4 rsqrt(Float4 a) {
+    Float4 r;
+    for(int i=0;i<4;i++)
+        r.v[i]=1.f/std::sqrt(a.v[i]);
+    return r;
+}
+
+inline Float4 flipSign(Float4 a, Float4 s) {
+    Float4 r;
+    for(int i=0;i<4;i++)
+        r.v[i]=s.v[i]<0.f?-a.v[i]:a.v[i];
+    return r;
+}
+
+inline void transpose(Float4& a, Float4& b, Float4& c, Float4& d) {
+    Float4* m[4]={&a,&b,&c,&d};
+    for(int i=0;i<4;i++) {
+        for(int j=i+1;j<4;j++) {
+            float t=m[i]->v[j];
+            m[i]->v[j]=m[j]->v[i];
+            m[j]->v[i]=t;
+        }
+    }
+}
+
+#endif
+
+// out=a*b; out may alias b
+inline void multiply(const Affine& a, const Affine& b, Affine& out) {
+    const Float4 b0=load4(b.rows[0]);
+    const Float4 b1=load4(b.rows[1]);
+    const Float4 b2=load4(b.rows[2]);
+
+    Float4 rows[3];
+    for(int r=0;r<3;r++) {
+        rows[r]=splat(a.rows[r][0])*b0+splat(a.rows[r][1])*b1+splat(a.rows[r][2])*b2
+               +set4(0.f,0.f,0.f,a.rows[r][3]);
+    }
+    for(int r=0;r<3;r++)
+        store4(out.rows[r],rows[r]);
+}
+
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////                       Skeletons and clips                    //////
+//////////////////////////////////////////////////////////////////////////
+
+bool sortSkeleton(Skeleton& skeleton, std::vector<int>& remap) {
+    const int count=(int)skeleton.jointCount();
+    std::vector<std::vector<int> > children(count);
+    std::vector<int> order;
+    order.reserve(count);
+
+    for(int i=0;i<count;i++) {
+        const int parent=skeleton.parents[i];
+        if(parent<-1||parent>=count||parent==i)
+            return false;
+        if(parent<0)
+            order.push_back(i);
+        else
+            children[parent].push_back(i);
+    }
+
+    // Breadth first from the roots; joints on a cycle are never reached
+    for(size_t i=0;i<order.size();i++) {
+        const std::vector<int>& list=children[order[i]];
+        order.insert(order.end(),list.begin(),list.end());
+    }
+    if((int)order.size()!=count)
+        return false;
+
+    remap.assign(count,-1);
+    for(int i=0;i<count;i++)
+        remap[order[i]]=i;
+
+    std::vector<int> parents(count);
+    std::vector<Affine> inverseBind(count);
+    for(int i=0;i<count;i++) {
+        const int old=order[i];
+        parents[i]=skeleton.parents[old]<0?-1:remap[skeleton.parents[old]];
+        inverseBind[i]=skeleton.inverseBind[old];
+    }
+    skeleton.parents.swap(parents);
+    skeleton.inverseBind.swap(inverseBind);
+    return true;
+}
+
+void initClip(AnimationClip& clip, size_t jointCount, size_t keyCount, float sampleRate) {
+    clip.stride=(jointCount+3)&~(size_t)3;
+    clip.keyCount=keyCount?keyCount:1;
+    clip.sampleRate=sampleRate;
+    clip.keys.assign(clip.keyCount*POSE_CHANNEL_COUNT*clip.stride,0.f);
+
+    // Padding joints keep the identity too, so normalization never sees zero
+    for(size_t k=0;k<clip.keyCount;k++) {
+        float* key=&clip.keys[k*POSE_CHANNEL_COUNT*clip.stride];
+        for(size_t j=0;j<clip.stride;j++) {
+            key[POSE_QW*clip.stride+j]=1.f;
+            key[POSE_SX*clip.stride+j]=1.f;
+            key[POSE_SY*clip.stride+j]=1.f;
+            key[POSE_SZ*clip.stride+j]=1.f;
+        }
+    }
+}
+
+void setClipKey(AnimationClip& clip, size_t key, size_t joint,
+                const float translation[3], const float rotation[4], const float scale[3]) {
+    float* values=&clip.keys[key*POSE_CHANNEL_COUNT*clip.stride+joint];
+    for(int i=0;i<3;i++) {
+        values[(POSE_TX+i)*clip.stride]=translation[i];
+        values[(POSE_SX+i)*clip.stride]=scale[i];
+    }
+    for(int i=0;i<4;i++)
+        values[(POSE_QX+i)*clip.stride]=rotation[i];
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////                     Sampling and hierarchy                   //////
+//////////////////////////////////////////////////////////////////////////
+
+void sampleClip(const AnimationClip& clip, float time, LocalPose& pose) {
+    const size_t stride=clip.stride;
+    pose.stride=stride;
+    pose.channels.resize(stride*POSE_CHANNEL_COUNT);
+
+    size_t k0=0,k1=0;
+    float fraction=0.f;
+    const float duration=clip.duration();
+    if(duration>0.f) {
+        time=std::fmod(time,duration);
+        if(time<0.f)
+            time+=duration;
+        const float position=time*clip.sampleRate;
+        k0=(size_t)position;
+        if(k0>clip.keyCount-2)
+            k0=clip.keyCount-2;
+        k1=k0+1;
+        fraction=position-k0;
+    }
+
+    const float* a=&clip.keys[k0*POSE_CHANNEL_COUNT*stride];
+    const float* b=&clip.keys[k1*POSE_CHANNEL_COUNT*stride];
+    float* out=&pose.channels[0];
+    const Float4 t=splat(fraction);
+    static const int kLinearChannels[6]={POSE_TX,POSE_TY,POSE_TZ,POSE_SX,POSE_SY,POSE_SZ};
+
+    for(size_t j=0;j<stride;j+=4) {
+        for(int i=0;i<6;i++) {
+            const size_t offset=kLinearChannels[i]*stride+j;
+            const Float4 va=load4(a+offset);
+            store4(out+offset,va+(load4(b+offset)-va)*t);
+        }
+
+        Float4 qa[4],qb[4];
+        for(int i=0;i<4;i++) {
+            qa[i]=load4(a+(POSE_QX+i)*stride+j);
+            qb[i]=load4(b+(POSE_QX+i)*stride+j);
+        }
+
+        // Interpolate along the shorter arc: q and -q are the same rotation
+        const Float4 dot=qa[0]*qb[0]+qa[1]*qb[1]+qa[2]*qb[2]+qa[3]*qb[3];
+        Float4 q[4];
+        for(int i=0;i<4;i++)
+            q[i]=qa[i]+(flipSign(qb[i],dot)-qa[i])*t;
+
+        const Float4 scale=rsqrt(q[0]*q[0]+q[1]*q[1]+q[2]*q[2]+q[3]*q[3]);
+        for(int i=0;i<4;i++)
+            store4(out+(POSE_QX+i)*stride+j,q[i]*scale);
+    }
+}
+
+void localToModel(const Skeleton& skeleton, const LocalPose& pose, std::vector<Affine>& model) {
+    const size_t count=skeleton.jointCount();
+    const size_t stride=pose.stride;
+    const size_t padded=skeleton.paddedCount();
+    model.resize(padded);
+
+    // A pose from a clip with fewer joints leaves the rest at the identity, and
+    // one with more joints only has as many converted as the skeleton holds
+    const size_t posed=stride<padded?stride:padded;
+    for(size_t j=posed;j<padded;j++) {
+        std::memset(model[j].rows,0,sizeof(model[j].rows));
+        for(int r=0;r<3;r++)
+            model[j].rows[r][r]=1.f;
+    }
+
+    // Local matrices, four joints at a time: each channel vector holds one
+    // matrix element of four joints, and transposing turns them into rows
+    for(size_t j=0;j<posed;j+=4) {
+        const float* in=&pose.channels[j];
+        const Float4 tx=load4(in+POSE_TX*stride),ty=load4(in+POSE_TY*stride),tz=load4(in+POSE_TZ*stride);
+        const Float4 qx=load4(in+POSE_QX*stride),qy=load4(in+POSE_QY*stride);
+        const Float4 qz=load4(in+POSE_QZ*stride),qw=load4(in+POSE_QW*stride);
+        const Float4 sx=load4(in+POSE_SX*stride),sy=load4(in+POSE_SY*stride),sz=load4(in+POSE_SZ*stride);
+
+        const Float4 one=splat(1.f),two=splat(2.f);
+        const Float4 xx=qx*qx,yy=qy*qy,zz=qz*qz;
+        const Float4 xy=qx*qy,xz=qx*qz,yz=qy*qz;
+        const Float4 wx=qw*qx,wy=qw*qy,wz=qw*qz;
+
+        Float4 m[3][4];
+        m[0][0]=(one-two*(yy+zz))*sx;
+        m[0][1]=two*(xy-wz)*sy;
+        m[0][2]=two*(xz+wy)*sz;
+        m[0][3]=tx;
+        m[1][0]=two*(xy+wz)*sx;
+        m[1][1]=(one-two*(xx+zz))*sy;
+        m[1][2]=two*(yz-wx)*sz;
+        m[1][3]=ty;
+        m[2][0]=two*(xz-wy)*sx;
+        m[2][1]=two*(yz+wx)*sy;
+        m[2][2]=(one-two*(xx+yy))*sz;
+        m[2][3]=tz;
+
+        for(int r=0;r<3;r++) {
+            transpose(m[r][0],m[r][1],m[r][2],m[r][3]);
+            for(int k=0;k<4;k++)
+                store4(model[j+k].rows[r],m[r][k]);
+        }
+    }
+
+    // Parents precede children, so model[parent] is final when it is used
+    for(size_t i=0;i<count;i++) {
+        const int parent=skeleton.parents[i];
+        if(parent>=0)
+            multiply(model[parent],model[i],model[i]);
+    }
+    model.resize(count);
+}
+
+void buildSkinPalette(const Skeleton& skeleton, const std::vector<Affine>& model,
+                      std::vector<Affine>& palette) {
+    const size_t count=skeleton.jointCount();
+    palette.resize(count);
+    for(size_t i=0;i<count;i++)
+        multiply(model[i],skeleton.inverseBind[i],palette[i]);
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////                            Skinning                          //////
+//////////////////////////////////////////////////////////////////////////
+
+void skinVertices(const SkinnedMesh& skin, const std::vector<Affine>& palette,
+                  std::vector<Vertex>& vertices) {
+    const size_t count=skin.mesh.vertices.size();
+    vertices.resize(count);
+
+    for(size_t v=0;v<count;v++) {
+        const Vertex& in=skin.mesh.vertices[v];
+        const SkinWeights& influence=skin.weights[v];
+
+        // Blend the four matrices, then transpose to columns for the transform
+        Float4 c0=splat(0.f),c1=splat(0.f),c2=splat(0.f),c3=splat(0.f);
+        for(int i=0;i<4;i++) {
+            const Affine& m=palette[influence.joints[i]];
+            const Float4 w=splat(influence.weights[i]);
+            c0=c0+load4(m.rows[0])*w;
+            c1=c1+load4(m.rows[1])*w;
+            c2=c2+load4(m.rows[2])*w;
+        }
+        transpose(c0,c1,c2,c3);
+
+        float position[4],normal[4];
+        store4(position,c0*splat(in.position[0])+c1*splat(in.position[1])+c2*splat(in.position[2])+c3);
+        store4(normal,c0*splat(in.normal[0])+c1*splat(in.normal[1])+c2*splat(in.normal[2]));
+
+        const float length=std::sqrt(normal[0]*normal[0]+normal[1]*normal[1]+normal[2]*normal[2]);
+        const float scale=length>0.f?1.f/length:0.f;
+
+        Vertex& out=vertices[v];
+        for(int i=0;i<3;i++) {
+            out.position[i]=position[i];
+            out.normal[i]=normal[i]*scale;
+        }
+        out.texcoord[0]=in.texcoord[0];
+        out.texcoord[1]=in.texcoord[1];
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////                        Parallel update                       //////
+//////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+struct AnimationBatch {
+    AnimationInstance* instances;
+    float deltaTime;
+    bool skinning;
+};
+
+void updateAnimationChunk(size_t begin, size_t end, void* data) {
+    const AnimationBatch* batch=static_cast<const AnimationBatch*>(data);
+
+    // Scratch reused by every character this thread evaluates
+    static thread_local LocalPose pose;
+    static thread_local std::vector<Affine> model;
+
+    for(size_t i=begin;i<end;i++) {
+        AnimationInstance& instance=batch->instances[i];
+        instance.time+=batch->deltaTime*instance.speed;
+        const float duration=instance.clip->duration();
+        if(duration>0.f&&instance.time>=duration)
+            instance.time=std::fmod(instance.time,duration);
+
+        sampleClip(*instance.clip,instance.time,pose);
+        localToModel(*instance.skeleton,pose,model);
+        buildSkinPalette(*instance.skeleton,model,instance.palette);
+        if(batch->skinning&&instance.skin)
+            skinVertices(*instance.skin,instance.palette,instance.vertices);
+    }
+}
+
+}
+
+void updateAnimations(JobSystem& jobs, AnimationInstance* instances, size_t count,
+                      float deltaTime, bool skinning, size_t grain) {
+    AnimationBatch batch={instances,deltaTime,skinning};
+    jobs.parallelFor(count,grain,updateAnimationChunk,&batch);
+}
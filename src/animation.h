@@ -0,0 +1,114 @@
+#pragma once
+
+#include<cstdint>
+#include<vector>
+
+#include"mesh.h"
+
+class JobSystem;
+
+// Affine transform stored as the top three rows of a 4x4 matrix, row-major:
+// rows[r][3] is the translation.  Transforms column vectors.
+struct Affine {
+    float rows[3][4];
+};
+
+// Local joint transforms are stored as structure-of-arrays channels: every
+// channel holds one value per joint, padded to a multiple of four joints so
+// four joints are processed per SIMD instruction.
+enum PoseChannel {
+    POSE_TX, POSE_TY, POSE_TZ,
+    POSE_QX, POSE_QY, POSE_QZ, POSE_QW,
+    POSE_SX, POSE_SY, POSE_SZ,
+    POSE_CHANNEL_COUNT
+};
+
+// Joint hierarchy.  Joints are topologically sorted: every parent comes before
+// its children, so one forward pass computes all model-space transforms.
+struct Skeleton {
+    std::vector<int> parents;         // -1 for roots
+    std::vector<Affine> inverseBind;  // model space to joint space at bind time
+
+    size_t jointCount() const { return parents.size(); }
+    // Joint count rounded up to a multiple of four
+    size_t paddedCount() const { return (parents.size()+3)&~(size_t)3; }
+};
+
+// Local transforms of every joint, one channel after another
+struct LocalPose {
+    std::vector<float> channels;
+    size_t stride; // padded joint count
+
+    float* channel(int c) { return &channels[c*stride]; }
+    const float* channel(int c) const { return &channels[c*stride]; }
+};
+
+// Looping clip sampled at a fixed rate.  Key k of channel c starts at
+// keys[(k*POSE_CHANNEL_COUNT+c)*stride].  The first and last key should be
+// equal for seamless looping.
+struct AnimationClip {
+    std::vector<float> keys;
+    size_t stride;
+    size_t keyCount;
+    float sampleRate; // keys per second
+
+    float duration() const { return keyCount>1?(keyCount-1)/sampleRate:0.f; }
+};
+
+// Up to four joint influences per vertex; unused influences have zero weight
+struct SkinWeights {
+    uint16_t joints[4];
+    float weights[4];
+};
+
+// Bind-pose mesh with per-vertex influences
+struct SkinnedMesh {
+    Mesh mesh;
+    std::vector<SkinWeights> weights; // one per vertex
+};
+
+// One animated character
+struct AnimationInstance {
+    const Skeleton* skeleton;
+    const AnimationClip* clip;
+    const SkinnedMesh* skin;        // optional, for CPU skinning
+    float time;
+    float speed;
+
+    std::vector<Affine> palette;    // skinning matrices, one per joint
+    std::vector<Vertex> vertices;   // skinned vertices when skin is set
+};
+
+// Reorders the joints so parents precede their children, breadth first from
+// the roots, and fills remap[old]=new so clip tracks and skin weights can be
+// remapped.  Returns false if the parents contain a cycle or a bad index.
+bool sortSkeleton(Skeleton& skeleton, std::vector<int>& remap);
+
+// Allocates a clip with every key set to the identity transform
+void initClip(AnimationClip& clip, size_t jointCount, size_t keyCount, float sampleRate);
+void setClipKey(AnimationClip& clip, size_t key, size_t joint,
+                const float translation[3], const float rotation[4], const float scale[3]);
+
+// Samples the clip at time (wrapped to the clip duration), interpolating
+// translations and scales linearly and rotations with normalized lerp along
+// the shorter arc
+void sampleClip(const AnimationClip& clip, float time, LocalPose& pose);
+
+// Converts the local pose to model-space transforms of every joint.  Joints
+// the pose does not cover get the identity as their local transform.
+void localToModel(const Skeleton& skeleton, const LocalPose& pose, std::vector<Affine>& model);
+
+// palette[j]=model[j]*inverseBind[j]
+void buildSkinPalette(const Skeleton& skeleton, const std::vector<Affine>& model,
+                      std::vector<Affine>& palette);
+
+// Linear blend skinning of positions and normals.  Texture coordinates are
+// copied.  Normals are renormalized but not corrected for non-uniform scale.
+void skinVertices(const SkinnedMesh& skin, const std::vector<Affine>& palette,
+                  std::vector<Vertex>& vertices);
+
+// Advances every instance by deltaTime and rebuilds its palette, and its
+// skinned vertices when skinning is requested and the instance has a skin.
+// Characters are split across the job system in chunks of `grain`.
+void updateAnimations(JobSystem& jobs, AnimationInstance* instances, size_t count,
+                      float deltaTime, bool skinning, size_t grain=8);
@@ -1,8 +1,20 @@
 #pragma once
 
+#include<cstdio>
 #include<iostream>
+#include<string>
 #include<vector>
+// Project headers come first: they include glad for declarations only, and
+// the implementation below must be the last time it is included
+#include"mesh.h"
+#include"mesh_optimizer.h"
+#include"job_system.h"
+#include"text_renderer.h"
+#include"profiler.h"
+#ifdef HW1_HUD
+#include"hud.h"
+#endif
 #define GLAD_GL_IMPLEMENTATION
 #include <glad/gl.h>
 #define GLFW_INCLUDE_NONE
-#include<GLFW/glfw3.h>
\ No newline at end of file
+#include<GLFW/glfw3.h>
@@ -0,0 +1,102 @@
+#include"font_data.h"
+
+// ProggyClean by Tristan Grimmer (MIT license), as embedded in nuklear.h,
+// baked at 13 pixels and thresholded to one bit per pixel.  Each glyph is 13
+// rows; bit 6 of a row is the leftmost of its 7 columns.
+const unsigned char kFontGlyphs[kFontGlyphCount][kFontCellHeight]={
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, // space
+    {0x00,0x00,0x08,0x08,0x08,0x08,0x08,0x08,0x00,0x08,0x00,0x00,0x00}, // !
+    {0x00,0x14,0x14,0x14,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, // "
+    {0x00,0x00,0x0a,0x0a,0x3f,0x14,0x14,0x7e,0x28,0x28,0x00,0x00,0x00}, // #
+    {0x00,0x00,0x08,0x1e,0x28,0x28,0x1c,0x0a,0x0a,0x3c,0x08,0x00,0x00}, // $
+    {0x00,0x00,0x22,0x54,0x54,0x28,0x0a,0x15,0x15,0x22,0x00,0x00,0x00}, // %
+    {0x00,0x00,0x18,0x24,0x24,0x19,0x25,0x22,0x22,0x1d,0x00,0x00,0x00}, // &
+    {0x00,0x08,0x08,0x08,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, // '
+    {0x00,0x04,0x08,0x08,0x10,0x10,0x10,0x10,0x10,0x08,0x08,0x04,0x00}, // (
+    {0x00,0x10,0x08,0x08,0x04,0x04,0x04,0x04,0x04,0x08,0x08,0x10,0x00}, // )
+    {0x00,0x00,0x00,0x00,0x08,0x2a,0x1c,0x2a,0x08,0x00,0x00,0x00,0x00}, // *
+    {0x00,0x00,0x00,0x00,0x08,0x08,0x3e,0x08,0x08,0x00,0x00,0x00,0x00}, // +
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x10,0x10,0x10,0x20,0x00}, // ,
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x3e,0x00,0x00,0x00,0x00,0x00,0x00}, // -
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x10,0x10,0x00,0x00,0x00}, // .
+    {0x00,0x02,0x02,0x04,0x04,0x08,0x08,0x10,0x10,0x20,0x20,0x00,0x00}, // /
+    {0x00,0x00,0x1c,0x22,0x22,0x2a,0x2a,0x22,0x22,0x1c,0x00,0x00,0x00}, // 0
+    {0x00,0x00,0x08,0x18,0x28,0x08,0x08,0x08,0x08,0x3e,0x00,0x00,0x00}, // 1
+    {0x00,0x00,0x1c,0x22,0x02,0x04,0x08,0x10,0x20,0x3e,0x00,0x00,0x00}, // 2
+    {0x00,0x00,0x1c,0x22,0x02,0x0c,0x02,0x02,0x22,0x1c,0x00,0x00,0x00}, // 3
+    {0x00,0x00,0x02,0x06,0x0a,0x12,0x22,0x3f,0x02,0x02,0x00,0x00,0x00}, // 4
+    {0x00,0x00,0x3e,0x20,0x20,0x3c,0x02,0x02,0x22,0x1c,0x00,0x00,0x00}, // 5
+    {0x00,0x00,0x0c,0x10,0x20,0x3c,0x22,0x22,0x22,0x1c,0x00,0x00,0x00}, // 6
+    {0x00,0x00,0x3e,0x02,0x04,0x04,0x08,0x08,0x10,0x10,0x00,0x00,0x00}, // 7
+    {0x00,0x00,0x1c,0x22,0x22,0x1c,0x22,0x22,0x22,0x1c,0x00,0x00,0x00}, // 8
+    {0x00,0x00,0x1c,0x22,0x22,0x22,0x1e,0x02,0x04,0x18,0x00,0x00,0x00}, // 9
+    {0x00,0x00,0x00,0x00,0x08,0x08,0x00,0x00,0x08,0x08,0x00,0x00,0x00}, // :
+    {0x00,0x00,0x00,0x00,0x10,0x10,0x00,0x00,0x10,0x10,0x10,0x20,0x00}, // ;
+    {0x00,0x00,0x00,0x00,0x06,0x18,0x60,0x18,0x06,0x00,0x00,0x00,0x00}, // <
+    {0x00,0x00,0x00,0x00,0x00,0x3f,0x00,0x3f,0x00,0x00,0x00,0x00,0x00}, // =
+    {0x00,0x00,0x00,0x00,0x30,0x0c,0x03,0x0c,0x30,0x00,0x00,0x00,0x00}, // >
+    {0x00,0x00,0x1c,0x22,0x02,0x04,0x08,0x08,0x00,0x08,0x00,0x00,0x00}, // ?
+    {0x00,0x00,0x1c,0x22,0x4d,0x55,0x55,0x4e,0x20,0x1e,0x00,0x00,0x00}, // @
+    {0x00,0x00,0x0c,0x0c,0x12,0x12,0x1e,0x21,0x21,0x21,0x00,0x00,0x00}, // A
+    {0x00,0x00,0x3c,0x22,0x22,0x3e,0x21,0x21,0x21,0x3e,0x00,0x00,0x00}, // B
+    {0x00,0x00,0x0e,0x11,0x20,0x20,0x20,0x20,0x11,0x0e,0x00,0x00,0x00}, // C
+    {0x00,0x00,0x3c,0x22,0x21,0x21,0x21,0x21,0x22,0x3c,0x00,0x00,0x00}, // D
+    {0x00,0x00,0x3e,0x20,0x20,0x3c,0x20,0x20,0x20,0x3e,0x00,0x00,0x00}, // E
+    {0x00,0x00,0x3e,0x20,0x20,0x3c,0x20,0x20,0x20,0x20,0x00,0x00,0x00}, // F
+    {0x00,0x00,0x0e,0x11,0x20,0x20,0x27,0x21,0x11,0x0e,0x00,0x00,0x00}, // G
+    {0x00,0x00,0x21,0x21,0x21,0x3f,0x21,0x21,0x21,0x21,0x00,0x00,0x00}, // H
+    {0x00,0x00,0x1c,0x08,0x08,0x08,0x08,0x08,0x08,0x1c,0x00,0x00,0x00}, // I
+    {0x00,0x00,0x1c,0x04,0x04,0x04,0x04,0x04,0x04,0x38,0x00,0x00,0x00}, // J
+    {0x00,0x00,0x21,0x22,0x24,0x28,0x38,0x24,0x22,0x21,0x00,0x00,0x00}, // K
+    {0x00,0x00,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x3e,0x00,0x00,0x00}, // L
+    {0x00,0x00,0x63,0x63,0x55,0x55,0x49,0x49,0x41,0x41,0x00,0x00,0x00}, // M
+    {0x00,0x00,0x31,0x31,0x29,0x29,0x25,0x25,0x23,0x23,0x00,0x00,0x00}, // N
+    {0x00,0x00,0x0c,0x12,0x21,0x21,0x21,0x21,0x12,0x0c,0x00,0x00,0x00}, // O
+    {0x00,0x00,0x3c,0x22,0x22,0x22,0x3c,0x20,0x20,0x20,0x00,0x00,0x00}, // P
+    {0x00,0x00,0x0c,0x12,0x21,0x21,0x21,0x21,0x12,0x0d,0x01,0x00,0x00}, // Q
+    {0x00,0x00,0x3c,0x22,0x22,0x22,0x3c,0x24,0x22,0x21,0x00,0x00,0x00}, // R
+    {0x00,0x00,0x1e,0x21,0x20,0x18,0x06,0x01,0x21,0x1e,0x00,0x00,0x00}, // S
+    {0x00,0x00,0x7f,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x00,0x00,0x00}, // T
+    {0x00,0x00,0x21,0x21,0x21,0x21,0x21,0x21,0x21,0x1e,0x00,0x00,0x00}, // U
+    {0x00,0x00,0x41,0x41,0x22,0x22,0x14,0x14,0x08,0x08,0x00,0x00,0x00}, // V
+    {0x00,0x00,0x41,0x49,0x49,0x55,0x55,0x36,0x22,0x22,0x00,0x00,0x00}, // W
+    {0x00,0x00,0x21,0x21,0x12,0x0c,0x0c,0x12,0x21,0x21,0x00,0x00,0x00}, // X
+    {0x00,0x00,0x41,0x41,0x22,0x14,0x08,0x08,0x08,0x08,0x00,0x00,0x00}, // Y
+    {0x00,0x00,0x3f,0x01,0x02,0x04,0x08,0x10,0x20,0x3f,0x00,0x00,0x00}, // Z
+    {0x00,0x1c,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x1c,0x00}, // [
+    {0x00,0x20,0x20,0x10,0x10,0x08,0x08,0x04,0x04,0x02,0x02,0x00,0x00}, // backslash
+    {0x00,0x1c,0x04,0x04,0x04,0x04,0x04,0x04,0x04,0x04,0x04,0x1c,0x00}, // ]
+    {0x00,0x08,0x08,0x14,0x14,0x22,0x22,0x00,0x00,0x00,0x00,0x00,0x00}, // ^
+    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7f,0x00,0x00}, // _
+    {0x00,0x10,0x08,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, // `
+    {0x00,0x00,0x00,0x00,0x1c,0x02,0x1e,0x22,0x22,0x1e,0x00,0x00,0x00}, // a
+    {0x00,0x20,0x20,0x20,0x3c,0x22,0x22,0x22,0x22,0x3c,0x00,0x00,0x00}, // b
+    {0x00,0x00,0x00,0x00,0x1c,0x22,0x20,0x20,0x22,0x1c,0x00,0x00,0x00}, // c
+    {0x00,0x02,0x02,0x02,0x1e,0x22,0x22,0x22,0x22,0x1e,0x00,0x00,0x00}, // d
+    {0x00,0x00,0x00,0x00,0x1c,0x22,0x3e,0x20,0x22,0x1c,0x00,0x00,0x00}, // e
+    {0x00,0x0e,0x10,0x10,0x3c,0x10,0x10,0x10,0x10,0x10,0x00,0x00,0x00}, // f
+    {0x00,0x00,0x00,0x00,0x1e,0x22,0x22,0x22,0x22,0x1e,0x02,0x02,0x1c}, // g
+    {0x00,0x20,0x20,0x20,0x3c,0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x00}, // h
+    {0x00,0x08,0x00,0x00,0x18,0x08,0x08,0x08,0x08,0x08,0x00,0x00,0x00}, // i
+    {0x00,0x04,0x00,0x00,0x0c,0x04,0x04,0x04,0x04,0x04,0x04,0x38,0x00}, // j
+    {0x00,0x20,0x20,0x20,0x22,0x24,0x28,0x38,0x24,0x22,0x00,0x00,0x00}, // k
+    {0x00,0x18,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x00,0x00,0x00}, // l
+    {0x00,0x00,0x00,0x00,0x76,0x49,0x49,0x49,0x49,0x49,0x00,0x00,0x00}, // m
+    {0x00,0x00,0x00,0x00,0x3c,0x22,0x22,0x22,0x22,0x22,0x00,0x00,0x00}, // n
+    {0x00,0x00,0x00,0x00,0x1c,0x22,0x22,0x22,0x22,0x1c,0x00,0x00,0x00}, // o
+    {0x00,0x00,0x00,0x00,0x3c,0x22,0x22,0x22,0x22,0x3c,0x20,0x20,0x20}, // p
+    {0x00,0x00,0x00,0x00,0x1e,0x22,0x22,0x22,0x22,0x1e,0x02,0x02,0x02}, // q
+    {0x00,0x00,0x00,0x00,0x2c,0x32,0x20,0x20,0x20,0x20,0x00,0x00,0x00}, // r
+    {0x00,0x00,0x00,0x00,0x1e,0x20,0x18,0x04,0x02,0x3c,0x00,0x00,0x00}, // s
+    {0x00,0x00,0x10,0x10,0x1e,0x10,0x10,0x10,0x10,0x0e,0x00,0x00,0x00}, // t
+    {0x00,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x1e,0x00,0x00,0x00}, // u
+    {0x00,0x00,0x00,0x00,0x22,0x22,0x14,0x14,0x08,0x08,0x00,0x00,0x00}, // v
+    {0x00,0x00,0x00,0x00,0x41,0x49,0x49,0x55,0x36,0x22,0x00,0x00,0x00}, // w
+    {0x00,0x00,0x00,0x00,0x22,0x14,0x08,0x08,0x14,0x22,0x00,0x00,0x00}, // x
+    {0x00,0x00,0x00,0x00,0x22,0x22,0x22,0x22,0x22,0x1e,0x02,0x02,0x1c}, // y
+    {0x00,0x00,0x00,0x00,0x3e,0x02,0x04,0x08,0x10,0x3e,0x00,0x00,0x00}, // z
+    {0x00,0x06,0x08,0x08,0x08,0x08,0x30,0x08,0x08,0x08,0x08,0x06,0x00}, // {
+    {0x00,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x00}, // |
+    {0x00,0x30,0x08,0x08,0x08,0x08,0x06,0x08,0x08,0x08,0x08,0x30,0x00}, // }
+    {0x00,0x00,0x00,0x00,0x00,0x39,0x4e,0x00,0x00,0x00,0x00,0x00,0x00} // ~
+};
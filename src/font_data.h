@@ -0,0 +1,11 @@
+#pragma once
+
+// Built-in monospace bitmap font covering printable ASCII
+const int kFontFirstChar=32;
+const int kFontGlyphCount=95;
+const int kFontCellWidth=7;
+const int kFontCellHeight=13;
+// Distance from the top of the cell to the baseline
+const int kFontBaseline=10;
+
+extern const unsigned char kFontGlyphs[kFontGlyphCount][kFontCellHeight];
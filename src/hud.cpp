@@ -0,0 +1,125 @@
+#include"hud.h"
+
+#include<algorithm>
+
+#define GLFW_INCLUDE_NONE
+#include<GLFW/glfw3.h>
+
+#define NK_IMPLEMENTATION
+#define NK_INCLUDE_FIXED_TYPES
+#define NK_INCLUDE_FONT_BAKING
+#define NK_INCLUDE_DEFAULT_FONT
+#define NK_INCLUDE_DEFAULT_ALLOCATOR
+#define NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+#define NK_INCLUDE_STANDARD_VARARGS
+#define NK_BUTTON_TRIGGER_ON_RELEASE
+#include<nuklear.h>
+
+#define NK_GLFW_GL2_IMPLEMENTATION
+#include<nuklear_glfw_gl2.h>
+
+static const float kHudWidth=320.f;
+static const float kHudHeight=470.f;
+static const float kGraphHeight=60.f;
+
+Hud::Hud(GLFWwindow* window) : window(window), visible(true), toggleDown(false) {
+    context=nk_glfw3_init(window,NK_GLFW3_INSTALL_CALLBACKS);
+
+    struct nk_font_atlas* atlas;
+    nk_glfw3_font_stash_begin(&atlas);
+    nk_glfw3_font_stash_end();
+}
+
+Hud::~Hud() {
+    nk_glfw3_shutdown();
+}
+
+// Plots the values on a fixed scale so the graph does not jump around
+static void graph(nk_context* context, const float* values, float scale, struct nk_color color) {
+    nk_layout_row_dynamic(context,kGraphHeight,1);
+    if(nk_chart_begin_colored(context,NK_CHART_LINES,color,color,kProfilerHistory,0.f,scale)) {
+        for(int i=0;i<kProfilerHistory;i++)
+            nk_chart_push(context,values[i]);
+        nk_chart_end(context);
+    }
+}
+
+// Scale of the graphs: the smallest of 1/60 s, 1/30 s, 1/15 s, ... above the
+// largest value
+static float graphScale(const float* values) {
+    float largest=0.f;
+    for(int i=0;i<kProfilerHistory;i++)
+        largest=std::max(largest,values[i]);
+    float scale=1000.f/60.f;
+    while(scale<largest)
+        scale*=2.f;
+    return scale;
+}
+
+static bool checkbox(nk_context* context, const char* label, bool value) {
+    int active=value;
+    nk_checkbox_label(context,label,&active);
+    return active!=0;
+}
+
+void Hud::draw(const Profiler& profiler, RenderSettings& settings) {
+    const bool down=glfwGetKey(window,GLFW_KEY_F1)==GLFW_PRESS;
+    if(down&&!toggleDown)
+        visible=!visible;
+    toggleDown=down;
+    if(!visible)
+        return;
+
+    int width,height;
+    glfwGetWindowSize(window,&width,&height);
+
+    nk_glfw3_new_frame();
+    const struct nk_rect bounds=nk_rect(std::max(0.f,width-kHudWidth-10.f),10.f,kHudWidth,kHudHeight);
+    const nk_flags flags=NK_WINDOW_BORDER|NK_WINDOW_MOVABLE|NK_WINDOW_SCALABLE|NK_WINDOW_MINIMIZABLE|NK_WINDOW_TITLE;
+    if(nk_begin(context,"Performance (F1)",bounds,flags)) {
+        const float* frames=profiler.frameTimes();
+        nk_layout_row_dynamic(context,16,1);
+        nk_labelf(context,NK_TEXT_LEFT,"Frame %.2f ms  avg %.2f ms  max %.2f ms",
+                  frames[kProfilerHistory-1],profiler.averageFrameTime(),profiler.maxFrameTime());
+        graph(context,frames,graphScale(frames),nk_rgb(110,200,110));
+
+        if(profiler.hasGpuTimers()) {
+            const float* gpu=profiler.gpuTimes();
+            nk_layout_row_dynamic(context,16,1);
+            nk_labelf(context,NK_TEXT_LEFT,"GPU %.2f ms",gpu[kProfilerHistory-1]);
+            graph(context,gpu,graphScale(gpu),nk_rgb(110,160,230));
+        }
+
+        nk_layout_row_dynamic(context,16,3);
+        nk_label(context,"Zone",NK_TEXT_LEFT);
+        nk_label(context,"CPU ms",NK_TEXT_RIGHT);
+        nk_label(context,"GPU ms",NK_TEXT_RIGHT);
+        for(int i=0;i<profiler.zoneCount();i++) {
+            const ZoneTiming& timing=profiler.zoneTiming(i);
+            nk_label(context,timing.name,NK_TEXT_LEFT);
+            nk_labelf(context,NK_TEXT_RIGHT,"%.3f",timing.cpuMs);
+            if(timing.gpuMs>=0.0)
+                nk_labelf(context,NK_TEXT_RIGHT,"%.3f",timing.gpuMs);
+            else
+                nk_label(context,"n/a",NK_TEXT_RIGHT);
+        }
+
+        const RenderCounters& counters=profiler.lastCounters();
+        nk_layout_row_dynamic(context,16,2);
+        nk_label(context,"Draw calls",NK_TEXT_LEFT);
+        nk_labelf(context,NK_TEXT_RIGHT,"%u",counters.drawCalls);
+        nk_label(context,"State changes",NK_TEXT_LEFT);
+        nk_labelf(context,NK_TEXT_RIGHT,"%u",counters.stateChanges);
+        nk_label(context,"Triangles",NK_TEXT_LEFT);
+        nk_labelf(context,NK_TEXT_RIGHT,"%lu",counters.triangles);
+        nk_label(context,"Allocations/frame",NK_TEXT_LEFT);
+        nk_labelf(context,NK_TEXT_RIGHT,"%lu",profiler.lastAllocations());
+
+        nk_layout_row_dynamic(context,20,1);
+        settings.cullBackFaces=checkbox(context,"Cull back faces",settings.cullBackFaces);
+        settings.batchMeshes=checkbox(context,"Batch mesh state",settings.batchMeshes);
+        settings.batchText=checkbox(context,"Batch text",settings.batchText);
+    }
+    nk_end(context);
+    nk_glfw3_render(NK_ANTI_ALIASING_ON);
+}
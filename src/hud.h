@@ -0,0 +1,31 @@
+#pragma once
+
+#include"profiler.h"
+
+struct GLFWwindow;
+struct nk_context;
+
+// Performance HUD drawn with the Nuklear GL2 backend bundled with GLFW
+//
+// Shows the frame-time and GPU-time graphs, the CPU and GPU time of every
+// profiler zone, allocation counts and render counters, and lets the render
+// settings be changed.  F1 shows and hides it.  The HUD is not built when
+// HW1_ENABLE_HUD is off.
+class Hud {
+public:
+    // Installs Nuklear's scroll, character and mouse button callbacks
+    explicit Hud(GLFWwindow* window);
+    ~Hud();
+
+    // Builds and renders the HUD; time this call with a profiler zone to have
+    // the HUD show its own cost
+    void draw(const Profiler& profiler, RenderSettings& settings);
+
+    bool isVisible() const { return visible; }
+
+private:
+    GLFWwindow* window;
+    nk_context* context;
+    bool visible;
+    bool toggleDown;
+};
@@ -0,0 +1,409 @@
+#include"job_system.h"
+
+#include<thread>
+
+// Jobs are recycled from a fixed ring per submitting thread.  When the next
+// job in the ring is still unfinished, or the submitting thread does not belong
+// to the job system, the job is allocated on the heap instead.
+static const size_t kJobPoolSize=4096;
+static const size_t kDequeCapacity=kJobPoolSize;
+
+// Failed attempts to find work before an idle worker goes to sleep
+static const int kSpinCount=64;
+
+struct Job {
+    JobFunction function;
+    void* data;
+    JobCounter* counter;
+    JobAffinity affinity;
+    // Set while a pooled job is queued or running, cleared once it has run
+    std::atomic<bool> busy;
+    bool pooled;
+};
+
+// Job system the calling thread belongs to, if any, and its index in that
+// system's deques
+static thread_local const JobSystem* threadSystem=NULL;
+static thread_local int threadIndex=-1;
+
+JobCounter::JobCounter() : value(0) {
+    mtx_init(&lock,mtx_plain);
+}
+
+JobCounter::~JobCounter() {
+    mtx_destroy(&lock);
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////                       Chase-Lev deque                        //////
+//////////////////////////////////////////////////////////////////////////
+
+// Memory orderings follow Lê, Pop, Cohen and Zappa Nardelli, "Correct and
+// Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013)
+
+JobDeque::JobDeque(size_t capacity) : buffer(capacity), mask(capacity-1), top(0), bottom(0) {
+    for(size_t i=0;i<capacity;i++)
+        buffer[i].store(NULL,std::memory_order_relaxed);
+}
+
+bool JobDeque::push(Job* job) {
+    long b=bottom.load(std::memory_order_relaxed);
+    long t=top.load(std::memory_order_acquire);
+    if(b-t>(long)mask)
+        return false;
+
+    buffer[b&mask].store(job,std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b+1,std::memory_order_relaxed);
+    return true;
+}
+
+Job* JobDeque::pop() {
+    long b=bottom.load(std::memory_order_relaxed)-1;
+    bottom.store(b,std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    long t=top.load(std::memory_order_relaxed);
+
+    if(t>b) {
+        bottom.store(b+1,std::memory_order_relaxed);
+        return NULL;
+    }
+
+    Job* job=buffer[b&mask].load(std::memory_order_relaxed);
+    if(t==b) {
+        // Last item: race against thieves for it
+        if(!top.compare_exchange_strong(t,t+1,std::memory_order_seq_cst,std::memory_order_relaxed))
+            job=NULL;
+        bottom.store(b+1,std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* JobDeque::steal() {
+    long t=top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    long b=bottom.load(std::memory_order_acquire);
+    if(t>=b)
+        return NULL;
+
+    Job* job=buffer[t&mask].load(std::memory_order_relaxed);
+    if(!top.compare_exchange_strong(t,t+1,std::memory_order_seq_cst,std::memory_order_relaxed))
+        return NULL;
+    return job;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////                          Job system                          //////
+//////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+struct WorkerStart {
+    JobSystem* system;
+    int index;
+};
+
+struct ParallelForChunk {
+    ParallelForFunction function;
+    void* data;
+    size_t begin, end;
+};
+
+void runParallelForChunk(void* data) {
+    ParallelForChunk* chunk=static_cast<ParallelForChunk*>(data);
+    chunk->function(chunk->begin,chunk->end,chunk->data);
+}
+
+}
+
+JobSystem::JobSystem(int workerCount) : sharedCount(0), queued(0), sleeping(0), quit(false) {
+    if(workerCount<0) {
+        int hardware=(int)std::thread::hardware_concurrency();
+        workerCount=hardware>1?hardware-1:0;
+    }
+
+    const int total=workerCount+1;
+    for(int i=0;i<total;i++) {
+        deques.push_back(new JobDeque(kDequeCapacity));
+        pools.push_back(new Job[kJobPoolSize]);
+        poolCursors.push_back(0);
+        for(size_t j=0;j<kJobPoolSize;j++) {
+            pools[i][j].busy.store(false,std::memory_order_relaxed);
+            pools[i][j].pooled=true;
+        }
+    }
+
+    mtx_init(&mainLock,mtx_plain);
+    mtx_init(&sharedLock,mtx_plain);
+    mtx_init(&sleepLock,mtx_plain);
+    cnd_init(&wakeup);
+
+    threadSystem=this;
+    threadIndex=0;
+
+    threads.resize(workerCount);
+    for(int i=0;i<workerCount;i++) {
+        WorkerStart* start=new WorkerStart;
+        start->system=this;
+        start->index=i+1;
+        thrd_create(&threads[i],workerMain,start);
+    }
+}
+
+JobSystem::~JobSystem() {
+    quit.store(true);
+    mtx_lock(&sleepLock);
+    cnd_broadcast(&wakeup);
+    mtx_unlock(&sleepLock);
+
+    for(size_t i=0;i<threads.size();i++)
+        thrd_join(threads[i],NULL);
+
+    for(size_t i=0;i<deques.size();i++) {
+        delete deques[i];
+        delete[] pools[i];
+    }
+
+    cnd_destroy(&wakeup);
+    mtx_destroy(&sleepLock);
+    mtx_destroy(&sharedLock);
+    mtx_destroy(&mainLock);
+    if(threadSystem==this) {
+        threadSystem=NULL;
+        threadIndex=-1;
+    }
+}
+
+int JobSystem::workerMain(void* data) {
+    WorkerStart* start=static_cast<WorkerStart*>(data);
+    JobSystem* system=start->system;
+    const int index=start->index;
+    delete start;
+
+    threadSystem=system;
+    threadIndex=index;
+
+    while(!system->quit.load()) {
+        Job* job=NULL;
+        for(int spin=0;spin<kSpinCount&&!job;spin++) {
+            job=system->findJob(index);
+            if(!job)
+                thrd_yield();
+        }
+
+        if(job) {
+            system->execute(job);
+            continue;
+        }
+
+        // Announce sleeping before re-checking the queue so a concurrent
+        // submit either sees the sleeper or the sleeper sees the job
+        mtx_lock(&system->sleepLock);
+        system->sleeping.fetch_add(1);
+        while(!system->quit.load()&&system->queued.load()==0)
+            cnd_wait(&system->wakeup,&system->sleepLock);
+        system->sleeping.fetch_sub(1);
+        mtx_unlock(&system->sleepLock);
+    }
+
+    return 0;
+}
+
+// Returns the index of the calling thread in deques, or -1 when it belongs to
+// another job system or to none
+int JobSystem::currentThreadIndex() const {
+    return threadSystem==this?threadIndex:-1;
+}
+
+Job* JobSystem::allocateJob() {
+    // Only the owning thread allocates from a pool, but any thread may release
+    // a pooled job after running it
+    const int index=currentThreadIndex();
+    if(index>=0) {
+        Job* job=&pools[index][poolCursors[index]];
+        if(!job->busy.load(std::memory_order_acquire)) {
+            job->busy.store(true,std::memory_order_relaxed);
+            poolCursors[index]=(poolCursors[index]+1)&(kJobPoolSize-1);
+            return job;
+        }
+    }
+
+    Job* job=new Job;
+    job->pooled=false;
+    return job;
+}
+
+void JobSystem::releaseJob(Job* job) {
+    if(job->pooled)
+        job->busy.store(false,std::memory_order_release);
+    else
+        delete job;
+}
+
+void JobSystem::run(JobFunction function, void* data, JobCounter* counter,
+                    JobCounter* dependency, JobAffinity affinity) {
+    Job* job=allocateJob();
+    job->function=function;
+    job->data=data;
+    job->counter=counter;
+    job->affinity=affinity;
+
+    if(counter)
+        counter->value.fetch_add(1);
+
+    if(dependency) {
+        mtx_lock(&dependency->lock);
+        if(!dependency->done()) {
+            dependency->continuations.push_back(job);
+            mtx_unlock(&dependency->lock);
+            return;
+        }
+        mtx_unlock(&dependency->lock);
+    }
+
+    submit(job);
+}
+
+void JobSystem::submit(Job* job) {
+    if(job->affinity==JOB_MAIN_THREAD) {
+        mtx_lock(&mainLock);
+        mainJobs.push_back(job);
+        mtx_unlock(&mainLock);
+        return;
+    }
+
+    // Count the job before publishing it so a thief never sees it uncounted
+    const int index=currentThreadIndex();
+    queued.fetch_add(1);
+    if(index<0) {
+        // Threads outside the job system own no deque
+        mtx_lock(&sharedLock);
+        sharedJobs.push_back(job);
+        sharedCount.fetch_add(1);
+        mtx_unlock(&sharedLock);
+    }
+    else if(!deques[index]->push(job)) {
+        // The deque is full; running the job inline is always correct
+        queued.fetch_sub(1);
+        execute(job);
+        return;
+    }
+
+    if(sleeping.load()>0) {
+        mtx_lock(&sleepLock);
+        cnd_signal(&wakeup);
+        mtx_unlock(&sleepLock);
+    }
+}
+
+Job* JobSystem::findJob(int index) {
+    Job* job=index<0?NULL:deques[index]->pop();
+
+    if(!job&&index==0) {
+        mtx_lock(&mainLock);
+        if(!mainJobs.empty()) {
+            job=mainJobs.front();
+            mainJobs.pop_front();
+        }
+        mtx_unlock(&mainLock);
+        if(job)
+            return job;
+    }
+
+    if(!job&&sharedCount.load()>0) {
+        mtx_lock(&sharedLock);
+        if(!sharedJobs.empty()) {
+            job=sharedJobs.front();
+            sharedJobs.pop_front();
+            sharedCount.fetch_sub(1);
+        }
+        mtx_unlock(&sharedLock);
+    }
+
+    // Threads outside the job system may steal from every deque
+    const int count=(int)deques.size();
+    const int victims=index<0?count:count-1;
+    for(int i=0;i<victims&&!job;i++)
+        job=deques[(index+1+i)%count]->steal();
+
+    if(job)
+        queued.fetch_sub(1);
+    return job;
+}
+
+void JobSystem::execute(Job* job) {
+    JobCounter* counter=job->counter;
+    job->function(job->data);
+    releaseJob(job);
+    finish(counter);
+}
+
+void JobSystem::finish(JobCounter* counter) {
+    if(!counter)
+        return;
+
+    // Decrements that leave other jobs outstanding need no lock
+    int value=counter->value.load(std::memory_order_relaxed);
+    while(value>1) {
+        if(counter->value.compare_exchange_weak(value,value-1,std::memory_order_acq_rel))
+            return;
+    }
+
+    // The counter may be destroyed as soon as it reads zero, so the last
+    // decrement happens under its lock, which wait takes before returning
+    std::vector<Job*> ready;
+    mtx_lock(&counter->lock);
+    if(counter->value.fetch_sub(1)==1)
+        ready.swap(counter->continuations);
+    mtx_unlock(&counter->lock);
+
+    for(size_t i=0;i<ready.size();i++)
+        submit(ready[i]);
+}
+
+void JobSystem::wait(JobCounter* counter) {
+    const int index=currentThreadIndex();
+    while(!counter->done()) {
+        Job* job=findJob(index);
+        if(job)
+            execute(job);
+        else
+            thrd_yield();
+    }
+
+    // Wait for the thread that made the last decrement to let go of the counter
+    mtx_lock(&counter->lock);
+    mtx_unlock(&counter->lock);
+}
+
+void JobSystem::runMainThreadJobs() {
+    std::deque<Job*> jobs;
+    mtx_lock(&mainLock);
+    jobs.swap(mainJobs);
+    mtx_unlock(&mainLock);
+
+    for(size_t i=0;i<jobs.size();i++)
+        execute(jobs[i]);
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, ParallelForFunction function, void* data) {
+    if(grain==0)
+        grain=1;
+    // Keep the number of chunks in flight well inside the job pool
+    const size_t maxChunks=kJobPoolSize/2;
+    if((count+grain-1)/grain>maxChunks)
+        grain=(count+maxChunks-1)/maxChunks;
+
+    std::vector<ParallelForChunk> chunks((count+grain-1)/grain);
+    JobCounter counter;
+
+    for(size_t i=0;i<chunks.size();i++) {
+        chunks[i].function=function;
+        chunks[i].data=data;
+        chunks[i].begin=i*grain;
+        chunks[i].end=i*grain+grain<count?i*grain+grain:count;
+        run(runParallelForChunk,&chunks[i],&counter);
+    }
+
+    wait(&counter);
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include<atomic>
+#include<cstddef>
+#include<deque>
+#include<vector>
+
+extern "C" {
+#include<tinycthread.h>
+}
+
+typedef void (*JobFunction)(void* data);
+typedef void (*ParallelForFunction)(size_t begin, size_t end, void* data);
+
+// Where a job is allowed to run
+enum JobAffinity {
+    JOB_ANY_THREAD,
+    // Only run by the main thread from JobSystem::wait or
+    // JobSystem::runMainThreadJobs, e.g. for anything touching the GL context
+    JOB_MAIN_THREAD
+};
+
+struct Job;
+
+// Counts unfinished jobs.  Jobs submitted with a counter increment it and
+// decrement it when they finish; jobs submitted with a counter as their
+// dependency are held back until it reaches zero.
+class JobCounter {
+public:
+    JobCounter();
+    ~JobCounter();
+
+    bool done() const { return value.load(std::memory_order_acquire)==0; }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<int> value;
+    mtx_t lock;
+    std::vector<Job*> continuations;
+};
+
+// Chase-Lev work-stealing deque of job pointers.  Only the owning thread may
+// push and pop; any thread may steal.
+class JobDeque {
+public:
+    explicit JobDeque(size_t capacity);
+
+    bool push(Job* job);
+    Job* pop();
+    Job* steal();
+
+private:
+    std::vector<std::atomic<Job*> > buffer;
+    size_t mask;
+    std::atomic<long> top;
+    std::atomic<long> bottom;
+};
+
+// Work-stealing job system
+//
+// Every worker thread, plus the main thread that created the system, owns a
+// deque.  Jobs are pushed onto the submitting thread's deque, popped LIFO by
+// their owner and stolen FIFO by idle threads.  Jobs submitted by other threads
+// go to a shared mutex-protected queue instead.  Idle workers sleep on a
+// condition variable instead of spinning.
+class JobSystem {
+public:
+    // A negative worker count uses one worker per hardware thread beside the
+    // main thread; zero runs every job on the main thread
+    explicit JobSystem(int workerCount=-1);
+    ~JobSystem();
+
+    // Submits a job.  When dependency is non-null the job is only queued once
+    // that counter reaches zero.  When counter is non-null it is incremented
+    // now and decremented when the job has finished.
+    void run(JobFunction function, void* data, JobCounter* counter=NULL,
+             JobCounter* dependency=NULL, JobAffinity affinity=JOB_ANY_THREAD);
+
+    // Calls function on [0, count) split into chunks of at most grain items
+    // and waits for all of them
+    void parallelFor(size_t count, size_t grain, ParallelForFunction function, void* data);
+
+    // Runs other jobs until the counter reaches zero.  A counter that jobs were
+    // submitted with may only be destroyed once wait has returned for it.
+    void wait(JobCounter* counter);
+
+    // Runs the queued main-thread jobs; call once per frame from the main loop
+    void runMainThreadJobs();
+
+    // Number of threads executing jobs, including the main thread
+    int threadCount() const { return (int)deques.size(); }
+
+private:
+    static int workerMain(void* data);
+
+    int currentThreadIndex() const;
+
+    Job* allocateJob();
+    void releaseJob(Job* job);
+    void submit(Job* job);
+    Job* findJob(int threadIndex);
+    void execute(Job* job);
+    void finish(JobCounter* counter);
+
+    std::vector<JobDeque*> deques;
+    std::vector<thrd_t> threads;
+
+    // Per-thread job pools, recycled as rings
+    std::vector<Job*> pools;
+    std::vector<size_t> poolCursors;
+
+    mtx_t mainLock;
+    std::deque<Job*> mainJobs;
+
+    // Jobs submitted by threads that own no deque
+    mtx_t sharedLock;
+    std::deque<Job*> sharedJobs;
+    std::atomic<int> sharedCount;
+
+    mtx_t sleepLock;
+    cnd_t wakeup;
+    std::atomic<int> queued;
+    std::atomic<int> sleeping;
+    std::atomic<bool> quit;
+};
@@ -1,5 +1,79 @@
 #include"config.h"
-int main() {
+
+// Draws the meshes straight from client-side vertex arrays.  Batched drawing
+// enables the arrays once for all meshes instead of once per mesh.
+static void drawMeshes(const std::vector<Mesh>& meshes, bool batched, RenderCounters& counters) {
+    for(size_t i=0;i<meshes.size();i++) {
+        const Mesh& mesh=meshes[i];
+        if(!batched||i==0) {
+            glEnableClientState(GL_VERTEX_ARRAY);
+            glEnableClientState(GL_NORMAL_ARRAY);
+            counters.stateChanges+=2;
+        }
+        glVertexPointer(3,GL_FLOAT,sizeof(Vertex),mesh.vertices[0].position);
+        glNormalPointer(GL_FLOAT,sizeof(Vertex),mesh.vertices[0].normal);
+        glDrawElements(GL_TRIANGLES,(GLsizei)mesh.indices.size(),GL_UNSIGNED_INT,&mesh.indices[0]);
+        counters.stateChanges+=2;
+        counters.drawCalls++;
+        counters.triangles+=mesh.indices.size()/3;
+        if(!batched||i+1==meshes.size()) {
+            glDisableClientState(GL_NORMAL_ARRAY);
+            glDisableClientState(GL_VERTEX_ARRAY);
+            counters.stateChanges+=2;
+        }
+    }
+}
+
+// One mesh loaded and optimized by a job
+struct MeshLoad {
+    const char* path;
+    Mesh mesh;
+    bool loaded;
+    MeshOptimizationStats stats;
+    size_t bytesBefore, bytesAfter;
+};
+
+static void loadMeshJob(void* data) {
+    MeshLoad* load=static_cast<MeshLoad*>(data);
+    load->loaded=loadMeshOBJ(load->path,load->mesh);
+    if(!load->loaded)
+        return;
+    load->bytesBefore=meshMemorySize(load->mesh);
+    optimizeMesh(load->mesh,&load->stats);
+    QuantizedMesh quantized;
+    quantizeMesh(load->mesh,quantized);
+    load->bytesAfter=meshMemorySize(quantized);
+}
+
+int main(int argc, char** argv) {
+    JobSystem jobs;
+
+    // Every mesh on the command line is loaded and optimized in parallel
+    std::vector<MeshLoad> loads(argc>1?argc-1:0);
+    JobCounter loading;
+    for(size_t i=0;i<loads.size();i++) {
+        loads[i].path=argv[i+1];
+        jobs.run(loadMeshJob,&loads[i],&loading);
+    }
+    jobs.wait(&loading);
+
+    std::vector<Mesh> meshes;
+    std::vector<std::string> meshLabels;
+    for(size_t i=0;i<loads.size();i++) {
+        if(!loads[i].loaded) {
+            std::cout<<"Failed to load "<<loads[i].path<<std::endl;
+            return -1;
+        }
+        printMeshStats(loads[i].path,loads[i].stats,loads[i].bytesBefore,loads[i].bytesAfter);
+        meshes.push_back(std::move(loads[i].mesh));
+
+        char label[256];
+        std::snprintf(label,sizeof(label),"%s: %lu tris, ACMR %.2f, overdraw %.2f",
+                      loads[i].path,(unsigned long)loads[i].stats.triangleCount,
+                      loads[i].stats.cacheAfter.acmr,loads[i].stats.overdrawAfter.overdraw);
+        meshLabels.push_back(label);
+    }
+
     GLFWwindow* window;
     if(!glfwInit()) {
         std::cout<<"Failed to initialize GLFW"<<std::endl;
@@ -9,20 +83,96 @@ int main() {
     glfwMakeContextCurrent(window);\
     gladLoadGL(glfwGetProcAddress);
      
+    TextRenderer* text=new TextRenderer;
+    Profiler* profiler=new Profiler;
+    profiler->initGpuTimers();
+    RenderSettings settings={false,true,true};
+#ifdef HW1_HUD
+    Hud* hud=new Hud(window);
+#endif
+
+    const int eventsZone=profiler->zone("events");
+    const int sceneZone=profiler->zone("scene");
+    const int overlayZone=profiler->zone("overlay");
+#ifdef HW1_HUD
+    const int hudZone=profiler->zone("hud");
+#endif
+
     glClearColor(0.25f,0.5f,0.75f,1.0f); 
     while(!glfwWindowShouldClose(window)) {
+        profiler->beginFrame();
+        RenderCounters& counters=profiler->counters();
+
+        profiler->beginZone(eventsZone);
         glfwPollEvents();
+        profiler->endZone(eventsZone);
+
+        profiler->beginZone(sceneZone);
+        int width,height;
+        glfwGetFramebufferSize(window,&width,&height);
+        glViewport(0,0,width,height);
         glClear(GL_COLOR_BUFFER_BIT);
-        glBegin(GL_TRIANGLES);
-            glVertex3f(-0.5f,-0.5f,0.0f);
-            glColor3f(1.0f,0.0f,0.0f);
-            glVertex3f(0.5f,-0.5f,0.0f);
-            glColor3f(0.0f,1.0f,0.0f);
-            glVertex3f(0.0f,0.5f,0.5f);
-            glColor3f(0.0f,0.0f,1.0f);
-        glEnd();
+        if(settings.cullBackFaces)
+            glEnable(GL_CULL_FACE);
+        else
+            glDisable(GL_CULL_FACE);
+        counters.stateChanges++;
+        if(!meshes.empty()) {
+            drawMeshes(meshes,settings.batchMeshes,counters);
+        }
+        else {
+            glBegin(GL_TRIANGLES);
+                glVertex3f(-0.5f,-0.5f,0.0f);
+                glColor3f(1.0f,0.0f,0.0f);
+                glVertex3f(0.5f,-0.5f,0.0f);
+                glColor3f(0.0f,1.0f,0.0f);
+                glVertex3f(0.0f,0.5f,0.5f);
+                glColor3f(0.0f,0.0f,1.0f);
+            glEnd();
+            counters.drawCalls++;
+            counters.triangles++;
+        }
+        glDisable(GL_CULL_FACE);
+        profiler->endZone(sceneZone);
+
+        // Statistics overlay
+        profiler->beginZone(overlayZone);
+        const float frameTime=profiler->frameTimes()[kProfilerHistory-1];
+
+        char line[128];
+        text->setBatching(settings.batchText);
+        text->beginFrame(width,height);
+        std::snprintf(line,sizeof(line),"%.2f ms/frame (%.0f FPS)",frameTime,frameTime>0.f?1000.f/frameTime:0.f);
+        float y=8.f;
+        text->drawText(8.f,y,line,13);
+        for(size_t i=0;i<meshLabels.size();i++) {
+            y+=15.f;
+            text->drawText(8.f,y,meshLabels[i],13);
+        }
+        const TextStats& textStats=text->stats();
+        std::snprintf(line,sizeof(line),"text: %u glyphs, %u draws, %u layout hits",
+                      textStats.glyphsDrawn,textStats.drawCalls,textStats.layoutHits);
+        text->drawText(8.f,y+15.f,line,13);
+        text->endFrame();
+        counters.drawCalls+=textStats.drawCalls;
+        counters.stateChanges+=textStats.stateChanges;
+        counters.triangles+=textStats.glyphsDrawn*2;
+        profiler->endZone(overlayZone);
+
+#ifdef HW1_HUD
+        profiler->beginZone(hudZone);
+        hud->draw(*profiler,settings);
+        profiler->endZone(hudZone);
+#endif
+
         glfwSwapBuffers(window);
+        profiler->endFrame();
     }
+#ifdef HW1_HUD
+    delete hud;
+#endif
+    delete profiler;
+    delete text;
     glfwTerminate();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,125 @@
+#include"mesh.h"
+
+#include<cstdio>
+#include<cstdlib>
+#include<cstring>
+#include<fstream>
+#include<sstream>
+
+// Resolves a 1-based (or negative, relative) OBJ index into a 0-based one
+static int resolveIndex(int index, size_t count) {
+    if(index<0)
+        return (int)count+index;
+    return index-1;
+}
+
+bool loadMeshOBJ(const std::string& path, Mesh& mesh) {
+    std::ifstream file(path.c_str());
+    if(!file)
+        return false;
+
+    std::vector<float> positions, normals, texcoords;
+    std::vector<Vertex> polygon;
+    std::string line;
+
+    mesh.vertices.clear();
+    mesh.indices.clear();
+
+    while(std::getline(file,line)) {
+        const char* s=line.c_str();
+        while(*s==' '||*s=='\t')
+            s++;
+
+        if(s[0]=='v'&&s[1]==' ') {
+            float x=0.f,y=0.f,z=0.f;
+            std::sscanf(s+2,"%f %f %f",&x,&y,&z);
+            positions.push_back(x);
+            positions.push_back(y);
+            positions.push_back(z);
+        }
+        else if(s[0]=='v'&&s[1]=='n'&&s[2]==' ') {
+            float x=0.f,y=0.f,z=0.f;
+            std::sscanf(s+3,"%f %f %f",&x,&y,&z);
+            normals.push_back(x);
+            normals.push_back(y);
+            normals.push_back(z);
+        }
+        else if(s[0]=='v'&&s[1]=='t'&&s[2]==' ') {
+            float u=0.f,v=0.f;
+            std::sscanf(s+3,"%f %f",&u,&v);
+            texcoords.push_back(u);
+            texcoords.push_back(v);
+        }
+        else if(s[0]=='f'&&s[1]==' ') {
+            std::istringstream corners(s+2);
+            std::string corner;
+            polygon.clear();
+
+            while(corners>>corner) {
+                Vertex vertex;
+                std::memset(&vertex,0,sizeof(vertex));
+
+                // Corners are v, v/vt, v//vn or v/vt/vn
+                int v=0,vt=0,vn=0;
+                const char* c=corner.c_str();
+                v=std::atoi(c);
+                const char* slash=std::strchr(c,'/');
+                if(slash) {
+                    if(slash[1]!='/')
+                        vt=std::atoi(slash+1);
+                    slash=std::strchr(slash+1,'/');
+                    if(slash)
+                        vn=std::atoi(slash+1);
+                }
+
+                int p=resolveIndex(v,positions.size()/3);
+                if(p<0||(size_t)p*3>=positions.size())
+                    return false;
+                std::memcpy(vertex.position,&positions[p*3],sizeof(vertex.position));
+
+                if(vt) {
+                    int t=resolveIndex(vt,texcoords.size()/2);
+                    if(t>=0&&(size_t)t*2<texcoords.size())
+                        std::memcpy(vertex.texcoord,&texcoords[t*2],sizeof(vertex.texcoord));
+                }
+                if(vn) {
+                    int n=resolveIndex(vn,normals.size()/3);
+                    if(n>=0&&(size_t)n*3<normals.size())
+                        std::memcpy(vertex.normal,&normals[n*3],sizeof(vertex.normal));
+                }
+
+                polygon.push_back(vertex);
+            }
+
+            for(size_t i=2;i<polygon.size();i++) {
+                const Vertex* fan[3]={&polygon[0],&polygon[i-1],&polygon[i]};
+                for(int k=0;k<3;k++) {
+                    mesh.indices.push_back((unsigned int)mesh.vertices.size());
+                    mesh.vertices.push_back(*fan[k]);
+                }
+            }
+        }
+    }
+
+    return !mesh.indices.empty();
+}
+
+bool saveMeshOBJ(const std::string& path, const Mesh& mesh) {
+    FILE* file=std::fopen(path.c_str(),"w");
+    if(!file)
+        return false;
+
+    for(size_t i=0;i<mesh.vertices.size();i++) {
+        const Vertex& v=mesh.vertices[i];
+        std::fprintf(file,"v %g %g %g\n",v.position[0],v.position[1],v.position[2]);
+        std::fprintf(file,"vt %g %g\n",v.texcoord[0],v.texcoord[1]);
+        std::fprintf(file,"vn %g %g %g\n",v.normal[0],v.normal[1],v.normal[2]);
+    }
+
+    for(size_t i=0;i+2<mesh.indices.size();i+=3) {
+        unsigned int a=mesh.indices[i]+1,b=mesh.indices[i+1]+1,c=mesh.indices[i+2]+1;
+        std::fprintf(file,"f %u/%u/%u %u/%u/%u %u/%u/%u\n",a,a,a,b,b,b,c,c,c);
+    }
+
+    return std::fclose(file)==0;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include<string>
+#include<vector>
+
+// Interleaved vertex layout used by every mesh in hw1
+struct Vertex {
+    float position[3];
+    float normal[3];
+    float texcoord[2];
+};
+
+// Indexed triangle list
+struct Mesh {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+};
+
+// Loads a Wavefront OBJ file as an unindexed triangle list: every face corner
+// becomes its own vertex and indices are simply 0..n-1.  Polygons are
+// triangulated as fans.  Run deduplicateVertices (or optimizeMesh) afterwards
+// to obtain a real index buffer.
+bool loadMeshOBJ(const std::string& path, Mesh& mesh);
+
+// Writes the mesh as a Wavefront OBJ file, preserving vertex and index order
+bool saveMeshOBJ(const std::string& path, const Mesh& mesh);
@@ -0,0 +1,600 @@
+#include"mesh_optimizer.h"
+
+#include<algorithm>
+#include<cmath>
+#include<cstdio>
+#include<cstring>
+#include<unordered_map>
+
+//////////////////////////////////////////////////////////////////////////
+//////                      Vertex deduplication                    //////
+//////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Hashes and compares vertices by their exact bit patterns, so -0.0f and 0.0f
+// are distinct just like they would be to the GPU
+struct VertexHasher {
+    size_t operator()(const Vertex& v) const {
+        const unsigned char* bytes=reinterpret_cast<const unsigned char*>(&v);
+        // FNV-1a
+        size_t hash=2166136261u;
+        for(size_t i=0;i<sizeof(Vertex);i++) {
+            hash^=bytes[i];
+            hash*=16777619u;
+        }
+        return hash;
+    }
+};
+
+struct VertexEqual {
+    bool operator()(const Vertex& a, const Vertex& b) const {
+        return std::memcmp(&a,&b,sizeof(Vertex))==0;
+    }
+};
+
+}
+
+void deduplicateVertices(Mesh& mesh) {
+    std::unordered_map<Vertex,unsigned int,VertexHasher,VertexEqual> unique;
+    unique.reserve(mesh.vertices.size());
+
+    std::vector<Vertex> vertices;
+    vertices.reserve(mesh.vertices.size());
+
+    for(size_t i=0;i<mesh.indices.size();i++) {
+        const Vertex& vertex=mesh.vertices[mesh.indices[i]];
+        std::pair<std::unordered_map<Vertex,unsigned int,VertexHasher,VertexEqual>::iterator,bool> result=
+            unique.insert(std::make_pair(vertex,(unsigned int)vertices.size()));
+        if(result.second)
+            vertices.push_back(vertex);
+        mesh.indices[i]=result.first->second;
+    }
+
+    mesh.vertices.swap(vertices);
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////                   Vertex cache optimization                  //////
+//////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Tuning constants from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+const int kScoringCacheSize=32;
+const float kCacheDecayPower=1.5f;
+const float kLastTriScore=0.75f;
+const float kValenceBoostScale=2.0f;
+const float kValenceBoostPower=0.5f;
+
+float vertexScore(int cachePosition, unsigned int remainingTriangles) {
+    if(remainingTriangles==0)
+        return -1.f;
+
+    float score=0.f;
+    if(cachePosition>=0) {
+        if(cachePosition<3)
+            score=kLastTriScore;
+        else {
+            const float scale=1.f/(kScoringCacheSize-3);
+            score=std::pow(1.f-(cachePosition-3)*scale,kCacheDecayPower);
+        }
+    }
+
+    score+=kValenceBoostScale*std::pow((float)remainingTriangles,-kValenceBoostPower);
+    return score;
+}
+
+}
+
+void optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount) {
+    const size_t triangleCount=indices.size()/3;
+    if(triangleCount==0)
+        return;
+
+    // Build vertex to triangle adjacency
+    std::vector<unsigned int> offsets(vertexCount+1,0);
+    for(size_t i=0;i<triangleCount*3;i++)
+        offsets[indices[i]+1]++;
+    for(size_t v=0;v<vertexCount;v++)
+        offsets[v+1]+=offsets[v];
+
+    std::vector<unsigned int> adjacency(triangleCount*3);
+    std::vector<unsigned int> remaining(vertexCount,0);
+    for(size_t i=0;i<triangleCount*3;i++) {
+        unsigned int v=indices[i];
+        adjacency[offsets[v]+remaining[v]++]=(unsigned int)(i/3);
+    }
+
+    std::vector<int> cachePosition(vertexCount,-1);
+    std::vector<float> vertexScores(vertexCount);
+    for(size_t v=0;v<vertexCount;v++)
+        vertexScores[v]=vertexScore(-1,remaining[v]);
+
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<char> emitted(triangleCount,0);
+    for(size_t t=0;t<triangleCount;t++)
+        triangleScores[t]=vertexScores[indices[t*3]]+vertexScores[indices[t*3+1]]+vertexScores[indices[t*3+2]];
+
+    std::vector<unsigned int> result;
+    result.reserve(triangleCount*3);
+
+    // Three extra slots hold the vertices pushed out by the latest triangle
+    unsigned int cache[kScoringCacheSize+3];
+    unsigned int cacheCount=0;
+
+    size_t scanCursor=0;
+    long best=-1;
+
+    while(result.size()<triangleCount*3) {
+        if(best<0) {
+            // Nothing in the cache is adjacent to an unemitted triangle, so
+            // restart from the best remaining one
+            float bestScore=-1.f;
+            for(size_t t=scanCursor;t<triangleCount;t++) {
+                if(!emitted[t]&&triangleScores[t]>bestScore) {
+                    bestScore=triangleScores[t];
+                    best=(long)t;
+                }
+            }
+            while(scanCursor<triangleCount&&emitted[scanCursor])
+                scanCursor++;
+        }
+
+        const unsigned int* tri=&indices[best*3];
+        result.push_back(tri[0]);
+        result.push_back(tri[1]);
+        result.push_back(tri[2]);
+        emitted[best]=1;
+
+        // Remove the triangle from the adjacency of its vertices
+        for(int k=0;k<3;k++) {
+            unsigned int v=tri[k];
+            unsigned int* begin=&adjacency[offsets[v]];
+            unsigned int* end=begin+remaining[v];
+            unsigned int* it=std::find(begin,end,(unsigned int)best);
+            if(it!=end) {
+                *it=*(end-1);
+                remaining[v]--;
+            }
+        }
+
+        // Move the triangle's vertices to the front of the LRU cache
+        unsigned int newCache[kScoringCacheSize+3];
+        unsigned int newCount=0;
+        for(int k=0;k<3;k++)
+            newCache[newCount++]=tri[k];
+        for(unsigned int i=0;i<cacheCount;i++) {
+            unsigned int v=cache[i];
+            if(v!=tri[0]&&v!=tri[1]&&v!=tri[2])
+                newCache[newCount++]=v;
+        }
+
+        for(unsigned int i=0;i<newCount;i++) {
+            unsigned int v=newCache[i];
+            cachePosition[v]=i<kScoringCacheSize?(int)i:-1;
+            vertexScores[v]=vertexScore(cachePosition[v],remaining[v]);
+        }
+
+        // Rescore the triangles touching any vertex whose score changed and
+        // pick the best one as the next candidate
+        best=-1;
+        float bestScore=-1.f;
+        for(unsigned int i=0;i<newCount;i++) {
+            unsigned int v=newCache[i];
+            for(unsigned int a=0;a<remaining[v];a++) {
+                unsigned int t=adjacency[offsets[v]+a];
+                const unsigned int* adj=&indices[t*3];
+                float score=vertexScores[adj[0]]+vertexScores[adj[1]]+vertexScores[adj[2]];
+                triangleScores[t]=score;
+                if(score>bestScore) {
+                    bestScore=score;
+                    best=(long)t;
+                }
+            }
+        }
+
+        cacheCount=std::min(newCount,(unsigned int)kScoringCacheSize);
+        std::memcpy(cache,newCache,cacheCount*sizeof(unsigned int));
+    }
+
+    indices.swap(result);
+}
+
+VertexCacheStats analyzeVertexCache(const std::vector<unsigned int>& indices, size_t vertexCount,
+                                    unsigned int cacheSize) {
+    VertexCacheStats stats;
+    std::memset(&stats,0,sizeof(stats));
+
+    // FIFO simulation: a vertex is resident while fewer than cacheSize misses
+    // have happened since it was loaded
+    std::vector<unsigned int> loadedAt(vertexCount,0);
+    unsigned int timestamp=cacheSize+1;
+
+    for(size_t i=0;i<indices.size();i++) {
+        unsigned int v=indices[i];
+        if(timestamp-loadedAt[v]>cacheSize) {
+            loadedAt[v]=timestamp++;
+            stats.transformed++;
+        }
+    }
+
+    if(!indices.empty())
+        stats.acmr=(float)stats.transformed/(indices.size()/3);
+    if(vertexCount)
+        stats.atvr=(float)stats.transformed/vertexCount;
+    return stats;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////                      Overdraw optimization                   //////
+//////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Returns the number of misses caused by one triangle in a FIFO cache
+unsigned int simulateTriangle(const unsigned int* tri, std::vector<unsigned int>& loadedAt,
+                              unsigned int& timestamp) {
+    unsigned int misses=0;
+    for(int k=0;k<3;k++) {
+        if(timestamp-loadedAt[tri[k]]>kVertexCacheSize) {
+            loadedAt[tri[k]]=timestamp++;
+            misses++;
+        }
+    }
+    return misses;
+}
+
+struct Cluster {
+    size_t begin, end; // triangle range
+    float sortKey;
+};
+
+bool clusterGreater(const Cluster& a, const Cluster& b) {
+    return a.sortKey>b.sortKey;
+}
+
+}
+
+void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices,
+                      float threshold) {
+    const size_t triangleCount=indices.size()/3;
+    if(triangleCount==0)
+        return;
+
+    std::vector<unsigned int> loadedAt(vertices.size(),0);
+    unsigned int timestamp=kVertexCacheSize+1;
+
+    // Hard boundaries: triangles where all three vertices miss, i.e. where the
+    // cache is effectively cold already
+    std::vector<size_t> hard;
+    for(size_t t=0;t<triangleCount;t++) {
+        if(simulateTriangle(&indices[t*3],loadedAt,timestamp)==3||t==0)
+            hard.push_back(t);
+    }
+    hard.push_back(triangleCount);
+
+    // Soft boundaries: split each hard cluster further wherever the running
+    // ACMR, restarted cold at every split, stays within the threshold
+    std::vector<Cluster> clusters;
+    for(size_t h=0;h+1<hard.size();h++) {
+        const size_t begin=hard[h],end=hard[h+1];
+
+        timestamp+=kVertexCacheSize+1;
+        unsigned int clusterMisses=0;
+        for(size_t t=begin;t<end;t++)
+            clusterMisses+=simulateTriangle(&indices[t*3],loadedAt,timestamp);
+        const float limit=threshold*clusterMisses/(end-begin);
+
+        timestamp+=kVertexCacheSize+1;
+        size_t start=begin;
+        unsigned int misses=0;
+        for(size_t t=begin;t<end;t++) {
+            misses+=simulateTriangle(&indices[t*3],loadedAt,timestamp);
+            if(t+1==end||misses<=limit*(t-start+1)) {
+                Cluster cluster={start,t+1,0.f};
+                clusters.push_back(cluster);
+                start=t+1;
+                misses=0;
+                timestamp+=kVertexCacheSize+1;
+            }
+        }
+    }
+
+    // Sort clusters so those facing away from the mesh center come first;
+    // from any viewpoint they are the likeliest to occlude the rest
+    float meshCenter[3]={0.f,0.f,0.f};
+    float meshArea=0.f;
+    std::vector<float> clusterData(clusters.size()*7,0.f); // center*area, normal, area
+
+    for(size_t c=0;c<clusters.size();c++) {
+        float* data=&clusterData[c*7];
+        for(size_t t=clusters[c].begin;t<clusters[c].end;t++) {
+            const float* p0=vertices[indices[t*3]].position;
+            const float* p1=vertices[indices[t*3+1]].position;
+            const float* p2=vertices[indices[t*3+2]].position;
+
+            const float e1[3]={p1[0]-p0[0],p1[1]-p0[1],p1[2]-p0[2]};
+            const float e2[3]={p2[0]-p0[0],p2[1]-p0[1],p2[2]-p0[2]};
+            const float n[3]={e1[1]*e2[2]-e1[2]*e2[1],e1[2]*e2[0]-e1[0]*e2[2],e1[0]*e2[1]-e1[1]*e2[0]};
+            const float area=std::sqrt(n[0]*n[0]+n[1]*n[1]+n[2]*n[2]);
+
+            for(int k=0;k<3;k++) {
+                data[k]+=(p0[k]+p1[k]+p2[k])/3.f*area;
+                data[3+k]+=n[k];
+            }
+            data[6]+=area;
+        }
+
+        for(int k=0;k<3;k++)
+            meshCenter[k]+=data[k];
+        meshArea+=data[6];
+    }
+
+    if(meshArea>0.f) {
+        for(int k=0;k<3;k++)
+            meshCenter[k]/=meshArea;
+    }
+
+    for(size_t c=0;c<clusters.size();c++) {
+        const float* data=&clusterData[c*7];
+        const float area=data[6];
+        float length=std::sqrt(data[3]*data[3]+data[4]*data[4]+data[5]*data[5]);
+        if(area<=0.f||length<=0.f)
+            continue;
+
+        float key=0.f;
+        for(int k=0;k<3;k++)
+            key+=(data[k]/area-meshCenter[k])*data[3+k]/length;
+        clusters[c].sortKey=key;
+    }
+
+    std::stable_sort(clusters.begin(),clusters.end(),clusterGreater);
+
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+    for(size_t c=0;c<clusters.size();c++)
+        result.insert(result.end(),indices.begin()+clusters[c].begin*3,indices.begin()+clusters[c].end*3);
+
+    indices.swap(result);
+}
+
+OverdrawStats analyzeOverdraw(const std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices) {
+    const int kGridSize=256;
+
+    OverdrawStats stats;
+    std::memset(&stats,0,sizeof(stats));
+    if(vertices.empty()||indices.empty())
+        return stats;
+
+    float minimum[3],maximum[3];
+    for(int k=0;k<3;k++)
+        minimum[k]=maximum[k]=vertices[0].position[k];
+    for(size_t i=1;i<vertices.size();i++) {
+        for(int k=0;k<3;k++) {
+            minimum[k]=std::min(minimum[k],vertices[i].position[k]);
+            maximum[k]=std::max(maximum[k],vertices[i].position[k]);
+        }
+    }
+
+    float extent=std::max(maximum[0]-minimum[0],std::max(maximum[1]-minimum[1],maximum[2]-minimum[2]));
+    const float scale=extent>0.f?(kGridSize-1)/extent:0.f;
+
+    std::vector<float> depth(kGridSize*kGridSize);
+
+    for(int axis=0;axis<3;axis++) {
+        // Cyclic permutation keeps the projection free of mirroring
+        const int u=(axis+1)%3,v=(axis+2)%3;
+
+        for(int direction=-1;direction<=1;direction+=2) {
+            std::fill(depth.begin(),depth.end(),HUGE_VALF);
+
+            for(size_t t=0;t+2<indices.size();t+=3) {
+                float x[3],y[3],z[3];
+                for(int k=0;k<3;k++) {
+                    const float* p=vertices[indices[t+k]].position;
+                    x[k]=(p[u]-minimum[u])*scale;
+                    y[k]=(p[v]-minimum[v])*scale;
+                    z[k]=-direction*p[axis];
+                }
+
+                // Viewed from the negative side the winding flips
+                const float area=((x[1]-x[0])*(y[2]-y[0])-(x[2]-x[0])*(y[1]-y[0]))*direction;
+                if(area<=0.f)
+                    continue;
+
+                int x0=std::max(0,(int)std::ceil(std::min(x[0],std::min(x[1],x[2]))-0.5f));
+                int x1=std::min(kGridSize-1,(int)std::floor(std::max(x[0],std::max(x[1],x[2]))-0.5f));
+                int y0=std::max(0,(int)std::ceil(std::min(y[0],std::min(y[1],y[2]))-0.5f));
+                int y1=std::min(kGridSize-1,(int)std::floor(std::max(y[0],std::max(y[1],y[2]))-0.5f));
+
+                for(int py=y0;py<=y1;py++) {
+                    for(int px=x0;px<=x1;px++) {
+                        const float cx=px+0.5f,cy=py+0.5f;
+                        float w0=((x[2]-x[1])*(cy-y[1])-(y[2]-y[1])*(cx-x[1]))*direction;
+                        float w1=((x[0]-x[2])*(cy-y[2])-(y[0]-y[2])*(cx-x[2]))*direction;
+                        float w2=((x[1]-x[0])*(cy-y[0])-(y[1]-y[0])*(cx-x[0]))*direction;
+                        if(w0<0.f||w1<0.f||w2<0.f)
+                            continue;
+
+                        const float d=(w0*z[0]+w1*z[1]+w2*z[2])/area;
+                        float& stored=depth[py*kGridSize+px];
+                        if(d<stored) {
+                            stored=d;
+                            stats.shaded++;
+                        }
+                    }
+                }
+            }
+
+            for(size_t i=0;i<depth.size();i++) {
+                if(depth[i]!=HUGE_VALF)
+                    stats.covered++;
+            }
+        }
+    }
+
+    if(stats.covered)
+        stats.overdraw=(float)stats.shaded/stats.covered;
+    return stats;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////                    Vertex fetch optimization                 //////
+//////////////////////////////////////////////////////////////////////////
+
+void optimizeVertexFetch(Mesh& mesh) {
+    const unsigned int kUnused=~0u;
+    std::vector<unsigned int> remap(mesh.vertices.size(),kUnused);
+    std::vector<Vertex> vertices;
+    vertices.reserve(mesh.vertices.size());
+
+    for(size_t i=0;i<mesh.indices.size();i++) {
+        unsigned int& index=mesh.indices[i];
+        if(remap[index]==kUnused) {
+            remap[index]=(unsigned int)vertices.size();
+            vertices.push_back(mesh.vertices[index]);
+        }
+        index=remap[index];
+    }
+
+    mesh.vertices.swap(vertices);
+}
+
+void optimizeMesh(Mesh& mesh, MeshOptimizationStats* stats) {
+    if(stats) {
+        stats->vertexCountBefore=mesh.vertices.size();
+        stats->triangleCount=mesh.indices.size()/3;
+    }
+
+    deduplicateVertices(mesh);
+
+    // Measure the original triangle order on the indexed mesh; an unindexed
+    // input would otherwise always report the meaningless ACMR of 3
+    if(stats) {
+        stats->cacheBefore=analyzeVertexCache(mesh.indices,mesh.vertices.size());
+        stats->overdrawBefore=analyzeOverdraw(mesh.indices,mesh.vertices);
+    }
+
+    optimizeVertexCache(mesh.indices,mesh.vertices.size());
+    optimizeOverdraw(mesh.indices,mesh.vertices);
+    optimizeVertexFetch(mesh);
+
+    if(stats) {
+        stats->vertexCountAfter=mesh.vertices.size();
+        stats->cacheAfter=analyzeVertexCache(mesh.indices,mesh.vertices.size());
+        stats->overdrawAfter=analyzeOverdraw(mesh.indices,mesh.vertices);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////                          Quantization                        //////
+//////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+uint16_t quantizeUnorm16(float value) {
+    value=std::min(std::max(value,0.f),1.f);
+    return (uint16_t)(value*65535.f+0.5f);
+}
+
+uint32_t quantizeSnorm10(float value) {
+    value=std::min(std::max(value,-1.f),1.f);
+    int quantized=(int)std::floor(value*511.f+0.5f);
+    return (uint32_t)quantized&0x3ffu;
+}
+
+// Round-to-nearest float to IEEE half conversion, flushing denormals to zero
+uint16_t quantizeHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits,&value,sizeof(bits));
+
+    const uint32_t sign=(bits>>16)&0x8000u;
+    const uint32_t magnitude=bits&0x7fffffffu;
+
+    if(magnitude>=0x7f800000u) // Inf or NaN
+        return (uint16_t)(sign|0x7c00u|(magnitude>0x7f800000u?0x200u:0u));
+    if(magnitude>=0x477ff000u) // Overflows to infinity
+        return (uint16_t)(sign|0x7c00u);
+    if(magnitude<0x38800000u) // Too small for a normal half
+        return (uint16_t)sign;
+
+    const uint32_t rebased=magnitude-(112u<<23)+0xfffu+((magnitude>>13)&1u);
+    return (uint16_t)(sign|(rebased>>13));
+}
+
+}
+
+void quantizeMesh(const Mesh& mesh, QuantizedMesh& result) {
+    result.vertices.resize(mesh.vertices.size());
+    result.indices16.clear();
+    result.indices32.clear();
+
+    float minimum[3]={0.f,0.f,0.f},maximum[3]={0.f,0.f,0.f};
+    if(!mesh.vertices.empty()) {
+        for(int k=0;k<3;k++)
+            minimum[k]=maximum[k]=mesh.vertices[0].position[k];
+    }
+    for(size_t i=1;i<mesh.vertices.size();i++) {
+        for(int k=0;k<3;k++) {
+            minimum[k]=std::min(minimum[k],mesh.vertices[i].position[k]);
+            maximum[k]=std::max(maximum[k],mesh.vertices[i].position[k]);
+        }
+    }
+
+    for(int k=0;k<3;k++) {
+        result.positionOffset[k]=minimum[k];
+        result.positionScale[k]=(maximum[k]-minimum[k])/65535.f;
+    }
+
+    for(size_t i=0;i<mesh.vertices.size();i++) {
+        const Vertex& source=mesh.vertices[i];
+        QuantizedVertex& target=result.vertices[i];
+
+        for(int k=0;k<3;k++) {
+            const float extent=maximum[k]-minimum[k];
+            target.position[k]=extent>0.f?quantizeUnorm16((source.position[k]-minimum[k])/extent):0;
+        }
+        target.position[3]=0;
+
+        target.normal=quantizeSnorm10(source.normal[0])|
+                      (quantizeSnorm10(source.normal[1])<<10)|
+                      (quantizeSnorm10(source.normal[2])<<20);
+
+        target.texcoord[0]=quantizeHalf(source.texcoord[0]);
+        target.texcoord[1]=quantizeHalf(source.texcoord[1]);
+    }
+
+    if(mesh.vertices.size()<=65536)
+        result.indices16.assign(mesh.indices.begin(),mesh.indices.end());
+    else
+        result.indices32.assign(mesh.indices.begin(),mesh.indices.end());
+}
+
+size_t meshMemorySize(const Mesh& mesh) {
+    return mesh.vertices.size()*sizeof(Vertex)+mesh.indices.size()*sizeof(unsigned int);
+}
+
+size_t meshMemorySize(const QuantizedMesh& mesh) {
+    return mesh.vertices.size()*sizeof(QuantizedVertex)+
+           mesh.indices16.size()*sizeof(uint16_t)+
+           mesh.indices32.size()*sizeof(uint32_t);
+}
+
+void printMeshStats(const std::string& name, const MeshOptimizationStats& stats,
+                    size_t bytesBefore, size_t bytesAfter) {
+    std::printf("%s: %lu triangles, %lu -> %lu vertices\n",
+                name.c_str(),
+                (unsigned long)stats.triangleCount,
+                (unsigned long)stats.vertexCountBefore,
+                (unsigned long)stats.vertexCountAfter);
+    std::printf("  ACMR     %.3f -> %.3f (ATVR %.3f -> %.3f, cache size %u)\n",
+                stats.cacheBefore.acmr,stats.cacheAfter.acmr,
+                stats.cacheBefore.atvr,stats.cacheAfter.atvr,
+                kVertexCacheSize);
+    std::printf("  overdraw %.3f -> %.3f\n",
+                stats.overdrawBefore.overdraw,stats.overdrawAfter.overdraw);
+    std::printf("  memory   %.1f KiB -> %.1f KiB (%.1f%% saved)\n",
+                bytesBefore/1024.0,bytesAfter/1024.0,
+                bytesBefore?100.0*(1.0-(double)bytesAfter/bytesBefore):0.0);
+}
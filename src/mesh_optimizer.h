@@ -0,0 +1,92 @@
+#pragma once
+
+#include<cstdint>
+#include<string>
+#include<vector>
+
+#include"mesh.h"
+
+// Size of the simulated post-transform vertex cache.  16 entries is a
+// conservative model of the FIFO caches found on current desktop hardware.
+const unsigned int kVertexCacheSize=16;
+
+// Post-transform cache statistics for an index buffer
+struct VertexCacheStats {
+    unsigned int transformed; // vertices shaded, i.e. cache misses
+    float acmr;               // average cache miss ratio: misses per triangle
+    float atvr;               // average transform to vertex ratio: misses per vertex
+};
+
+// Overdraw statistics gathered by rasterizing the mesh from the six axis
+// directions with back-face culling and a depth test
+struct OverdrawStats {
+    unsigned long covered;    // pixels covered by at least one triangle
+    unsigned long shaded;     // fragments that passed the depth test
+    float overdraw;           // shaded / covered
+};
+
+// Before and after numbers reported by optimizeMesh.  The "before" cache and
+// overdraw figures are taken after deduplication, in the original triangle
+// order.
+struct MeshOptimizationStats {
+    size_t vertexCountBefore, vertexCountAfter;
+    size_t triangleCount;
+    VertexCacheStats cacheBefore, cacheAfter;
+    OverdrawStats overdrawBefore, overdrawAfter;
+};
+
+// Vertex layout produced by quantizeMesh: 16 bytes instead of 32
+//
+// Positions are 16-bit unorm relative to the mesh bounds (undo with
+// QuantizedMesh::positionScale/positionOffset), normals are 10-10-10-2 snorm
+// and texture coordinates are IEEE half floats.
+struct QuantizedVertex {
+    uint16_t position[4];
+    uint32_t normal;
+    uint16_t texcoord[2];
+};
+
+struct QuantizedMesh {
+    std::vector<QuantizedVertex> vertices;
+    std::vector<uint16_t> indices16; // used when every index fits in 16 bits
+    std::vector<uint32_t> indices32;
+    float positionScale[3];
+    float positionOffset[3];
+};
+
+// Merges bit-identical vertices and rebuilds the index buffer.  The surviving
+// vertices keep their first-use order.
+void deduplicateVertices(Mesh& mesh);
+
+// Reorders triangles for post-transform vertex cache efficiency using Tom
+// Forsyth's linear-speed vertex cache optimization
+void optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount);
+
+// Reorders triangle clusters of a cache-optimized index buffer so outward
+// facing clusters are drawn first, reducing overdraw.  Cluster boundaries are
+// placed where the cache simulation would start cold anyway, so the cache
+// efficiency stays within `threshold` of the input.
+void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices,
+                      float threshold=1.05f);
+
+// Reorders vertices by first use in the index buffer and drops unreferenced
+// ones, improving vertex fetch locality
+void optimizeVertexFetch(Mesh& mesh);
+
+VertexCacheStats analyzeVertexCache(const std::vector<unsigned int>& indices, size_t vertexCount,
+                                    unsigned int cacheSize=kVertexCacheSize);
+OverdrawStats analyzeOverdraw(const std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices);
+
+// Runs the full pipeline: deduplication, vertex cache, overdraw and vertex
+// fetch optimization.  Fills `stats` when non-null.
+void optimizeMesh(Mesh& mesh, MeshOptimizationStats* stats);
+
+void quantizeMesh(const Mesh& mesh, QuantizedMesh& result);
+
+// Size in bytes of the vertex and index data as it would be uploaded
+size_t meshMemorySize(const Mesh& mesh);
+size_t meshMemorySize(const QuantizedMesh& mesh);
+
+// Prints ACMR, overdraw and memory savings for one mesh
+void printMeshStats(const std::string& name, const MeshOptimizationStats& stats,
+                    size_t bytesBefore, size_t bytesAfter);
@@ -0,0 +1,188 @@
+#include"profiler.h"
+
+#include<atomic>
+#include<cstdlib>
+#include<new>
+
+#define GLFW_INCLUDE_NONE
+#include<GLFW/glfw3.h>
+
+//////////////////////////////////////////////////////////////////////////
+//////                      Allocation counting                     //////
+//////////////////////////////////////////////////////////////////////////
+
+// Replacing the global allocation functions counts every C++ heap allocation
+// in the program, including those made by the standard library.  C code such
+// as GLFW and Nuklear allocates with malloc and is not counted.
+
+static std::atomic<size_t> allocationCounter(0);
+
+size_t heapAllocationCount() {
+    return allocationCounter.load(std::memory_order_relaxed);
+}
+
+static void* countedAllocate(size_t size) {
+    allocationCounter.fetch_add(1,std::memory_order_relaxed);
+    return std::malloc(size?size:1);
+}
+
+void* operator new(size_t size) {
+    void* p=countedAllocate(size);
+    if(!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    void* p=countedAllocate(size);
+    if(!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////                           Profiler                           //////
+//////////////////////////////////////////////////////////////////////////
+
+Profiler::Profiler()
+    : zones(0), gpuTimers(false), slot(0), frameStart(0), allocationsAtStart(0), allocations(0) {
+    for(int i=0;i<kProfilerHistory;i++) {
+        history[i]=0.f;
+        gpuHistory[i]=0.f;
+    }
+    for(int s=0;s<kGpuQueryLatency;s++) {
+        for(int i=0;i<kMaxProfileZones;i++) {
+            queries[s][i]=0;
+            issued[s][i]=false;
+        }
+    }
+    current=RenderCounters();
+    last=RenderCounters();
+    frequency=glfwGetTimerFrequency();
+}
+
+Profiler::~Profiler() {
+    if(gpuTimers)
+        glDeleteQueries(kGpuQueryLatency*kMaxProfileZones,&queries[0][0]);
+}
+
+void Profiler::initGpuTimers() {
+    if(gpuTimers||!GLAD_GL_VERSION_3_3)
+        return;
+    glGenQueries(kGpuQueryLatency*kMaxProfileZones,&queries[0][0]);
+    gpuTimers=true;
+}
+
+int Profiler::zone(const char* name) {
+    for(int i=0;i<zones;i++) {
+        if(timings[i].name==name)
+            return i;
+    }
+    if(zones==kMaxProfileZones)
+        return kMaxProfileZones-1;
+
+    timings[zones].name=name;
+    timings[zones].cpuMs=0.0;
+    timings[zones].gpuMs=-1.0;
+    zoneStart[zones]=0;
+    return zones++;
+}
+
+void Profiler::beginFrame() {
+    // The queries in this slot were issued kGpuQueryLatency frames ago
+    if(gpuTimers)
+        readGpuResults(slot);
+
+    frameStart=glfwGetTimerValue();
+    allocationsAtStart=heapAllocationCount();
+    current=RenderCounters();
+}
+
+void Profiler::endFrame() {
+    const uint64_t now=glfwGetTimerValue();
+
+    for(int i=1;i<kProfilerHistory;i++)
+        history[i-1]=history[i];
+    history[kProfilerHistory-1]=(float)((now-frameStart)*1000.0/frequency);
+
+    last=current;
+    allocations=(unsigned long)(heapAllocationCount()-allocationsAtStart);
+    slot=(slot+1)%kGpuQueryLatency;
+}
+
+void Profiler::beginZone(int id) {
+    zoneStart[id]=glfwGetTimerValue();
+    if(gpuTimers) {
+        glBeginQuery(GL_TIME_ELAPSED,queries[slot][id]);
+        issued[slot][id]=true;
+    }
+}
+
+void Profiler::endZone(int id) {
+    if(gpuTimers)
+        glEndQuery(GL_TIME_ELAPSED);
+    timings[id].cpuMs=(glfwGetTimerValue()-zoneStart[id])*1000.0/frequency;
+}
+
+void Profiler::readGpuResults(int readSlot) {
+    double total=0.0;
+    for(int i=0;i<zones;i++) {
+        if(!issued[readSlot][i])
+            continue;
+
+        GLuint available=GL_FALSE;
+        glGetQueryObjectuiv(queries[readSlot][i],GL_QUERY_RESULT_AVAILABLE,&available);
+        if(available) {
+            GLuint64 elapsed=0;
+            glGetQueryObjectui64v(queries[readSlot][i],GL_QUERY_RESULT,&elapsed);
+            timings[i].gpuMs=elapsed/1e6;
+        }
+        issued[readSlot][i]=false;
+        if(timings[i].gpuMs>0.0)
+            total+=timings[i].gpuMs;
+    }
+
+    for(int i=1;i<kProfilerHistory;i++)
+        gpuHistory[i-1]=gpuHistory[i];
+    gpuHistory[kProfilerHistory-1]=(float)total;
+}
+
+float Profiler::averageFrameTime() const {
+    float sum=0.f;
+    for(int i=0;i<kProfilerHistory;i++)
+        sum+=history[i];
+    return sum/kProfilerHistory;
+}
+
+float Profiler::maxFrameTime() const {
+    float result=0.f;
+    for(int i=0;i<kProfilerHistory;i++) {
+        if(history[i]>result)
+            result=history[i];
+    }
+    return result;
+}
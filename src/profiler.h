@@ -0,0 +1,101 @@
+#pragma once
+
+#include<cstddef>
+#include<cstdint>
+
+#include<glad/gl.h>
+
+// Frames of history kept for the graphs
+static const int kProfilerHistory=240;
+static const int kMaxProfileZones=16;
+// GPU timer results are read this many frames after they were issued, so
+// reading them never stalls the pipeline
+static const int kGpuQueryLatency=3;
+
+// Renderer work submitted during a frame, filled in by the drawing code
+struct RenderCounters {
+    unsigned int drawCalls;
+    unsigned int stateChanges;
+    unsigned long triangles;
+};
+
+// Renderer modes, switched at runtime from the HUD when it is built
+struct RenderSettings {
+    bool cullBackFaces;
+    bool batchMeshes; // share client array state between meshes
+    bool batchText;   // one draw per atlas page instead of per string
+};
+
+// Latest measurement of one zone; gpuMs is negative until a GPU result is
+// available or when the context has no timer queries
+struct ZoneTiming {
+    const char* name;
+    double cpuMs;
+    double gpuMs;
+};
+
+// Frame profiler
+//
+// Frames are divided into named zones timed on the CPU with the GLFW timer and
+// on the GPU with GL_TIME_ELAPSED queries.  Timer queries cannot nest, so
+// zones must not overlap.  The profiler also keeps the render counters and the
+// number of C++ heap allocations made during each frame.
+class Profiler {
+public:
+    Profiler();
+    ~Profiler();
+
+    // Creates the GPU timer queries; call once the GL context is current and
+    // loaded.  Without OpenGL 3.3 only CPU times are measured.
+    void initGpuTimers();
+
+    void beginFrame();
+    void endFrame();
+
+    // Returns the id of the zone with the given name, adding it on first use.
+    // The name must outlive the profiler.
+    int zone(const char* name);
+    void beginZone(int id);
+    void endZone(int id);
+
+    RenderCounters& counters() { return current; }
+
+    // Results of the latest finished frame
+    const RenderCounters& lastCounters() const { return last; }
+    unsigned long lastAllocations() const { return allocations; }
+    int zoneCount() const { return zones; }
+    const ZoneTiming& zoneTiming(int id) const { return timings[id]; }
+    bool hasGpuTimers() const { return gpuTimers; }
+
+    // Frame times in milliseconds, oldest first, and their statistics
+    const float* frameTimes() const { return history; }
+    float averageFrameTime() const;
+    float maxFrameTime() const;
+
+    // Total of all GPU zones per frame in milliseconds, oldest first
+    const float* gpuTimes() const { return gpuHistory; }
+
+private:
+    void readGpuResults(int slot);
+
+    ZoneTiming timings[kMaxProfileZones];
+    uint64_t zoneStart[kMaxProfileZones];
+    int zones;
+
+    bool gpuTimers;
+    GLuint queries[kGpuQueryLatency][kMaxProfileZones];
+    bool issued[kGpuQueryLatency][kMaxProfileZones];
+    int slot;
+
+    float history[kProfilerHistory];
+    float gpuHistory[kProfilerHistory];
+    uint64_t frameStart;
+    uint64_t frequency;
+
+    RenderCounters current, last;
+    size_t allocationsAtStart;
+    unsigned long allocations;
+};
+
+// Number of C++ heap allocations made by the process so far
+size_t heapAllocationCount();
@@ -0,0 +1,431 @@
+#include"text_renderer.h"
+
+#include<algorithm>
+#include<climits>
+#include<cmath>
+
+#include"font_data.h"
+
+// Atlas pages are square textures of this size
+static const int kPageSize=512;
+static const size_t kMaxPages=4;
+
+// Empty border around every glyph so linear filtering never bleeds
+static const int kGlyphPadding=1;
+// Small enough that the whole font at this size fits in two pages, so a single
+// string can never need more glyphs than the atlas holds
+static const int kMaxPixelHeight=64;
+
+// Cached layouts unused for this many frames are dropped
+static const unsigned int kLayoutLifetime=120;
+
+//////////////////////////////////////////////////////////////////////////
+//////                        Skyline packer                        //////
+//////////////////////////////////////////////////////////////////////////
+
+SkylinePacker::SkylinePacker(int width, int height) : width(width), height(height) {
+    clear();
+}
+
+void SkylinePacker::clear() {
+    skyline.clear();
+    Segment segment={0,0,width};
+    skyline.push_back(segment);
+}
+
+int SkylinePacker::fit(size_t index, int rectWidth, int rectHeight) const {
+    const int x=skyline[index].x;
+    if(x+rectWidth>width)
+        return -1;
+
+    int y=skyline[index].y;
+    int remaining=rectWidth;
+    for(size_t i=index;remaining>0;i++) {
+        y=std::max(y,skyline[i].y);
+        if(y+rectHeight>height)
+            return -1;
+        remaining-=skyline[i].width;
+    }
+    return y;
+}
+
+bool SkylinePacker::insert(int rectWidth, int rectHeight, int& x, int& y) {
+    int bestTop=INT_MAX,bestWidth=INT_MAX;
+    size_t bestIndex=0;
+    bool found=false;
+
+    for(size_t i=0;i<skyline.size();i++) {
+        int top=fit(i,rectWidth,rectHeight);
+        if(top<0)
+            continue;
+        // Bottom-left: lowest resulting top edge, then the narrowest segment
+        if(top+rectHeight<bestTop||(top+rectHeight==bestTop&&skyline[i].width<bestWidth)) {
+            bestTop=top+rectHeight;
+            bestWidth=skyline[i].width;
+            bestIndex=i;
+            x=skyline[i].x;
+            y=top;
+            found=true;
+        }
+    }
+
+    if(!found)
+        return false;
+
+    Segment segment={x,y+rectHeight,rectWidth};
+    skyline.insert(skyline.begin()+bestIndex,segment);
+
+    // Trim or remove the segments now covered by the new one
+    for(size_t i=bestIndex+1;i<skyline.size();i++) {
+        const Segment& previous=skyline[i-1];
+        const int overlap=previous.x+previous.width-skyline[i].x;
+        if(overlap<=0)
+            break;
+
+        skyline[i].x+=overlap;
+        skyline[i].width-=overlap;
+        if(skyline[i].width>0)
+            break;
+        skyline.erase(skyline.begin()+i);
+        i--;
+    }
+
+    // Merge neighbours at the same height
+    for(size_t i=0;i+1<skyline.size();) {
+        if(skyline[i].y==skyline[i+1].y) {
+            skyline[i].width+=skyline[i+1].width;
+            skyline.erase(skyline.begin()+i+1);
+        }
+        else
+            i++;
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////                        Text renderer                         //////
+//////////////////////////////////////////////////////////////////////////
+
+static uint64_t glyphKey(uint32_t codepoint, int pixelHeight) {
+    return ((uint64_t)pixelHeight<<32)|codepoint;
+}
+
+// Decodes one UTF-8 sequence, substituting '?' for anything malformed
+static uint32_t decodeUTF8(const std::string& text, size_t& i) {
+    const unsigned char c=(unsigned char)text[i++];
+    if(c<0x80)
+        return c;
+
+    int count=c>=0xf0?3:c>=0xe0?2:c>=0xc0?1:0;
+    uint32_t codepoint=c&(0x3f>>count);
+    if(count==0)
+        return '?';
+
+    while(count--) {
+        if(i>=text.size()||((unsigned char)text[i]&0xc0)!=0x80)
+            return '?';
+        codepoint=(codepoint<<6)|((unsigned char)text[i++]&0x3f);
+    }
+    return codepoint;
+}
+
+TextRenderer::Page::Page() : texture(0), packer(kPageSize,kPageSize), lastFrame(0), lastUse(0), lastDraw(0) {
+}
+
+TextRenderer::TextRenderer()
+    : frame(1), generation(0), draw(0), useCounter(0), batching(true), viewportWidth(0), viewportHeight(0) {
+    frameStats=TextStats();
+}
+
+TextRenderer::~TextRenderer() {
+    for(size_t i=0;i<pages.size();i++) {
+        glDeleteTextures(1,&pages[i]->texture);
+        delete pages[i];
+    }
+}
+
+void TextRenderer::beginFrame(int width, int height) {
+    viewportWidth=width;
+    viewportHeight=height;
+    frameStats=TextStats();
+}
+
+TextRenderer::Glyph* TextRenderer::findGlyph(uint64_t key) {
+    Glyph* glyph;
+    std::unordered_map<uint64_t,Glyph>::iterator it=glyphs.find(key);
+    if(it!=glyphs.end())
+        glyph=&it->second;
+    else
+        glyph=rasterizeGlyph(key);
+
+    Page* page=pages[glyph->page];
+    page->lastUse=++useCounter;
+    page->lastDraw=draw;
+    return glyph;
+}
+
+TextRenderer::Glyph* TextRenderer::rasterizeGlyph(uint64_t key) {
+    uint32_t codepoint=(uint32_t)(key&0xffffffffu);
+    const int pixelHeight=(int)(key>>32);
+
+    if(codepoint<(uint32_t)kFontFirstChar||codepoint>=(uint32_t)(kFontFirstChar+kFontGlyphCount))
+        codepoint='?';
+    const unsigned char* rows=kFontGlyphs[codepoint-kFontFirstChar];
+
+    // Box filter the 1-bit cell to the target size
+    const float scale=(float)pixelHeight/kFontCellHeight;
+    const int width=(int)std::ceil(kFontCellWidth*scale);
+    const int height=pixelHeight;
+    std::vector<unsigned char> pixels(width*height);
+
+    for(int py=0;py<height;py++) {
+        const float y0=py/scale,y1=(py+1)/scale;
+        for(int px=0;px<width;px++) {
+            const float x0=px/scale,x1=(px+1)/scale;
+            float coverage=0.f;
+            for(int sy=(int)y0;sy<kFontCellHeight&&sy<y1;sy++) {
+                const float wy=std::min(y1,(float)sy+1)-std::max(y0,(float)sy);
+                for(int sx=(int)x0;sx<kFontCellWidth&&sx<x1;sx++) {
+                    if(rows[sy]&(0x40>>sx))
+                        coverage+=wy*(std::min(x1,(float)sx+1)-std::max(x0,(float)sx));
+                }
+            }
+            coverage*=scale*scale;
+            pixels[py*width+px]=(unsigned char)std::min(255.f,coverage*255.f+0.5f);
+        }
+    }
+
+    int page,x,y;
+    allocate(width+kGlyphPadding*2,height+kGlyphPadding*2,page,x,y);
+
+    glBindTexture(GL_TEXTURE_2D,pages[page]->texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT,1);
+    glTexSubImage2D(GL_TEXTURE_2D,0,x+kGlyphPadding,y+kGlyphPadding,width,height,
+                    GL_ALPHA,GL_UNSIGNED_BYTE,&pixels[0]);
+
+    Glyph& glyph=glyphs[key];
+    glyph.page=page;
+    glyph.x=x+kGlyphPadding;
+    glyph.y=y+kGlyphPadding;
+    glyph.width=width;
+    glyph.height=height;
+    glyph.advance=kFontCellWidth*scale;
+
+    frameStats.glyphsRasterized++;
+    return &glyph;
+}
+
+void TextRenderer::allocate(int width, int height, int& page, int& x, int& y) {
+    for(size_t i=0;i<pages.size();i++) {
+        if(pages[i]->packer.insert(width,height,x,y)) {
+            page=(int)i;
+            return;
+        }
+    }
+
+    if(pages.size()<kMaxPages) {
+        Page* created=new Page;
+        std::vector<unsigned char> empty(kPageSize*kPageSize,0);
+        glGenTextures(1,&created->texture);
+        glBindTexture(GL_TEXTURE_2D,created->texture);
+        glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+        glPixelStorei(GL_UNPACK_ALIGNMENT,1);
+        glTexImage2D(GL_TEXTURE_2D,0,GL_ALPHA,kPageSize,kPageSize,0,GL_ALPHA,GL_UNSIGNED_BYTE,&empty[0]);
+        pages.push_back(created);
+    }
+    else
+        evictPage();
+
+    page=(int)pages.size()-1;
+    for(size_t i=0;i<pages.size();i++) {
+        if(pages[i]->packer.insert(width,height,x,y)) {
+            page=(int)i;
+            return;
+        }
+    }
+}
+
+void TextRenderer::evictPage() {
+    // Never pick a page holding glyphs of the string being resolved, or its
+    // resolution would restart forever.  Even the whole font at the maximum
+    // size needs only two pages, so some other page is always available.
+    size_t oldest=pages.size();
+    for(size_t i=0;i<pages.size();i++) {
+        if(pages[i]->lastDraw==draw)
+            continue;
+        if(oldest==pages.size()||pages[i]->lastUse<pages[oldest]->lastUse)
+            oldest=i;
+    }
+    if(oldest==pages.size())
+        oldest=0;
+
+    // Quads already queued this frame may sample the page, so draw them
+    // before its contents change
+    if(pages[oldest]->lastFrame==frame)
+        flush();
+
+    for(std::unordered_map<uint64_t,Glyph>::iterator it=glyphs.begin();it!=glyphs.end();) {
+        if(it->second.page==(int)oldest) {
+            it=glyphs.erase(it);
+            frameStats.glyphsEvicted++;
+        }
+        else
+            ++it;
+    }
+
+    pages[oldest]->packer.clear();
+    generation++;
+}
+
+TextRenderer::Layout& TextRenderer::layout(const std::string& text, int pixelHeight) {
+    std::string cacheKey(1,(char)pixelHeight); // pixelHeight fits in a byte
+    cacheKey+=text;
+
+    std::unordered_map<std::string,Layout>::iterator it=layouts.find(cacheKey);
+    if(it!=layouts.end()) {
+        frameStats.layoutHits++;
+        return it->second;
+    }
+    frameStats.layoutMisses++;
+
+    Layout& result=layouts[cacheKey];
+    result.width=0.f;
+    result.generation=generation-1; // force glyph resolution on first draw
+    result.lastUsed=frame;
+
+    const float advance=kFontCellWidth*(float)pixelHeight/kFontCellHeight;
+    float penX=0.f,penY=0.f;
+    for(size_t i=0;i<text.size();) {
+        uint32_t codepoint=decodeUTF8(text,i);
+        if(codepoint=='\n') {
+            penX=0.f;
+            penY+=(float)pixelHeight;
+            continue;
+        }
+        if(codepoint!=' ') {
+            LayoutQuad quad={glyphKey(codepoint,pixelHeight),penX,penY,NULL};
+            result.quads.push_back(quad);
+        }
+        penX+=advance;
+        result.width=std::max(result.width,penX);
+    }
+
+    return result;
+}
+
+float TextRenderer::drawText(float x, float y, const std::string& text, int pixelHeight, uint32_t color) {
+    pixelHeight=std::max(1,std::min(pixelHeight,kMaxPixelHeight));
+    Layout& cached=layout(text,pixelHeight);
+    draw++;
+    cached.lastUsed=frame;
+
+    // Resolve glyph pointers after any eviction, rasterizing missing glyphs.
+    // Rasterizing may itself evict a page, in which case start over.
+    while(cached.generation!=generation) {
+        const unsigned int current=generation;
+        for(size_t i=0;i<cached.quads.size()&&generation==current;i++)
+            cached.quads[i].glyph=findGlyph(cached.quads[i].key);
+        if(generation==current)
+            cached.generation=current;
+    }
+
+    x=std::floor(x+0.5f);
+    y=std::floor(y+0.5f);
+    const float texel=1.f/kPageSize;
+
+    for(size_t i=0;i<cached.quads.size();i++) {
+        const LayoutQuad& quad=cached.quads[i];
+        const Glyph* glyph=quad.glyph;
+        Page* page=pages[glyph->page];
+        page->lastFrame=frame;
+        page->lastUse=++useCounter;
+
+        const float x0=x+quad.x,y0=y+quad.y;
+        const float x1=x0+glyph->width,y1=y0+glyph->height;
+        const float u0=glyph->x*texel,v0=glyph->y*texel;
+        const float u1=(glyph->x+glyph->width)*texel,v1=(glyph->y+glyph->height)*texel;
+
+        const float corners[16]={x0,y0,u0,v0, x1,y0,u1,v0, x1,y1,u1,v1, x0,y1,u0,v1};
+        page->vertices.insert(page->vertices.end(),corners,corners+16);
+        page->colors.insert(page->colors.end(),4,color);
+    }
+
+    frameStats.glyphsDrawn+=(unsigned int)cached.quads.size();
+    if(!batching)
+        flush();
+    return cached.width;
+}
+
+void TextRenderer::flush() {
+    bool queued=false;
+    for(size_t i=0;i<pages.size()&&!queued;i++)
+        queued=!pages[i]->colors.empty();
+    if(!queued)
+        return;
+
+    glPushAttrib(GL_CURRENT_BIT|GL_ENABLE_BIT|GL_COLOR_BUFFER_BIT|GL_TEXTURE_BIT|GL_TRANSFORM_BIT);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_LIGHTING);
+    glEnable(GL_TEXTURE_2D);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
+    glTexEnvi(GL_TEXTURE_ENV,GL_TEXTURE_ENV_MODE,GL_MODULATE);
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0.0,viewportWidth,viewportHeight,0.0,-1.0,1.0);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    frameStats.stateChanges++;
+
+    for(size_t i=0;i<pages.size();i++) {
+        Page* page=pages[i];
+        if(page->colors.empty())
+            continue;
+
+        glBindTexture(GL_TEXTURE_2D,page->texture);
+        frameStats.stateChanges++;
+        glVertexPointer(2,GL_FLOAT,4*sizeof(float),&page->vertices[0]);
+        glTexCoordPointer(2,GL_FLOAT,4*sizeof(float),&page->vertices[2]);
+        glColorPointer(4,GL_UNSIGNED_BYTE,0,&page->colors[0]);
+        glDrawArrays(GL_QUADS,0,(GLsizei)page->colors.size());
+        frameStats.drawCalls++;
+
+        page->vertices.clear();
+        page->colors.clear();
+    }
+
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+
+    glPopClientAttrib();
+    glPopAttrib();
+}
+
+void TextRenderer::endFrame() {
+    flush();
+
+    if(frame%kLayoutLifetime==0) {
+        for(std::unordered_map<std::string,Layout>::iterator it=layouts.begin();it!=layouts.end();) {
+            if(frame-it->second.lastUsed>kLayoutLifetime)
+                it=layouts.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    frame++;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include<cstdint>
+#include<string>
+#include<unordered_map>
+#include<vector>
+
+#include<glad/gl.h>
+
+// Skyline bottom-left rectangle packer (Jylänki, "A Thousand Ways to Pack the
+// Bin").  The skyline is the list of segments forming the top edge of the
+// packed area; new rectangles are placed on the segment that keeps them
+// lowest.
+class SkylinePacker {
+public:
+    SkylinePacker(int width, int height);
+
+    // Returns false when the rectangle does not fit
+    bool insert(int width, int height, int& x, int& y);
+    void clear();
+
+private:
+    struct Segment {
+        int x, y, width;
+    };
+
+    // Returns the y at which a rectangle of the given width would rest when
+    // placed at segment index, or -1 if it would leave the bin
+    int fit(size_t index, int width, int height) const;
+
+    int width, height;
+    std::vector<Segment> skyline;
+};
+
+// Counters for the current frame, reset by TextRenderer::beginFrame
+struct TextStats {
+    unsigned int drawCalls;
+    unsigned int stateChanges; // state setups per flush plus texture binds
+    unsigned int glyphsDrawn;
+    unsigned int glyphsRasterized;
+    unsigned int glyphsEvicted;
+    unsigned int layoutHits;
+    unsigned int layoutMisses;
+};
+
+// Batched text renderer with a dynamic glyph atlas
+//
+// Glyphs are rasterized from the built-in bitmap font at the requested pixel
+// height the first time they are used and packed into atlas pages.  When every
+// page is full, the least recently used page is cleared and refilled; if that
+// page is still in use this frame, the queued batches are drawn first.  Text
+// is collected into one quad batch per page and drawn with a single call per
+// page by endFrame.  Laid out strings are cached between frames and dropped
+// once unused for a while.
+//
+// Uses only OpenGL 1.1 fixed-function state, like the rest of hw1.
+class TextRenderer {
+public:
+    TextRenderer();
+    ~TextRenderer();
+
+    // Starts a frame drawn over a viewport of the given size in pixels
+    void beginFrame(int width, int height);
+
+    // Queues a UTF-8 string with its top-left corner at (x, y) in pixels.  The
+    // color is packed as bytes R, G, B, A in memory order, i.e. 0xAABBGGRR on
+    // little-endian machines.  Newlines start a new line.  Returns the advance
+    // width of the widest line.
+    float drawText(float x, float y, const std::string& text, int pixelHeight, uint32_t color=0xffffffffu);
+
+    // Draws every queued batch, one draw call per atlas page
+    void endFrame();
+
+    // With batching off every drawText call is drawn immediately, which costs
+    // a state setup and at least one draw call per string
+    void setBatching(bool enabled) { batching=enabled; }
+    bool isBatching() const { return batching; }
+
+    const TextStats& stats() const { return frameStats; }
+
+private:
+    struct Page {
+        GLuint texture;
+        SkylinePacker packer;
+        unsigned int lastFrame; // frame of the latest quad sampling the page
+        uint64_t lastUse;       // use counter value of the latest glyph lookup
+        unsigned int lastDraw;  // drawText call that last looked up a glyph here
+        std::vector<float> vertices; // x, y, u, v per corner
+        std::vector<uint32_t> colors;
+
+        Page();
+    };
+
+    struct Glyph {
+        int page;
+        int x, y, width, height;
+        float advance;
+    };
+
+    struct LayoutQuad {
+        uint64_t key;
+        float x, y;
+        Glyph* glyph;
+    };
+
+    struct Layout {
+        std::vector<LayoutQuad> quads;
+        float width;
+        unsigned int generation; // atlas generation the glyph pointers belong to
+        unsigned int lastUsed;
+    };
+
+    Glyph* findGlyph(uint64_t key);
+    Glyph* rasterizeGlyph(uint64_t key);
+    void allocate(int width, int height, int& page, int& x, int& y);
+    void evictPage();
+    Layout& layout(const std::string& text, int pixelHeight);
+    void flush();
+
+    std::vector<Page*> pages;
+    std::unordered_map<uint64_t,Glyph> glyphs;
+    std::unordered_map<std::string,Layout> layouts;
+
+    unsigned int frame;
+    unsigned int generation;
+    unsigned int draw;
+    uint64_t useCounter;
+    bool batching;
+    int viewportWidth, viewportHeight;
+    TextStats frameStats;
+};
@@ -0,0 +1,62 @@
+// Offline mesh optimizer
+//
+// Usage: meshopt [-w] input.obj...
+//
+// Runs every input through the same pipeline hw1 uses at load time and prints
+// ACMR, overdraw and memory savings per mesh.  With -w the optimized mesh is
+// written next to the input as <input>.opt.obj; vertex and triangle order
+// survive the round trip, so hw1 can load it without reoptimizing.
+#include<cstring>
+#include<iostream>
+#include<string>
+
+#include"mesh.h"
+#include"mesh_optimizer.h"
+
+static void usage() {
+    std::cout<<"Usage: meshopt [-w] input.obj..."<<std::endl;
+}
+
+int main(int argc, char** argv) {
+    bool write=false;
+    int first=1;
+
+    if(argc>1&&std::strcmp(argv[1],"-w")==0) {
+        write=true;
+        first=2;
+    }
+
+    if(first>=argc) {
+        usage();
+        return 1;
+    }
+
+    int failures=0;
+    for(int i=first;i<argc;i++) {
+        const std::string path=argv[i];
+
+        Mesh mesh;
+        if(!loadMeshOBJ(path,mesh)) {
+            std::cout<<"Failed to load "<<path<<std::endl;
+            failures++;
+            continue;
+        }
+
+        const size_t bytesBefore=meshMemorySize(mesh);
+
+        MeshOptimizationStats stats;
+        optimizeMesh(mesh,&stats);
+
+        QuantizedMesh quantized;
+        quantizeMesh(mesh,quantized);
+
+        printMeshStats(path,stats,bytesBefore,meshMemorySize(quantized));
+
+        if(write&&!saveMeshOBJ(path+".opt.obj",mesh)) {
+            std::cout<<"Failed to write "<<path<<".opt.obj"<<std::endl;
+            failures++;
+        }
+    }
+
+    return failures?1:0;
+}